@@ -55,6 +55,21 @@ def sldebug(args):
     vmArgs, slArgs = mx.extract_VM_args(args, useDoubleDash=True)
     mx.run_java(vmArgs + ['-cp', mx.classpath("com.oracle.truffle.sl.tools"), "com.oracle.truffle.sl.tools.debug.SLREPL"] + slArgs)
 
+def slbench(args):
+    """run the SL benchmark suite and report steady state statistics"""
+    vmArgs, benchArgs = mx.extract_VM_args(args)
+    mx.run_java(vmArgs + ['-cp', mx.classpath("com.oracle.truffle.sl.bench"), "com.oracle.truffle.sl.bench.SLBenchmarkRunner"] + benchArgs)
+
+def slstepbench(args):
+    """measure the time the debugger takes to step over deep SL recursion"""
+    vmArgs, benchArgs = mx.extract_VM_args(args)
+    mx.run_java(vmArgs + ['-cp', mx.classpath("com.oracle.truffle.sl.bench"), "com.oracle.truffle.sl.bench.SLStepOverBenchmark"] + benchArgs)
+
+def dslflatbench(args):
+    """compare the interpreter speed of flat state bitset and specialization chain DSL nodes"""
+    vmArgs, benchArgs = mx.extract_VM_args(args)
+    mx.run_java(vmArgs + ['-cp', mx.classpath("com.oracle.truffle.api.dsl.test"), "com.oracle.truffle.api.dsl.test.FlatStateBitsetBenchmark"] + benchArgs)
+
 def _truffle_gate_runner(args, tasks):
     with Task('Truffle UnitTests', tasks) as t:
         if t: unittest(['--suite', 'truffle', '--enable-timing', '--verbose', '--fail-fast'])
@@ -67,4 +82,7 @@ mx.update_commands(_suite, {
     'sl' : [sl, '[SL args|@VM options]'],
     'sldebug' : [sldebug, '[SL args|@VM options]'],
     'slcoverage' : [slcoverage, '[SL args|@VM options]'],
+    'slbench' : [slbench, '[benchmark names|@VM options]'],
+    'slstepbench' : [slstepbench, '[depth [runs]|@VM options]'],
+    'dslflatbench' : [dslflatbench, '[iterations [runs]|@VM options]'],
 })
@@ -255,6 +255,16 @@ suite = {
       "workingSets" : "Truffle,SimpleLanguage,Tools",
       "license" : "UPL",
     },
+
+    "com.oracle.truffle.sl.bench" : {
+      "subDir" : "truffle",
+      "sourceDirs" : ["src"],
+      "dependencies" : ["com.oracle.truffle.sl"],
+      "checkstyle" : "com.oracle.truffle.sl",
+      "javaCompliance" : "1.7",
+      "workingSets" : "Truffle,SimpleLanguage",
+      "license" : "UPL",
+    },
   },
 
   "licenses" : {
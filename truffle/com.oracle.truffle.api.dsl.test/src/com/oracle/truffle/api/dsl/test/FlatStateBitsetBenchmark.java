@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl.test;
+
+import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTest.ArgumentNode;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.ChainAddNodeGen;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.FlatAddNodeGen;
+
+/**
+ * Compares the interpreter speed of the flat state bitset and the specialization chain for a
+ * polymorphic operation. Interpreter timings are too noisy to be asserted in a unit test, so the
+ * times and their ratio are only printed.
+ * <p>
+ * Use the mx command "mx dslflatbench" to run it with the correct class path setup:
+ *
+ * <pre>
+ * mx dslflatbench [iterations [runs]]
+ * </pre>
+ */
+public final class FlatStateBitsetBenchmark {
+
+    private static final Object[][] ARGUMENTS = {{1, 2}, {-3, 2}, {"a", "b"}, {1, "b"}};
+
+    public static void main(String[] args) {
+        final int iterations = args.length > 0 ? Integer.parseInt(args[0]) : 100000;
+        final int runs = args.length > 1 ? Integer.parseInt(args[1]) : 5;
+        final CallTarget flatTarget = FlatStateBitsetTest.createTarget(FlatAddNodeGen.create(new ArgumentNode(0), new ArgumentNode(1)));
+        final CallTarget chainTarget = FlatStateBitsetTest.createTarget(ChainAddNodeGen.create(new ArgumentNode(0), new ArgumentNode(1)));
+        long flat = Long.MAX_VALUE;
+        long chain = Long.MAX_VALUE;
+        for (int run = 0; run < runs; run++) {
+            flat = Math.min(flat, measure(flatTarget, iterations));
+            chain = Math.min(chain, measure(chainTarget, iterations));
+        }
+        System.out.printf("flat:  %d us%n", flat / 1000);
+        System.out.printf("chain: %d us%n", chain / 1000);
+        System.out.printf("ratio: %.2f%n", (double) flat / chain);
+    }
+
+    private static long measure(CallTarget target, int iterations) {
+        final long start = System.nanoTime();
+        for (int i = 0; i < iterations; i++) {
+            target.call(ARGUMENTS[i & 3]);
+        }
+        return System.nanoTime() - start;
+    }
+}
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl.test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.util.Arrays;
+import java.util.Collections;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.ReplaceObserver;
+import com.oracle.truffle.api.RootCallTarget;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.dsl.Cached;
+import com.oracle.truffle.api.dsl.NodeChild;
+import com.oracle.truffle.api.dsl.NodeChildren;
+import com.oracle.truffle.api.dsl.Specialization;
+import com.oracle.truffle.api.dsl.SpecializationSnapshot;
+import com.oracle.truffle.api.dsl.TypeSystem;
+import com.oracle.truffle.api.dsl.TypeSystemReference;
+import com.oracle.truffle.api.dsl.UnsupportedSpecializationException;
+import com.oracle.truffle.api.dsl.internal.DSLOptions;
+import com.oracle.truffle.api.dsl.internal.FlatSpecializedNode;
+import com.oracle.truffle.api.dsl.internal.SpecializationNode;
+import com.oracle.truffle.api.dsl.internal.SpecializedNode;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.ChainAddNodeGen;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.FlatAddNodeGen;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.FlatCachedNodeGen;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.FlatContainsNodeGen;
+import com.oracle.truffle.api.dsl.test.FlatStateBitsetTestFactory.FlatUnsupportedNodeGen;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.NodeCost;
+import com.oracle.truffle.api.nodes.NodeUtil;
+import com.oracle.truffle.api.nodes.RootNode;
+
+public class FlatStateBitsetTest {
+
+    @Test
+    public void testSpecializations() {
+        FlatAddNode node = FlatAddNodeGen.create(new ArgumentNode(0), new ArgumentNode(1));
+        CallTarget target = createTarget(node);
+        assertEquals(NodeCost.UNINITIALIZED, node.getCost());
+
+        assertEquals(3, target.call(1, 2));
+        assertEquals(NodeCost.MONOMORPHIC, node.getCost());
+        assertEquals(-1, target.call(-3, 2));
+        assertEquals(NodeCost.POLYMORPHIC, node.getCost());
+        assertEquals("ab", target.call("a", "b"));
+        assertEquals("1b", target.call(1, "b"));
+        assertEquals(3, target.call(1, 2));
+        assertEquals(-1, target.call(-3, 2));
+    }
+
+    @Test
+    public void testContains() {
+        FlatContainsNode node = FlatContainsNodeGen.create(new ArgumentNode(0));
+        CallTarget target = createTarget(node);
+
+        assertEquals(2, target.call(1));
+        assertEquals(NodeCost.MONOMORPHIC, node.getCost());
+        assertEquals("a1", target.call("a"));
+        // doGeneric replaced doInt
+        assertEquals(NodeCost.MONOMORPHIC, node.getCost());
+        assertEquals("11", target.call(1));
+        assertEquals(NodeCost.MONOMORPHIC, node.getCost());
+    }
+
+    @Test
+    public void testUnsupported() {
+        FlatUnsupportedNode node = FlatUnsupportedNodeGen.create(new ArgumentNode(0));
+        CallTarget target = createTarget(node);
+
+        assertEquals(1, target.call(1));
+        try {
+            target.call("a");
+            fail();
+        } catch (UnsupportedSpecializationException e) {
+            assertEquals(node, e.getNode());
+            assertEquals("a", e.getSuppliedValues()[0]);
+        }
+    }
+
+    @Test
+    public void testNoSpecializationNodes() {
+        FlatAddNode flat = FlatAddNodeGen.create(new ArgumentNode(0), new ArgumentNode(1));
+        ChainAddNode chain = ChainAddNodeGen.create(new ArgumentNode(0), new ArgumentNode(1));
+        CallTarget flatTarget = createTarget(flat);
+        CallTarget chainTarget = createTarget(chain);
+        Object[][] arguments = {{1, 2}, {-3, 2}, {"a", "b"}, {1, "b"}};
+        for (Object[] args : arguments) {
+            assertEquals(chainTarget.call(args), flatTarget.call(args));
+        }
+
+        assertFalse(flat instanceof SpecializedNode);
+        assertTrue(flat instanceof FlatSpecializedNode);
+        assertTrue(chain instanceof SpecializedNode);
+        assertEquals(0, countSpecializationClasses(FlatAddNodeGen.class));
+        assertTrue(countSpecializationClasses(ChainAddNodeGen.class) > 0);
+        assertEquals(3, NodeUtil.countNodes(flat));
+        assertTrue(NodeUtil.countNodes(chain) > NodeUtil.countNodes(flat));
+    }
+
+    @Test
+    public void testUnsupportedFeatureUsesChain() {
+        FlatCachedNode node = FlatCachedNodeGen.create(new ArgumentNode(0));
+        CallTarget target = createTarget(node);
+        assertEquals(1, target.call(1));
+        assertEquals(2, target.call(2));
+        assertEquals("3!", target.call(3));
+        assertTrue(node instanceof SpecializedNode);
+    }
+
+    @Test
+    public void testTransitionsAreReported() {
+        FlatAddNode node = FlatAddNodeGen.create(new ArgumentNode(0), new ArgumentNode(1));
+        ObservingRootNode root = new ObservingRootNode(node);
+        CallTarget target = Truffle.getRuntime().createCallTarget(root);
+        target.call(1, 2);
+        target.call(1, 2);
+        target.call(-3, 2);
+        target.call("a", "b");
+        assertEquals(3, root.rewrites);
+        assertEquals(node, root.lastRewritten);
+    }
+
+    @Test
+    public void testSnapshot() {
+        RootCallTarget target = createTarget(FlatContainsNodeGen.create(new ArgumentNode(0)));
+        target.call(1);
+        target.call("a");
+        SpecializationSnapshot snapshot = SpecializationSnapshot.capture(Collections.singleton(target));
+        assertEquals(1, snapshot.getNodeCount());
+
+        FlatContainsNode node = FlatContainsNodeGen.create(new ArgumentNode(0));
+        RootCallTarget fresh = createTarget(node);
+        assertEquals(NodeCost.UNINITIALIZED, node.getCost());
+        assertEquals(1, snapshot.apply(fresh.getRootNode()));
+        assertEquals(Arrays.asList("doGeneric(Object)"), SpecializationNode.getActiveSpecializations((FlatSpecializedNode) node));
+        assertEquals("11", fresh.call(1));
+        assertEquals(NodeCost.MONOMORPHIC, node.getCost());
+    }
+
+    private static int countSpecializationClasses(Class<?> nodeClass) {
+        int count = 0;
+        for (Class<?> c : nodeClass.getDeclaredClasses()) {
+            if (SpecializationNode.class.isAssignableFrom(c)) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    static RootCallTarget createTarget(final FlatValueNode node) {
+        return Truffle.getRuntime().createCallTarget(new RootNode(TestingLanguage.class, null, null) {
+            @Child FlatValueNode child = node;
+
+            @Override
+            public Object execute(VirtualFrame frame) {
+                return child.execute(frame);
+            }
+        });
+    }
+
+    static final class ObservingRootNode extends RootNode implements ReplaceObserver {
+
+        @Child FlatValueNode child;
+        int rewrites;
+        Node lastRewritten;
+
+        ObservingRootNode(FlatValueNode child) {
+            super(TestingLanguage.class, null, null);
+            this.child = child;
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            return child.execute(frame);
+        }
+
+        public boolean nodeReplaced(Node oldNode, Node newNode, CharSequence reason) {
+            assertEquals(oldNode, newNode);
+            rewrites++;
+            lastRewritten = newNode;
+            return true;
+        }
+
+    }
+
+    @TypeSystem({int.class, String.class})
+    @DSLOptions(useFlatStateBitset = true)
+    static class FlatTypes {
+    }
+
+    @TypeSystem({int.class, String.class})
+    static class ChainTypes {
+    }
+
+    @TypeSystemReference(FlatTypes.class)
+    abstract static class FlatValueNode extends Node {
+
+        abstract Object execute(VirtualFrame frame);
+
+    }
+
+    static final class ArgumentNode extends FlatValueNode {
+
+        private final int index;
+
+        ArgumentNode(int index) {
+            this.index = index;
+        }
+
+        @Override
+        Object execute(VirtualFrame frame) {
+            return frame.getArguments()[index];
+        }
+
+    }
+
+    @NodeChildren({@NodeChild(value = "left", type = FlatValueNode.class), @NodeChild(value = "right", type = FlatValueNode.class)})
+    abstract static class FlatAddNode extends FlatValueNode {
+
+        @Specialization(guards = "left >= 0")
+        int addPositive(int left, int right) {
+            return left + right;
+        }
+
+        @Specialization
+        int addInt(int left, int right) {
+            return left + right;
+        }
+
+        @Specialization
+        String addString(String left, String right) {
+            return left + right;
+        }
+
+        @Specialization
+        String addGeneric(Object left, Object right) {
+            return String.valueOf(left) + right;
+        }
+
+    }
+
+    @TypeSystemReference(ChainTypes.class)
+    @NodeChildren({@NodeChild(value = "left", type = FlatValueNode.class), @NodeChild(value = "right", type = FlatValueNode.class)})
+    abstract static class ChainAddNode extends FlatValueNode {
+
+        @Specialization(guards = "left >= 0")
+        int addPositive(int left, int right) {
+            return left + right;
+        }
+
+        @Specialization
+        int addInt(int left, int right) {
+            return left + right;
+        }
+
+        @Specialization
+        String addString(String left, String right) {
+            return left + right;
+        }
+
+        @Specialization
+        String addGeneric(Object left, Object right) {
+            return String.valueOf(left) + right;
+        }
+
+    }
+
+    @NodeChild(value = "a", type = FlatValueNode.class)
+    abstract static class FlatContainsNode extends FlatValueNode {
+
+        @Specialization
+        int doInt(int a) {
+            return a + 1;
+        }
+
+        @Specialization(contains = "doInt")
+        String doGeneric(Object a) {
+            return a + "1";
+        }
+
+    }
+
+    @ExpectError("The flat state bitset is not supported for the @Cached parameters of doCached.%")
+    @NodeChild(value = "a", type = FlatValueNode.class)
+    abstract static class FlatCachedNode extends FlatValueNode {
+
+        @Specialization(guards = "a == cachedA", limit = "2")
+        int doCached(int a, @Cached("a") int cachedA) {
+            return cachedA;
+        }
+
+        @Specialization
+        String doGeneric(Object a) {
+            return a + "!";
+        }
+
+    }
+
+    @NodeChild(value = "a", type = FlatValueNode.class)
+    abstract static class FlatUnsupportedNode extends FlatValueNode {
+
+        @Specialization
+        int doInt(int a) {
+            return a;
+        }
+
+        @Specialization(guards = "a.length() == 0")
+        String doEmpty(String a) {
+            return a;
+        }
+
+    }
+
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl.test;
+
+import static com.oracle.truffle.api.dsl.test.TestHelper.createRoot;
+import static com.oracle.truffle.api.dsl.test.TestHelper.executeWith;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.dsl.NodeChild;
+import com.oracle.truffle.api.dsl.NodeChildren;
+import com.oracle.truffle.api.dsl.Specialization;
+import com.oracle.truffle.api.dsl.internal.SpecializationNode;
+import com.oracle.truffle.api.dsl.test.GeneratedNodeClassTestFactory.AddNodeFactory;
+import com.oracle.truffle.api.dsl.test.GeneratedNodeClassTestFactory.AddOrConcatNodeFactory;
+import com.oracle.truffle.api.dsl.test.TypeSystemTest.ArgumentNode;
+import com.oracle.truffle.api.dsl.test.TypeSystemTest.TestRootNode;
+import com.oracle.truffle.api.dsl.test.TypeSystemTest.ValueNode;
+import com.oracle.truffle.api.nodes.GeneratedNodeClass;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.NodeClass;
+import com.oracle.truffle.api.nodes.NodeUtil;
+import com.oracle.truffle.api.nodes.NodeVisitor;
+
+public class GeneratedNodeClassTest {
+
+    @Test
+    public void testRegistration() {
+        TestRootNode<AddNode> root = createRoot(AddNodeFactory.getInstance());
+        assertTrue(NodeClass.get(root.getNode()) instanceof GeneratedNodeClass);
+        assertFalse(NodeClass.get(root) instanceof GeneratedNodeClass);
+    }
+
+    @Test
+    public void testSpecializationRegistration() {
+        TestRootNode<AddOrConcatNode> root = createRoot(AddOrConcatNodeFactory.getInstance());
+        assertEquals(42, executeWith(root, 19, 23));
+        int specializations = 0;
+        Node current = root.getNode();
+        while (current != null) {
+            Node next = null;
+            for (Node child : collectChildren(current)) {
+                if (child instanceof SpecializationNode) {
+                    assertTrue(NodeClass.get(child) instanceof GeneratedNodeClass);
+                    assertSame(current, child.getParent());
+                    specializations++;
+                    next = child;
+                }
+            }
+            current = next;
+        }
+        assertTrue(specializations > 0);
+    }
+
+    @Test
+    public void testForEachChild() {
+        TestRootNode<AddNode> root = createRoot(AddNodeFactory.getInstance());
+        AddNode node = root.getNode();
+        List<Node> children = collectChildren(node);
+        assertEquals(NodeUtil.findNodeChildren(node), children);
+        for (Node child : children) {
+            assertSame(node, child.getParent());
+        }
+    }
+
+    @Test
+    public void testReplaceChild() {
+        TestRootNode<AddNode> root = createRoot(AddNodeFactory.getInstance());
+        AddNode node = root.getNode();
+        assertEquals(42, executeWith(root, 19, 23));
+
+        ArgumentNode left = (ArgumentNode) collectChildren(node).get(0);
+        ArgumentNode newLeft = left.replace(new ArgumentNode(1));
+        assertSame(node, newLeft.getParent());
+        assertTrue(collectChildren(node).contains(newLeft));
+        assertFalse(collectChildren(node).contains(left));
+        assertEquals(46, executeWith(root, 19, 23));
+    }
+
+    @Test
+    public void testDeepCopy() {
+        TestRootNode<AddNode> root = createRoot(AddNodeFactory.getInstance());
+        AddNode node = root.getNode();
+        assertEquals(42, executeWith(root, 19, 23));
+
+        AddNode copy = (AddNode) node.deepCopy();
+        List<Node> originalChildren = collectChildren(node);
+        List<Node> copiedChildren = collectChildren(copy);
+        assertEquals(originalChildren.size(), copiedChildren.size());
+        for (int i = 0; i < copiedChildren.size(); i++) {
+            assertNotSame(originalChildren.get(i), copiedChildren.get(i));
+            assertSame(originalChildren.get(i).getClass(), copiedChildren.get(i).getClass());
+            assertSame(copy, copiedChildren.get(i).getParent());
+        }
+
+        TestRootNode<AddNode> copyRoot = new TestRootNode<>(copy);
+        copyRoot.adoptChildren();
+        assertEquals(42, executeWith(copyRoot, 19, 23));
+    }
+
+    private static List<Node> collectChildren(Node node) {
+        final List<Node> children = new ArrayList<>();
+        NodeUtil.forEachChild(node, new NodeVisitor() {
+            public boolean visit(Node child) {
+                children.add(child);
+                return true;
+            }
+        });
+        return children;
+    }
+
+    @NodeChildren({@NodeChild("left"), @NodeChild("right")})
+    abstract static class AddNode extends ValueNode {
+
+        @Specialization
+        int add(int left, int right) {
+            return left + right;
+        }
+
+    }
+
+    @NodeChildren({@NodeChild("left"), @NodeChild("right")})
+    abstract static class AddOrConcatNode extends ValueNode {
+
+        @Specialization
+        int add(int left, int right) {
+            return left + right;
+        }
+
+        @Specialization
+        String concat(String left, String right) {
+            return left + right;
+        }
+
+    }
+
+}
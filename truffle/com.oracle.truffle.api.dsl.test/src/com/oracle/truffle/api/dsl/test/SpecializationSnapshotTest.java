@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl.test;
+
+import static com.oracle.truffle.api.dsl.test.TestHelper.createCallTarget;
+import static com.oracle.truffle.api.dsl.test.TestHelper.getNode;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.Collections;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.RootCallTarget;
+import com.oracle.truffle.api.dsl.NodeChild;
+import com.oracle.truffle.api.dsl.Specialization;
+import com.oracle.truffle.api.dsl.SpecializationSnapshot;
+import com.oracle.truffle.api.dsl.internal.SpecializationNode;
+import com.oracle.truffle.api.dsl.internal.SpecializedNode;
+import com.oracle.truffle.api.dsl.test.SpecializationSnapshotTestFactory.SnapshotNodeFactory;
+import com.oracle.truffle.api.dsl.test.TypeSystemTest.ValueNode;
+import com.oracle.truffle.api.nodes.NodeCost;
+
+public class SpecializationSnapshotTest {
+
+    @Test
+    public void testReplay() throws IOException {
+        RootCallTarget target = createCallTarget(SnapshotNodeFactory.getInstance());
+        assertEquals("int", target.call(42));
+        assertEquals("string", target.call("a"));
+        assertEquals(NodeCost.POLYMORPHIC, getNode(target).getCost());
+
+        SpecializationSnapshot snapshot = SpecializationSnapshot.capture(Collections.singleton(target));
+        assertEquals(1, snapshot.getNodeCount());
+
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        snapshot.writeTo(out);
+        SpecializationSnapshot read = SpecializationSnapshot.readFrom(new ByteArrayInputStream(out.toByteArray()));
+        assertEquals(snapshot.getSpecializations(), read.getSpecializations());
+
+        RootCallTarget fresh = createCallTarget(SnapshotNodeFactory.getInstance());
+        assertEquals(NodeCost.UNINITIALIZED, getNode(fresh).getCost());
+        assertEquals(2, read.apply(fresh.getRootNode()));
+        SpecializedNode node = (SpecializedNode) getNode(fresh);
+        assertEquals(Arrays.asList("doInt(int)", "doString(String)"), SpecializationNode.getActiveSpecializations(node));
+        assertEquals(NodeCost.POLYMORPHIC, getNode(fresh).getCost());
+        assertEquals("int", fresh.call(42));
+        assertEquals("string", fresh.call("a"));
+
+        // applying again finds everything in place
+        assertEquals(0, read.apply(fresh.getRootNode()));
+    }
+
+    @Test
+    public void testInvalidStream() {
+        try {
+            SpecializationSnapshot.readFrom(new ByteArrayInputStream(new byte[]{0, 0, 0, 0, 0, 0, 0, 1}));
+            fail();
+        } catch (IOException e) {
+        }
+    }
+
+    @NodeChild("a")
+    abstract static class SnapshotNode extends ValueNode {
+
+        @Specialization
+        String doInt(@SuppressWarnings("unused") int a) {
+            return "int";
+        }
+
+        @Specialization
+        String doString(@SuppressWarnings("unused") String a) {
+            return "string";
+        }
+    }
+
+}
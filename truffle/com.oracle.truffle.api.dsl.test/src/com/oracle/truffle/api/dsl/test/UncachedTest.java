@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl.test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.fail;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.Assumption;
+import com.oracle.truffle.api.ExactMath;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.dsl.Cached;
+import com.oracle.truffle.api.dsl.Fallback;
+import com.oracle.truffle.api.dsl.GenerateUncached;
+import com.oracle.truffle.api.dsl.Specialization;
+import com.oracle.truffle.api.dsl.UnsupportedSpecializationException;
+import com.oracle.truffle.api.dsl.test.UncachedTestFactory.UncachedAddNodeGen;
+import com.oracle.truffle.api.dsl.test.UncachedTestFactory.UncachedAssumptionNodeGen;
+import com.oracle.truffle.api.dsl.test.UncachedTestFactory.UncachedCacheNodeGen;
+import com.oracle.truffle.api.dsl.test.UncachedTestFactory.UncachedContainsNodeGen;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.NodeCost;
+
+public class UncachedTest {
+
+    @Test
+    public void testRewriteOnAndFallback() {
+        UncachedAddNode node = UncachedAddNodeGen.getUncached();
+        assertSame(node, UncachedAddNodeGen.getUncached());
+        assertNull(node.getParent());
+        assertEquals(NodeCost.MEGAMORPHIC, node.getCost());
+
+        assertEquals(3, node.execute(1, 2));
+        assertEquals((long) Integer.MAX_VALUE + 1, node.execute(Integer.MAX_VALUE, 1));
+        assertEquals(3, node.execute(1, 2));
+        assertEquals("fallback", node.execute("a", 2));
+        assertNull(node.getParent());
+    }
+
+    @GenerateUncached
+    abstract static class UncachedAddNode extends Node {
+
+        abstract Object execute(Object left, Object right);
+
+        @Specialization(rewriteOn = ArithmeticException.class)
+        int doInt(int left, int right) {
+            return ExactMath.addExact(left, right);
+        }
+
+        @Specialization
+        long doOverflow(int left, int right) {
+            return (long) left + right;
+        }
+
+        @Fallback
+        Object doFallback(@SuppressWarnings("unused") Object left, @SuppressWarnings("unused") Object right) {
+            return "fallback";
+        }
+    }
+
+    @Test
+    public void testCached() {
+        UncachedCacheNode node = UncachedCacheNodeGen.getUncached();
+        assertEquals("a1", node.execute("a"));
+        assertEquals("abc3", node.execute("abc"));
+        try {
+            node.execute(42);
+            fail();
+        } catch (UnsupportedSpecializationException e) {
+            assertSame(node, e.getNode());
+            assertEquals(1, e.getSuppliedNodes().length);
+            assertEquals(42, e.getSuppliedValues()[0]);
+        }
+    }
+
+    @GenerateUncached
+    abstract static class UncachedCacheNode extends Node {
+
+        abstract Object execute(Object value);
+
+        @Specialization(guards = "value.length() == cachedLength", limit = "2")
+        String doCached(String value, @Cached("value.length()") int cachedLength) {
+            return value + cachedLength;
+        }
+    }
+
+    @Test
+    public void testContains() {
+        UncachedContainsNode node = UncachedContainsNodeGen.getUncached();
+        assertEquals("generic", node.execute(1));
+        assertEquals("generic", node.execute("a"));
+    }
+
+    @GenerateUncached
+    abstract static class UncachedContainsNode extends Node {
+
+        abstract Object execute(Object value);
+
+        @Specialization
+        String doInt(@SuppressWarnings("unused") int value) {
+            return "int";
+        }
+
+        @Specialization(contains = "doInt")
+        String doGeneric(@SuppressWarnings("unused") Object value) {
+            return "generic";
+        }
+    }
+
+    @Test
+    public void testAssumption() {
+        UncachedAssumptionNode node = UncachedAssumptionNodeGen.getUncached();
+        assertEquals("valid", node.execute(1));
+        UncachedAssumptionNode.ASSUMPTION.invalidate();
+        assertEquals("invalid", node.execute(1));
+    }
+
+    @GenerateUncached
+    abstract static class UncachedAssumptionNode extends Node {
+
+        static final Assumption ASSUMPTION = Truffle.getRuntime().createAssumption();
+
+        abstract Object execute(Object value);
+
+        @Specialization(assumptions = "ASSUMPTION")
+        String doValid(@SuppressWarnings("unused") int value) {
+            return "valid";
+        }
+
+        @Specialization
+        String doInvalid(@SuppressWarnings("unused") int value) {
+            return "invalid";
+        }
+    }
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl;
+
+import java.lang.annotation.ElementType;
+import java.lang.annotation.Retention;
+import java.lang.annotation.RetentionPolicy;
+import java.lang.annotation.Target;
+
+/**
+ * Annotate nodes or base classes of nodes to generate an uncached version of the node in addition
+ * to the specializing one. The uncached version is a shared, stateless instance that is obtained
+ * with the static <code>getUncached()</code> method of the generated node class. It can be executed
+ * from any thread without being adopted by a {@link com.oracle.truffle.api.nodes.RootNode} and never
+ * rewrites itself.
+ * <p>
+ * The uncached version re-evaluates the guards of all specializations in declaration order on every
+ * execution and invokes the first one that matches. {@link Cached} values and assumptions are
+ * computed on the fly for every call. Specializations that are contained by another specialization
+ * are skipped and specializations that throw one of their <code>rewriteOn</code> exceptions fall
+ * through to the next one. If no specialization matches the {@link Fallback} method is invoked or
+ * an {@link UnsupportedSpecializationException} is thrown.
+ * <p>
+ * Only execute methods that provide all evaluated values as parameters are implemented by the
+ * uncached version; other abstract execute methods throw {@link UnsupportedOperationException}.
+ * Nodes with {@link NodeField} or {@link ShortCircuit} declarations cannot be uncached, and the
+ * node class must provide a non-private constructor without parameters.
+ *
+ * <pre>
+ * &#064;GenerateUncached
+ * abstract class AddNode extends Node {
+ *
+ *     abstract Object execute(Object left, Object right);
+ *
+ *     &#064;Specialization
+ *     int doInt(int left, int right) {
+ *         return left + right;
+ *     }
+ * }
+ *
+ * Object result = AddNodeGen.getUncached().execute(1, 2);
+ * </pre>
+ */
+@Retention(RetentionPolicy.CLASS)
+@Target({ElementType.TYPE})
+public @interface GenerateUncached {
+
+}
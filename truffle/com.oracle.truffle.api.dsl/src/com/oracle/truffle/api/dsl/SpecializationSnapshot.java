@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl;
+
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+
+import com.oracle.truffle.api.RootCallTarget;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.dsl.internal.FlatSpecializedNode;
+import com.oracle.truffle.api.dsl.internal.SpecializationNode;
+import com.oracle.truffle.api.dsl.internal.SpecializedNode;
+import com.oracle.truffle.api.frame.FrameSlot;
+import com.oracle.truffle.api.frame.FrameSlotKind;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.SourceSection;
+
+/**
+ * The specialization state of a set of ASTs: the active specializations of each DSL generated node,
+ * with a specialization chain or a flat state bitset, and the kinds of the frame slots of each
+ * root. A snapshot {@linkplain #capture() captured} at the end of a run can be
+ * {@linkplain #writeTo(OutputStream) written} to a file and {@linkplain #apply(RootNode) applied}
+ * to the freshly parsed ASTs of the next run, so that they start out with the specializations they
+ * ended up with instead of rewriting one step at a time.
+ * <p>
+ * Nodes are identified by the source and position of their closest enclosing source section, their
+ * class and their order among nodes of the same class in that section. Sources are identified by
+ * name and a hash of their code, so a snapshot is only applied to unchanged sources. Roots without
+ * a source section are identified by their class and, if their class defines one, their string
+ * representation.
+ * <p>
+ * Only specializations that can be created without execution values are applied; specializations
+ * that use caches or implicit cast profiles are activated on execution as usual. A specialization
+ * state that no longer fits the code just causes the usual rewrites.
+ */
+public final class SpecializationSnapshot {
+
+    private static final int MAGIC = 0x54535053; // "TSPS"
+    private static final int VERSION = 1;
+
+    private final Map<String, List<String>> specializations;
+    private final Map<String, String> slotKinds;
+
+    private SpecializationSnapshot(Map<String, List<String>> specializations, Map<String, String> slotKinds) {
+        this.specializations = specializations;
+        this.slotKinds = slotKinds;
+    }
+
+    /**
+     * Creates an empty snapshot.
+     */
+    public SpecializationSnapshot() {
+        this(new TreeMap<String, List<String>>(), new TreeMap<String, String>());
+    }
+
+    /**
+     * Captures the specialization state of all call targets of the current
+     * {@linkplain Truffle#getRuntime() runtime}.
+     */
+    public static SpecializationSnapshot capture() {
+        return capture(Truffle.getRuntime().getCallTargets());
+    }
+
+    /**
+     * Captures the specialization state of the given call targets.
+     */
+    public static SpecializationSnapshot capture(Collection<? extends RootCallTarget> callTargets) {
+        final SpecializationSnapshot snapshot = new SpecializationSnapshot();
+        for (RootCallTarget callTarget : callTargets) {
+            final RootNode root = callTarget.getRootNode();
+            final String rootKey = rootKey(root);
+            for (FrameSlot slot : root.getFrameDescriptor().getSlots()) {
+                if (slot.getKind() != FrameSlotKind.Illegal) {
+                    snapshot.slotKinds.put(rootKey + "/" + slot.getIdentifier(), slot.getKind().name());
+                }
+            }
+            visitNodes(root, rootKey, new HashMap<String, Integer>(), new NodeVisitor() {
+                public void visit(String key, Node node) {
+                    final List<String> names;
+                    if (node instanceof FlatSpecializedNode) {
+                        names = SpecializationNode.getActiveSpecializations((FlatSpecializedNode) node);
+                    } else {
+                        names = SpecializationNode.getActiveSpecializations((SpecializedNode) node);
+                    }
+                    if (!names.isEmpty()) {
+                        snapshot.specializations.put(key, names);
+                    }
+                }
+            });
+        }
+        return snapshot;
+    }
+
+    /**
+     * Gets the number of nodes with recorded specializations.
+     */
+    public int getNodeCount() {
+        return specializations.size();
+    }
+
+    /**
+     * Gets the recorded specializations of all nodes, by node key. The names are the reference
+     * names of the specialization methods, e.g. <code>doInt(int, int)</code>.
+     */
+    public Map<String, List<String>> getSpecializations() {
+        return Collections.unmodifiableMap(specializations);
+    }
+
+    /**
+     * Applies this snapshot to the given call targets.
+     *
+     * @return the number of specializations and frame slot kinds applied
+     */
+    public int apply(Collection<? extends RootCallTarget> callTargets) {
+        int applied = 0;
+        for (RootCallTarget callTarget : callTargets) {
+            applied += apply(callTarget.getRootNode());
+        }
+        return applied;
+    }
+
+    /**
+     * Pre-specializes a freshly parsed AST: inserts the recorded specializations into its DSL
+     * generated nodes and sets the recorded kinds of frame slots that have no kind yet.
+     *
+     * @return the number of specializations and frame slot kinds applied
+     */
+    public int apply(RootNode root) {
+        final String rootKey = rootKey(root);
+        final int[] applied = new int[1];
+        for (FrameSlot slot : root.getFrameDescriptor().getSlots()) {
+            final String kind = slotKinds.get(rootKey + "/" + slot.getIdentifier());
+            if (kind != null && slot.getKind() == FrameSlotKind.Illegal) {
+                slot.setKind(FrameSlotKind.valueOf(kind));
+                applied[0]++;
+            }
+        }
+        visitNodes(root, rootKey, new HashMap<String, Integer>(), new NodeVisitor() {
+            public void visit(String key, Node node) {
+                final List<String> names = specializations.get(key);
+                if (names == null) {
+                    return;
+                }
+                if (node instanceof FlatSpecializedNode) {
+                    applied[0] += SpecializationNode.preSpecialize((FlatSpecializedNode) node, names);
+                } else {
+                    applied[0] += SpecializationNode.preSpecialize((SpecializedNode) node, names);
+                }
+            }
+        });
+        return applied[0];
+    }
+
+    /**
+     * Writes this snapshot in binary form.
+     */
+    public void writeTo(OutputStream out) throws IOException {
+        final DataOutputStream data = new DataOutputStream(out);
+        data.writeInt(MAGIC);
+        data.writeInt(VERSION);
+        data.writeInt(specializations.size());
+        for (Map.Entry<String, List<String>> entry : specializations.entrySet()) {
+            data.writeUTF(entry.getKey());
+            data.writeInt(entry.getValue().size());
+            for (String name : entry.getValue()) {
+                data.writeUTF(name);
+            }
+        }
+        data.writeInt(slotKinds.size());
+        for (Map.Entry<String, String> entry : slotKinds.entrySet()) {
+            data.writeUTF(entry.getKey());
+            data.writeUTF(entry.getValue());
+        }
+        data.flush();
+    }
+
+    /**
+     * Reads a snapshot written by {@link #writeTo(OutputStream)}.
+     *
+     * @throws IOException if the stream does not hold a snapshot
+     */
+    public static SpecializationSnapshot readFrom(InputStream in) throws IOException {
+        final DataInputStream data = new DataInputStream(in);
+        if (data.readInt() != MAGIC) {
+            throw new IOException("Not a specialization snapshot");
+        }
+        final int version = data.readInt();
+        if (version != VERSION) {
+            throw new IOException("Unsupported specialization snapshot version " + version);
+        }
+        final SpecializationSnapshot snapshot = new SpecializationSnapshot();
+        final int nodeCount = data.readInt();
+        for (int i = 0; i < nodeCount; i++) {
+            final String key = data.readUTF();
+            final int nameCount = data.readInt();
+            final List<String> names = new ArrayList<>(nameCount);
+            for (int j = 0; j < nameCount; j++) {
+                names.add(data.readUTF());
+            }
+            snapshot.specializations.put(key, names);
+        }
+        final int slotCount = data.readInt();
+        for (int i = 0; i < slotCount; i++) {
+            snapshot.slotKinds.put(data.readUTF(), data.readUTF());
+        }
+        return snapshot;
+    }
+
+    private interface NodeVisitor {
+
+        void visit(String key, Node node);
+
+    }
+
+    private static void visitNodes(Node node, String scope, Map<String, Integer> ordinals, NodeVisitor visitor) {
+        if (node instanceof SpecializationNode) {
+            // specialization chains and their cached nodes are recorded by their owner
+            return;
+        }
+        final SourceSection section = node.getSourceSection();
+        final String nodeScope = section != null && section.getSource() != null ? sectionKey(section) : scope;
+        if (node instanceof SpecializedNode || node instanceof FlatSpecializedNode) {
+            final String id = nodeScope + "/" + node.getClass().getName();
+            final Integer ordinal = ordinals.get(id);
+            final int next = ordinal == null ? 0 : ordinal;
+            ordinals.put(id, next + 1);
+            visitor.visit(id + "#" + next, node);
+        }
+        for (Node child : node.getChildren()) {
+            visitNodes(child, nodeScope, ordinals, visitor);
+        }
+    }
+
+    private static String rootKey(RootNode root) {
+        final SourceSection section = root.getSourceSection();
+        if (section != null && section.getSource() != null) {
+            return sectionKey(section);
+        }
+        try {
+            if (root.getClass().getMethod("toString").getDeclaringClass() != Node.class) {
+                // languages name their roots in toString, the default includes the identity hash
+                return root.getClass().getName() + ":" + root;
+            }
+        } catch (NoSuchMethodException e) {
+            throw new AssertionError(e);
+        }
+        return root.getClass().getName();
+    }
+
+    private static String sectionKey(SourceSection section) {
+        return section.getSource().getName() + "@" + Integer.toHexString(section.getSource().getCode().hashCode()) + ":" + section.getCharIndex() + "+" + section.getCharLength();
+    }
+}
@@ -51,6 +51,22 @@ public @interface DSLOptions {
     /** Not yet implemented. */
     boolean useDisjunctiveMethodGuardOptimization() default true;
 
+    /**
+     * Generates a specialized {@link com.oracle.truffle.api.nodes.NodeClass} for each generated
+     * node that visits, replaces and copies its children without reflective field access. Nodes
+     * with child fields that are not accessible from the generated code fall back to the default
+     * implementation.
+     */
+    boolean generateNodeClass() default true;
+
+    /**
+     * Generates a single node class per operation that records its active specializations in an
+     * <code>int</code> state field and checks their guards inline, instead of a chain of
+     * specialization nodes. Operations that use caches, assumptions, rewriteOn exceptions, implicit
+     * casts, fallbacks or short circuits still generate the specialization chain.
+     */
+    boolean useFlatStateBitset() default false;
+
     public enum ImplicitCastOptimization {
 
         /** Perform no informed optimization for implicit casts. */
@@ -24,6 +24,7 @@
  */
 package com.oracle.truffle.api.dsl.internal;
 
+import com.oracle.truffle.api.Assumption;
 import com.oracle.truffle.api.CompilerAsserts;
 import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.NodeCost;
@@ -50,6 +51,22 @@ public class DSLShare {
         return false;
     }
 
+    /** Used by uncached nodes to check assumptions that are computed on every execution. */
+    public static boolean isValid(Assumption assumption) {
+        return assumption == null || assumption.isValid();
+    }
+
+    public static boolean isValid(Assumption[] assumptions) {
+        if (assumptions != null) {
+            for (Assumption assumption : assumptions) {
+                if (!isValid(assumption)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     private static boolean includes(Node oldNode, DSLNode newNode) {
         return containsClass(newNode.getMetadata0().getIncludes(), oldNode);
     }
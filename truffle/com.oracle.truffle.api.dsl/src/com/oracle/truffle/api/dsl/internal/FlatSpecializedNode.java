@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.dsl.internal;
+
+import com.oracle.truffle.api.nodes.NodeInterface;
+
+/**
+ * Implemented by DSL generated operation classes that keep their active specializations in a
+ * state bitset instead of a chain of {@link SpecializationNode specialization nodes}. This is
+ * internal implementation dependent API.
+ */
+public interface FlatSpecializedNode extends NodeInterface {
+
+    /**
+     * Returns the reference names of the specializations of the operation, indexed by their bit in
+     * the state.
+     */
+    String[] getSpecializationNames();
+
+    /** Returns the state bitset of the active specializations. */
+    int getSpecializationState();
+
+    /**
+     * Sets the state bitset of the active specializations. Use
+     * {@link SpecializationNode#updateFlatState} to change it.
+     */
+    void setSpecializationState(int state);
+
+}
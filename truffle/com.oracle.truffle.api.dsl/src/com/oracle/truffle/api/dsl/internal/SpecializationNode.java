@@ -24,14 +24,19 @@
  */
 package com.oracle.truffle.api.dsl.internal;
 
+import java.lang.reflect.Constructor;
 import java.lang.reflect.Field;
+import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Modifier;
+import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.List;
 import java.util.concurrent.Callable;
 
 import com.oracle.truffle.api.Assumption;
 import com.oracle.truffle.api.CompilerAsserts;
 import com.oracle.truffle.api.CompilerDirectives;
+import com.oracle.truffle.api.dsl.GeneratedBy;
 import com.oracle.truffle.api.dsl.UnsupportedSpecializationException;
 import com.oracle.truffle.api.dsl.internal.SlowPathEvent.SlowPathEvent0;
 import com.oracle.truffle.api.dsl.internal.SlowPathEvent.SlowPathEvent1;
@@ -87,6 +92,150 @@ public abstract class SpecializationNode extends Node {
         }
     }
 
+    /**
+     * Returns the names of the specializations that are active in the specialization chain of a
+     * DSL generated node, in chain order. The names are the reference names of the specialization
+     * methods, e.g. <code>doInt(int, int)</code>. Uninitialized and polymorphic nodes of the chain
+     * are not included.
+     */
+    public static List<String> getActiveSpecializations(SpecializedNode node) {
+        List<String> names = new ArrayList<>();
+        SpecializationNode current = node.getSpecializationNode();
+        while (current != null) {
+            String name = getSpecializationName(current.getClass());
+            if (name != null) {
+                names.add(name);
+            }
+            current = current.next;
+        }
+        return names;
+    }
+
+    /**
+     * Inserts specializations into the specialization chain of a DSL generated node as if they had
+     * been activated by executing the node, e.g. to replay the state of a previous run. Only
+     * specializations that can be created without execution values are inserted; specializations
+     * with caches or implicit cast profiles are left to be activated on execution. Names that are
+     * already active or unknown are ignored.
+     *
+     * @return the number of inserted specializations
+     */
+    public static int preSpecialize(final SpecializedNode node, final List<String> names) {
+        return ((Node) node).atomic(new Callable<Integer>() {
+            public Integer call() {
+                int inserted = 0;
+                for (String name : names) {
+                    SpecializationNode start = node.getSpecializationNode();
+                    if (start.index == Integer.MAX_VALUE || getActiveSpecializations(node).contains(name)) {
+                        continue;
+                    }
+                    SpecializationNode generated = createSpecialization(node, name);
+                    if (generated == null || generated.index == Integer.MAX_VALUE) {
+                        continue;
+                    }
+                    insertSorted(start, generated, "pre-specialize " + name, generated);
+                    inserted++;
+                }
+                return inserted;
+            }
+        });
+    }
+
+    /**
+     * Returns the names of the specializations that are active in the state of a DSL generated
+     * node with a flat state bitset, in declaration order.
+     *
+     * @see #getActiveSpecializations(SpecializedNode)
+     */
+    public static List<String> getActiveSpecializations(FlatSpecializedNode node) {
+        List<String> names = new ArrayList<>();
+        String[] specializations = node.getSpecializationNames();
+        int state = node.getSpecializationState();
+        for (int i = 0; i < specializations.length; i++) {
+            if ((state & (1 << i)) != 0) {
+                names.add(specializations[i]);
+            }
+        }
+        return names;
+    }
+
+    /**
+     * Activates specializations in the state of a DSL generated node with a flat state bitset as if
+     * they had been activated by executing the node. Names that are already active or unknown are
+     * ignored.
+     *
+     * @return the number of activated specializations
+     * @see #preSpecialize(SpecializedNode, List)
+     */
+    public static int preSpecialize(FlatSpecializedNode node, List<String> names) {
+        List<String> specializations = Arrays.asList(node.getSpecializationNames());
+        int activated = 0;
+        for (String name : names) {
+            int index = specializations.indexOf(name);
+            if (index < 0 || (node.getSpecializationState() & (1 << index)) != 0) {
+                continue;
+            }
+            updateFlatState(node, 0, 0, 1 << index, "pre-specialize " + name);
+            activated++;
+        }
+        return activated;
+    }
+
+    /**
+     * Activates a specialization in the state of a DSL generated node with a flat state bitset:
+     * unless a specialization in <code>excludedBy</code> is active, deactivates the specializations
+     * in <code>excludes</code> and activates <code>specialization</code>. The state is updated
+     * atomically and a change is {@linkplain Node#reportRewrite(CharSequence) reported} like the
+     * replace of a specialization node.
+     *
+     * @return <code>false</code> if the specialization is excluded by an active one
+     */
+    public static boolean updateFlatState(final FlatSpecializedNode node, final int excludedBy, final int excludes, final int specialization, final CharSequence reason) {
+        CompilerAsserts.neverPartOfCompilation();
+        return ((Node) node).atomic(new Callable<Boolean>() {
+            public Boolean call() {
+                int state = node.getSpecializationState();
+                if ((state & excludedBy) != 0) {
+                    return false;
+                }
+                int newState = (state & ~excludes) | specialization;
+                if (newState != state) {
+                    node.setSpecializationState(newState);
+                    ((Node) node).reportRewrite(reason);
+                }
+                return true;
+            }
+        });
+    }
+
+    private static String getSpecializationName(Class<?> specializationClass) {
+        GeneratedBy generatedBy = specializationClass.getAnnotation(GeneratedBy.class);
+        if (generatedBy == null || generatedBy.methodName().isEmpty()) {
+            return null;
+        }
+        return generatedBy.methodName();
+    }
+
+    private static SpecializationNode createSpecialization(SpecializedNode node, String name) {
+        for (Class<?> specializationClass : node.getClass().getDeclaredClasses()) {
+            if (!SpecializationNode.class.isAssignableFrom(specializationClass) || !name.equals(getSpecializationName(specializationClass))) {
+                continue;
+            }
+            for (Constructor<?> constructor : specializationClass.getDeclaredConstructors()) {
+                Class<?>[] parameterTypes = constructor.getParameterTypes();
+                if (parameterTypes.length == 1 && parameterTypes[0].isInstance(node)) {
+                    try {
+                        constructor.setAccessible(true);
+                        return (SpecializationNode) constructor.newInstance(node);
+                    } catch (InstantiationException | IllegalAccessException | InvocationTargetException e) {
+                        throw new IllegalStateException(e);
+                    }
+                }
+            }
+        }
+        return null;
+    }
+
     protected final SpecializationNode polymorphicMerge(SpecializationNode newNode, SpecializationNode merged) {
         if (merged == newNode && count() <= 2) {
             return removeSame(new SlowPathEvent0(this, "merged polymorphic to monomorphic", null));
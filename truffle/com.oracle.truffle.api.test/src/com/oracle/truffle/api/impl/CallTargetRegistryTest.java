@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.impl;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.RootCallTarget;
+import com.oracle.truffle.api.TestingLanguage;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.RootNode;
+
+public class CallTargetRegistryTest {
+
+    @Test
+    public void testCounts() {
+        DefaultTruffleRuntime runtime = new DefaultTruffleRuntime();
+        List<RootCallTarget> targets = new ArrayList<>();
+        for (int i = 0; i < 10; i++) {
+            targets.add(runtime.createCallTarget(new TestRootNode()));
+        }
+        assertEquals(10, runtime.getCreatedCallTargetCount());
+        assertEquals(10, runtime.getLiveCallTargetCount());
+        assertTrue(runtime.getCallTargets().containsAll(targets));
+    }
+
+    @Test
+    public void testDisabled() {
+        CallTargetRegistry registry = new CallTargetRegistry(false);
+        RootCallTarget target = new DefaultCallTarget(new TestRootNode());
+        registry.register(target);
+        assertEquals(1, registry.createdCount());
+        assertEquals(0, registry.liveCount());
+        assertTrue(registry.snapshot().isEmpty());
+    }
+
+    @Test
+    public void testSnapshotWhileRegistering() throws InterruptedException {
+        final DefaultTruffleRuntime runtime = new DefaultTruffleRuntime();
+        final int threads = 4;
+        final int perThread = 500;
+        final List<RootCallTarget> kept = new ArrayList<>();
+        final CountDownLatch done = new CountDownLatch(threads);
+        for (int t = 0; t < threads; t++) {
+            new Thread() {
+                @Override
+                public void run() {
+                    List<RootCallTarget> created = new ArrayList<>();
+                    for (int i = 0; i < perThread; i++) {
+                        created.add(runtime.createCallTarget(new TestRootNode()));
+                    }
+                    synchronized (kept) {
+                        kept.addAll(created);
+                    }
+                    done.countDown();
+                }
+            }.start();
+        }
+        while (done.getCount() > 0) {
+            Collection<RootCallTarget> snapshot = runtime.getCallTargets();
+            int count = 0;
+            for (RootCallTarget target : snapshot) {
+                assertTrue(target.getRootNode() instanceof TestRootNode);
+                count++;
+            }
+            assertEquals(snapshot.size(), count);
+        }
+        done.await();
+        assertEquals(threads * perThread, runtime.getCreatedCallTargetCount());
+        assertEquals(threads * perThread, runtime.getLiveCallTargetCount());
+        assertTrue(runtime.getCallTargets().containsAll(kept));
+    }
+
+    private static class TestRootNode extends RootNode {
+
+        TestRootNode() {
+            super(TestingLanguage.class, null, null);
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            return null;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.impl;
+
+import static org.junit.Assert.assertEquals;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.TestingLanguage;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.LoopNode;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.RepeatingNode;
+import com.oracle.truffle.api.nodes.RootNode;
+
+public class DefaultLoopNodeTest {
+
+    @Test
+    public void reportsIterationsToCallTarget() {
+        LoopRootNode root = new LoopRootNode(5);
+        DefaultCallTarget target = (DefaultCallTarget) new DefaultTruffleRuntime().createCallTarget(root);
+        assertEquals(5, target.call());
+        assertEquals(5, target.getLoopCount());
+        assertEquals(5, target.call());
+        assertEquals(10, target.getLoopCount());
+    }
+
+    @Test
+    public void reportsLongLoopsWhileRunning() {
+        int iterations = 3 * DefaultLoopNode.REPORT_INTERVAL + 7;
+        final DefaultCallTarget[] target = new DefaultCallTarget[1];
+        final long[] seenWhileRunning = new long[1];
+        LoopRootNode root = new LoopRootNode(iterations) {
+            @Override
+            void onIteration(int iteration) {
+                if (iteration == 2 * DefaultLoopNode.REPORT_INTERVAL + 1) {
+                    seenWhileRunning[0] = target[0].getLoopCount();
+                }
+            }
+        };
+        target[0] = (DefaultCallTarget) new DefaultTruffleRuntime().createCallTarget(root);
+        assertEquals(iterations, target[0].call());
+        assertEquals(2 * DefaultLoopNode.REPORT_INTERVAL, seenWhileRunning[0]);
+        assertEquals(iterations, target[0].getLoopCount());
+    }
+
+    private static class LoopRootNode extends RootNode {
+
+        @Child LoopNode loop;
+        private final int iterations;
+        private int counter;
+
+        LoopRootNode(int iterations) {
+            super(TestingLanguage.class, null, null);
+            this.iterations = iterations;
+            this.loop = new DefaultTruffleRuntime().createLoopNode(new CountingNode());
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            counter = 0;
+            loop.executeLoop(frame);
+            return counter;
+        }
+
+        void onIteration(@SuppressWarnings("unused") int iteration) {
+        }
+
+        private class CountingNode extends Node implements RepeatingNode {
+
+            public boolean executeRepeating(VirtualFrame frame) {
+                if (counter == iterations) {
+                    return false;
+                }
+                onIteration(++counter);
+                return true;
+            }
+        }
+    }
+}
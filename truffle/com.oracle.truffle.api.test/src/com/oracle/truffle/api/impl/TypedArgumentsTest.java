@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.impl;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.TestingLanguage;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.frame.Frame;
+import com.oracle.truffle.api.frame.FrameDescriptor;
+import com.oracle.truffle.api.frame.FrameSlot;
+import com.oracle.truffle.api.frame.FrameSlotKind;
+import com.oracle.truffle.api.frame.FrameSlotTypeException;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.DirectCallNode;
+import com.oracle.truffle.api.nodes.RootNode;
+
+public class TypedArgumentsTest {
+
+    @Test
+    public void callLeavesParameterSlotsToCallee() {
+        AddRootNode add = new AddRootNode();
+        CallTarget target = Truffle.getRuntime().createCallTarget(add);
+        assertEquals(0L, target.call(3L, 4L));
+        assertEquals(FrameSlotKind.Illegal, add.a.getKind());
+        assertEquals(FrameSlotKind.Illegal, add.b.getKind());
+        assertArrayEquals(new Object[]{3L, 4L}, add.arguments);
+    }
+
+    @Test
+    public void typedCallPassesUnboxedArguments() {
+        AddRootNode add = new AddRootNode();
+        add.a.setKind(FrameSlotKind.Long);
+        add.b.setKind(FrameSlotKind.Long);
+        CallTarget callee = Truffle.getRuntime().createCallTarget(add);
+        CallerRootNode caller = new CallerRootNode(callee);
+        CallTarget target = Truffle.getRuntime().createCallTarget(caller);
+
+        assertEquals(42L, target.call(40L, 2L));
+        assertNotNull(caller.argumentFrame);
+        assertArrayEquals(new Object[]{40L, 2L}, add.arguments);
+        assertNull(caller.callNode.createArgumentFrame(1));
+    }
+
+    @Test
+    public void argumentsSurviveParameterWrites() {
+        AddRootNode add = new AddRootNode();
+        add.overwriteFirst = true;
+        CallTarget callee = Truffle.getRuntime().createCallTarget(add);
+        CallerRootNode caller = new CallerRootNode(callee);
+        CallTarget target = Truffle.getRuntime().createCallTarget(caller);
+
+        assertEquals(102L, target.call(1L, 2L));
+        assertArrayEquals(new Object[]{1L, 2L}, add.arguments);
+    }
+
+    @Test
+    public void argumentsSurviveWritesToHighParameterSlots() {
+        AddRootNode add = new AddRootNode(70);
+        add.overwriteFirst = true;
+        CallTarget callee = Truffle.getRuntime().createCallTarget(add);
+        CallerRootNode caller = new CallerRootNode(callee);
+        CallTarget target = Truffle.getRuntime().createCallTarget(caller);
+
+        assertEquals(102L, target.call(1L, 2L));
+        assertArrayEquals(new Object[]{1L, 2L}, add.arguments);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void parameterMustBelongToDescriptor() {
+        FrameDescriptor descriptor = new FrameDescriptor();
+        descriptor.addParameterSlot(new FrameDescriptor().addFrameSlot("x"));
+    }
+
+    private static class AddRootNode extends RootNode {
+
+        final FrameSlot a;
+        final FrameSlot b;
+        boolean overwriteFirst;
+        Object[] arguments;
+
+        AddRootNode() {
+            this(0);
+        }
+
+        AddRootNode(int leadingLocals) {
+            super(TestingLanguage.class, null, new FrameDescriptor(0L));
+            FrameDescriptor descriptor = getFrameDescriptor();
+            for (int i = 0; i < leadingLocals; i++) {
+                descriptor.addFrameSlot("local" + i);
+            }
+            a = descriptor.addFrameSlot("a");
+            b = descriptor.addFrameSlot("b");
+            descriptor.addParameterSlot(a);
+            descriptor.addParameterSlot(b);
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            if (overwriteFirst) {
+                frame.setLong(a, 100L);
+            }
+            arguments = frame.getArguments();
+            return read(frame, a) + read(frame, b);
+        }
+
+        private static long read(VirtualFrame frame, FrameSlot slot) {
+            try {
+                return frame.getLong(slot);
+            } catch (FrameSlotTypeException e) {
+                return (Long) frame.getValue(slot);
+            }
+        }
+    }
+
+    private static class CallerRootNode extends RootNode {
+
+        @Child DirectCallNode callNode;
+        Frame argumentFrame;
+
+        CallerRootNode(CallTarget callee) {
+            super(TestingLanguage.class, null, null);
+            this.callNode = Truffle.getRuntime().createDirectCallNode(callee);
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            Object[] args = frame.getArguments();
+            argumentFrame = callNode.createArgumentFrame(args.length);
+            if (argumentFrame == null) {
+                return callNode.call(frame, args);
+            }
+            for (int i = 0; i < args.length; i++) {
+                FrameSlot slot = argumentFrame.getFrameDescriptor().getParameterSlots().get(i);
+                argumentFrame.setLong(slot, (Long) args[i]);
+            }
+            return callNode.call(frame, argumentFrame);
+        }
+    }
+}
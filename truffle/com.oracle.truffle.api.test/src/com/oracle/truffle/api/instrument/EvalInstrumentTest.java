@@ -131,4 +131,51 @@ public class EvalInstrumentTest {
         assertEquals(evalCount[0], 3);
         assertEquals(evalResult[0], 0);
     }
+
+    @Test
+    public void testEvalInstrumentParsesOncePerProbe() throws IOException {
+
+        instrumenter.registerASTProber(new InstrumentationTestingLanguage.TestASTProber());
+        final Source source13 = InstrumentationTestingLanguage.createAdditionSource13("testEvalInstrumentParsesOncePerProbe");
+
+        final Probe[] addNodeProbe = new Probe[1];
+        instrumenter.addProbeListener(new DefaultProbeListener() {
+
+            @Override
+            public void probeTaggedAs(Probe probe, SyntaxTag tag, Object tagValue) {
+                if (tag == InstrumentTestTag.ADD_TAG) {
+                    addNodeProbe[0] = probe;
+                }
+            }
+        });
+        assertEquals(vm.eval(source13).get(), 13);
+        assertNotNull("Add node should be probed", addNodeProbe[0]);
+
+        final int[] evalCount = {0};
+        final EvalInstrumentListener listener = new EvalInstrumentListener() {
+
+            public void onExecution(Node node, VirtualFrame vFrame, Object result) {
+                evalCount[0] = evalCount[0] + 1;
+            }
+
+            public void onFailure(Node node, VirtualFrame vFrame, Exception ex) {
+                fail("Eval test evaluates without exception");
+            }
+        };
+        final int parseCount = InstrumentationTestingLanguage.constantParseCount;
+
+        final Instrument instrument = instrumenter.attach(addNodeProbe[0], InstrumentationTestingLanguage.createConstantSource42("testEvalInstrumentParsesOncePerProbe"), listener,
+                        "test EvalInstrument", null);
+        assertEquals(vm.eval(source13).get(), 13);
+        assertEquals(vm.eval(source13).get(), 13);
+        assertEquals(2, evalCount[0]);
+        assertEquals("Parsed on first execution", parseCount + 1, InstrumentationTestingLanguage.constantParseCount);
+
+        // Re-attaching an equal source reuses the call target parsed at the probe
+        instrument.dispose();
+        instrumenter.attach(addNodeProbe[0], InstrumentationTestingLanguage.createConstantSource42("testEvalInstrumentParsesOncePerProbe"), listener, "test EvalInstrument", null);
+        assertEquals(vm.eval(source13).get(), 13);
+        assertEquals(3, evalCount[0]);
+        assertEquals("Not parsed again", parseCount + 1, InstrumentationTestingLanguage.constantParseCount);
+    }
 }
@@ -47,6 +47,9 @@ public final class InstrumentationTestingLanguage extends TruffleLanguage<Object
     private static final String ADD_SOURCE_TEXT = "Fake source text for testing:  parses to 6 + 7";
     private static final String CONSTANT_SOURCE_TEXT = "Fake source text for testing: parses to 42";
 
+    /** Number of times a source created by {@link #createConstantSource42} has been parsed. */
+    static int constantParseCount;
+
     /** Use a unique test name to avoid unexpected CallTarget sharing. */
     static Source createAdditionSource13(String testName) {
         return Source.fromText(ADD_SOURCE_TEXT, testName).withMimeType("text/x-instTest");
@@ -95,6 +98,7 @@ public final class InstrumentationTestingLanguage extends TruffleLanguage<Object
             return callTarget;
         }
         if (source.getCode().equals(CONSTANT_SOURCE_TEXT)) {
+            constantParseCount++;
             final TestValueNode constantNode = new TestValueNode(42);
             final InstrumentationTestRootNode rootNode = new InstrumentationTestRootNode(constantNode);
             final TruffleRuntime runtime = Truffle.getRuntime();
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import org.junit.After;
+import org.junit.Test;
+
+import com.oracle.truffle.api.TestingLanguage;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.RewriteProfiler.RewriteSite;
+import com.oracle.truffle.api.nodes.RewriteProfiler.RewriteTransition;
+
+public class RewriteProfilerTest {
+
+    private final RewriteProfiler previous = RewriteProfiler.getInstance();
+
+    @After
+    public void restoreProfiler() {
+        RewriteProfiler.install(previous);
+    }
+
+    @Test
+    public void testStableSite() {
+        final RewriteProfiler profiler = new RewriteProfiler();
+        RewriteProfiler.install(profiler);
+        final TestRootNode root = new TestRootNode(new UninitializedNode());
+        root.child.replace(new SpecializedNode(), "specialize");
+        root.child.replace(new GenericNode(), "generalize");
+
+        final RewriteSite[] sites = profiler.getSites();
+        assertEquals(1, sites.length);
+        assertEquals(root, sites[0].rootNode());
+        assertEquals(2, sites[0].rewriteCount());
+        assertFalse(sites[0].isUnstable());
+        assertEquals("generalize", sites[0].lastReason());
+        final RewriteTransition[] transitions = sites[0].transitions();
+        assertEquals(2, transitions.length);
+        assertEquals(UninitializedNode.class, transitions[0].nodeClass());
+        assertEquals(NodeCost.UNINITIALIZED, transitions[0].fromCost());
+        assertEquals(NodeCost.MONOMORPHIC, transitions[0].toCost());
+        assertEquals(SpecializedNode.class, transitions[1].nodeClass());
+        assertEquals(NodeCost.MEGAMORPHIC, transitions[1].toCost());
+    }
+
+    @Test
+    public void testUnstableSite() {
+        final RewriteProfiler profiler = new RewriteProfiler();
+        RewriteProfiler.install(profiler);
+        final TestRootNode root = new TestRootNode(new SpecializedNode());
+        for (int i = 0; i < 3; i++) {
+            root.child.replace(new GenericNode(), "generalize");
+            root.child.replace(new SpecializedNode(), "respecialize");
+        }
+
+        final RewriteSite[] sites = profiler.getSites();
+        assertEquals(1, sites.length);
+        assertEquals(6, sites[0].rewriteCount());
+        assertTrue(sites[0].isUnstable());
+        assertEquals(5, sites[0].flipCount());
+        assertEquals(2, sites[0].transitions().length);
+
+        profiler.reset();
+        assertEquals(0, profiler.getSites().length);
+    }
+
+    @Test
+    public void testGrowingPolymorphicCache() {
+        final RewriteProfiler profiler = new RewriteProfiler();
+        RewriteProfiler.install(profiler);
+        final TestRootNode root = new TestRootNode(new UninitializedNode());
+        root.child.replace(new SpecializedNode(), "specialize");
+        for (int i = 0; i < 4; i++) {
+            root.child.replace(new PolymorphicNode(), "add cache entry");
+        }
+
+        final RewriteSite[] sites = profiler.getSites();
+        assertEquals(1, sites.length);
+        assertEquals(5, sites[0].rewriteCount());
+        assertFalse(sites[0].isUnstable());
+        assertEquals(0, sites[0].flipCount());
+        final RewriteTransition[] transitions = sites[0].transitions();
+        assertEquals(3, transitions.length);
+        assertEquals(PolymorphicNode.class, transitions[2].nodeClass());
+        assertEquals(NodeCost.POLYMORPHIC, transitions[2].fromCost());
+        assertEquals(NodeCost.POLYMORPHIC, transitions[2].toCost());
+        assertEquals(3, transitions[2].count());
+
+        root.child.replace(new SpecializedNode(), "respecialize");
+        assertTrue(profiler.getSites()[0].isUnstable());
+        assertEquals(1, profiler.getSites()[0].flipCount());
+    }
+
+    @Test
+    public void testNotInstalled() {
+        final RewriteProfiler profiler = new RewriteProfiler();
+        RewriteProfiler.install(null);
+        final TestRootNode root = new TestRootNode(new UninitializedNode());
+        root.child.replace(new SpecializedNode(), "specialize");
+        assertEquals(0, profiler.getSites().length);
+    }
+
+    @NodeInfo(cost = NodeCost.UNINITIALIZED)
+    private static class UninitializedNode extends Node {
+    }
+
+    private static class SpecializedNode extends Node {
+    }
+
+    @NodeInfo(cost = NodeCost.POLYMORPHIC)
+    private static class PolymorphicNode extends Node {
+    }
+
+    @NodeInfo(cost = NodeCost.MEGAMORPHIC)
+    private static class GenericNode extends Node {
+    }
+
+    private static class TestRootNode extends RootNode {
+
+        @Child Node child;
+
+        TestRootNode(Node child) {
+            super(TestingLanguage.class, null, null);
+            this.child = child;
+            adoptChildren();
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            return null;
+        }
+    }
+}
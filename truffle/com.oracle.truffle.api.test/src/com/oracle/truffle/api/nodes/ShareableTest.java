@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes;
+
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertSame;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.TestingLanguage;
+import com.oracle.truffle.api.frame.VirtualFrame;
+
+public class ShareableTest {
+
+    @Test
+    public void testDeepCopySharesStableSubtrees() {
+        TestRootNode root = createTree(true);
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+        copy.adoptChildren();
+
+        assertNotSame(root.child, copy.child);
+        assertSame(copy, copy.child.getParent());
+        assertSame(root.child.constant, copy.child.constant);
+        assertSame(root.child, copy.child.constant.getParent());
+        assertSame(root.child.constant.child, copy.child.constant.child);
+        assertSame(root.child.constant, copy.child.constant.child.getParent());
+    }
+
+    @Test
+    public void testUnadoptedTreesAreCopied() {
+        TestRootNode root = createTree(false);
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+        root.adoptChildren();
+        copy.adoptChildren();
+
+        assertNotSame(root.child.constant, copy.child.constant);
+        assertSame(copy.child, copy.child.constant.getParent());
+    }
+
+    @Test
+    public void testPolymorphicNodesAreCopied() {
+        TestRootNode root = createTree(true);
+        root.child.constant.cost = NodeCost.POLYMORPHIC;
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+
+        assertNotSame(root.child.constant, copy.child.constant);
+        assertSame(copy.child, copy.child.constant.getParent());
+    }
+
+    @Test
+    public void testMaterializePath() {
+        TestRootNode root = createTree(true);
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+        copy.adoptChildren();
+        ConstantNode shared = copy.child.constant.child;
+
+        ConstantNode materialized = NodeUtil.materializePath(copy, shared);
+        assertNotSame(shared, materialized);
+        assertSame(copy, materialized.getRootNode());
+        assertSame(materialized, copy.child.constant.child);
+        assertNotSame(root.child.constant, copy.child.constant);
+        assertSame(root, shared.getRootNode());
+        assertSame(shared, root.child.constant.child);
+
+        materialized.replace(new ConstantNode());
+        assertSame(shared, root.child.constant.child);
+        assertNotSame(shared, copy.child.constant.child);
+        assertSame(copy, copy.child.constant.child.getRootNode());
+    }
+
+    @Test
+    public void testWrapSharedNodeInOwningTree() {
+        TestRootNode root = createTree(true);
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+        copy.adoptChildren();
+        ConstantNode shared = root.child.constant.child;
+
+        ConstantNode wrapper = new ConstantNode();
+        wrapper.child = shared;
+        shared.replace(wrapper);
+        assertSame(wrapper, root.child.constant.child);
+        assertSame(wrapper, shared.getParent());
+        assertSame(root, shared.getRootNode());
+        assertSame(shared, copy.child.constant.child);
+
+        ConstantNode replacement = new ConstantNode();
+        shared.replace(replacement);
+        assertSame(replacement, wrapper.child);
+        assertSame(wrapper, replacement.getParent());
+    }
+
+    @Test
+    public void testReplaceBelowSharedNodeCopiesOnWrite() {
+        TestRootNode root = createTree(true);
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+        copy.adoptChildren();
+        ConstantNode sharedParent = root.child.constant;
+        ConstantNode shared = sharedParent.child;
+
+        ConstantNode replacement = shared.replace(new ConstantNode());
+        assertNotSame(sharedParent, root.child.constant);
+        assertSame(replacement, root.child.constant.child);
+        assertSame(root.child.constant, replacement.getParent());
+        assertSame(sharedParent, copy.child.constant);
+        assertSame(shared, copy.child.constant.child);
+    }
+
+    @Test
+    public void testMaterializeSharedNodes() {
+        TestRootNode root = createTree(true);
+        TestRootNode copy = (TestRootNode) root.deepCopy();
+        copy.adoptChildren();
+
+        NodeUtil.materializeSharedNodes(copy);
+        assertNotSame(root.child.constant, copy.child.constant);
+        assertNotSame(root.child.constant.child, copy.child.constant.child);
+        assertSame(copy.child, copy.child.constant.getParent());
+        assertSame(copy.child.constant, copy.child.constant.child.getParent());
+        assertSame(root.child, root.child.constant.getParent());
+        assertSame(root.child.constant, root.child.constant.child.getParent());
+    }
+
+    @Test
+    public void testMaterializeUnsharedNode() {
+        TestRootNode root = createTree(true);
+        ConstantNode constant = root.child.constant;
+        assertSame(constant, NodeUtil.materializePath(root, constant));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testMaterializeUnreachableNode() {
+        NodeUtil.materializePath(createTree(true), new ConstantNode());
+    }
+
+    private static TestRootNode createTree(boolean adopt) {
+        TestRootNode root = new TestRootNode();
+        root.child = new TestNode();
+        root.child.constant = new ConstantNode();
+        root.child.constant.child = new ConstantNode();
+        if (adopt) {
+            root.adoptChildren();
+        }
+        return root;
+    }
+
+    private static class TestNode extends Node {
+
+        @Child ConstantNode constant;
+
+    }
+
+    @Shareable
+    private static class ConstantNode extends Node {
+
+        @Child ConstantNode child;
+
+        NodeCost cost = NodeCost.MONOMORPHIC;
+
+        @Override
+        public NodeCost getCost() {
+            return cost;
+        }
+
+    }
+
+    private static class TestRootNode extends RootNode {
+
+        @Child TestNode child;
+
+        public TestRootNode() {
+            super(TestingLanguage.class, null, null);
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            return null;
+        }
+
+    }
+
+}
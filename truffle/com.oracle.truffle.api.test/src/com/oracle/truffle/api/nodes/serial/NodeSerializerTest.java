@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes.serial;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.fail;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.math.BigInteger;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.TestingLanguage;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.frame.FrameDescriptor;
+import com.oracle.truffle.api.frame.FrameSlot;
+import com.oracle.truffle.api.frame.FrameSlotKind;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.profiles.BranchProfile;
+import com.oracle.truffle.api.source.Source;
+
+public class NodeSerializerTest {
+
+    private static final String CODE = "x = 42; x; 12345678901234567890";
+
+    private static TestRootNode parse(Source source) {
+        FrameDescriptor descriptor = new FrameDescriptor();
+        FrameSlot slot = descriptor.addFrameSlot("x", FrameSlotKind.Object);
+        TestRootNode root = new TestRootNode(source, descriptor, new ExpressionNode[]{
+                        new WriteNode(source, 0, 6, slot, new ConstantNode(source, 4, 2, 42)),
+                        new ReadNode(source, 8, 1, slot),
+                        new ConstantNode(source, 11, 20, new BigInteger("12345678901234567890"))});
+        root.adoptChildren();
+        return root;
+    }
+
+    private static byte[] write(Source source, RootNode root) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        NodeSerializer.write(source, Collections.singletonList(root), out);
+        return out.toByteArray();
+    }
+
+    private static List<RootNode> read(Source source, byte[] bytes) throws IOException {
+        return NodeDeserializer.read(source, new ByteArrayInputStream(bytes), NodeSerializerTest.class.getClassLoader());
+    }
+
+    @Test
+    public void testRoundTrip() throws IOException {
+        Source source = Source.fromText(CODE, "test");
+        TestRootNode original = parse(source);
+        List<RootNode> roots = read(source, write(source, original));
+        assertEquals(1, roots.size());
+
+        TestRootNode root = (TestRootNode) roots.get(0);
+        assertNotSame(original, root);
+        assertNull(root.getParent());
+        assertEquals(original.getSourceSection(), root.getSourceSection());
+        assertEquals(3, root.body.length);
+
+        WriteNode write = (WriteNode) root.body[0];
+        ReadNode read = (ReadNode) root.body[1];
+        assertSame(root, write.getParent());
+        assertSame(write, write.value.getParent());
+        assertEquals(original.body[0].getSourceSection(), write.getSourceSection());
+        assertEquals("x = 42", write.getSourceSection().getCode());
+        assertEquals(42, ((ConstantNode) write.value).value);
+
+        FrameSlot slot = root.getFrameDescriptor().findFrameSlot("x");
+        assertSame(slot, write.slot);
+        assertSame(slot, read.slot);
+        assertEquals(FrameSlotKind.Object, slot.getKind());
+        assertNotSame(original.getFrameDescriptor(), root.getFrameDescriptor());
+        assertSame(((ReadNode) original.body[1]).unset.getClass(), read.unset.getClass());
+
+        assertEquals(new BigInteger("12345678901234567890"), Truffle.getRuntime().createCallTarget(root).call());
+    }
+
+    @Test
+    public void testChangedSource() throws IOException {
+        Source source = Source.fromText(CODE, "test");
+        byte[] bytes = write(source, parse(source));
+        try {
+            read(Source.fromText(CODE + " ", "test"), bytes);
+            fail();
+        } catch (IOException e) {
+        }
+    }
+
+    @Test
+    public void testCorruptLength() throws IOException {
+        Source source = Source.fromText(CODE, "test");
+        byte[] bytes = write(source, parse(source));
+        // the node count follows the magic, the version and the content hash
+        int nodeCountOffset = 12 + 2 * NodeSerializer.getContentHash(source).length();
+        for (int length : new int[]{Integer.MAX_VALUE, -1}) {
+            ByteBuffer.wrap(bytes).putInt(nodeCountOffset, length);
+            try {
+                read(source, bytes);
+                fail();
+            } catch (IOException e) {
+            }
+        }
+    }
+
+    @Test
+    public void testTruncated() throws IOException {
+        Source source = Source.fromText(CODE, "test");
+        byte[] bytes = write(source, parse(source));
+        for (int length = 0; length < bytes.length; length++) {
+            try {
+                read(source, Arrays.copyOf(bytes, length));
+                fail();
+            } catch (IOException e) {
+            }
+        }
+    }
+
+    @Test
+    public void testUnsupportedValue() throws IOException {
+        Source source = Source.fromText(CODE, "test");
+        try {
+            write(source, parse(source).withConstant(new Object()));
+            fail();
+        } catch (IOException e) {
+        }
+    }
+
+    static final class TestRootNode extends RootNode {
+
+        @Children private final ExpressionNode[] body;
+
+        TestRootNode(Source source, FrameDescriptor descriptor, ExpressionNode[] body) {
+            super(TestingLanguage.class, source.createSection("root", 0, source.getCode().length()), descriptor);
+            this.body = body;
+        }
+
+        TestRootNode withConstant(Object value) {
+            body[2].replace(new ConstantNode(getSourceSection().getSource(), 11, 20, value));
+            return this;
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            Object result = null;
+            for (int i = 0; i < body.length; i++) {
+                result = body[i].execute(frame);
+            }
+            return result;
+        }
+    }
+
+    abstract static class ExpressionNode extends Node {
+
+        ExpressionNode(Source source, int charIndex, int length) {
+            super(source.createSection(null, charIndex, length));
+        }
+
+        abstract Object execute(VirtualFrame frame);
+    }
+
+    static final class ConstantNode extends ExpressionNode {
+
+        private final Object value;
+
+        ConstantNode(Source source, int charIndex, int length, Object value) {
+            super(source, charIndex, length);
+            this.value = value;
+        }
+
+        @Override
+        Object execute(VirtualFrame frame) {
+            return value;
+        }
+    }
+
+    static final class WriteNode extends ExpressionNode {
+
+        private final FrameSlot slot;
+        @Child private ExpressionNode value;
+
+        WriteNode(Source source, int charIndex, int length, FrameSlot slot, ExpressionNode value) {
+            super(source, charIndex, length);
+            this.slot = slot;
+            this.value = value;
+        }
+
+        @Override
+        Object execute(VirtualFrame frame) {
+            Object result = value.execute(frame);
+            frame.setObject(slot, result);
+            return result;
+        }
+    }
+
+    static final class ReadNode extends ExpressionNode {
+
+        private final FrameSlot slot;
+        private final BranchProfile unset = BranchProfile.create();
+
+        ReadNode(Source source, int charIndex, int length, FrameSlot slot) {
+            super(source, charIndex, length);
+            this.slot = slot;
+        }
+
+        @Override
+        Object execute(VirtualFrame frame) {
+            Object result = frame.getValue(slot);
+            if (result == null) {
+                unset.enter();
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.source;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.util.Arrays;
+import java.util.Collections;
+
+import org.junit.Test;
+
+public class SourceSectionIndexTest {
+
+    // offsets: line 1 = 0..12, line 2 = 13..25, line 3 = 26..30, line 4 = 31..32
+    private final Source source = Source.fromText("function f {\n  a = b + c;\n  d;\n}\n", "sourceSectionIndexTest");
+
+    private final SourceSection function = source.createSection("function", 0, source.getLength());
+    private final SourceSection assign = source.createSection("assign", 15, 10);
+    private final SourceSection add = source.createSection("add", 19, 5);
+    private final SourceSection d = source.createSection("d", 28, 2);
+
+    private SourceSectionIndex<String> createIndex() {
+        final SourceSectionIndex<String> index = new SourceSectionIndex<>();
+        // deliberately out of order
+        index.add(d, "d");
+        index.add(add, "add");
+        index.add(function, "function");
+        index.add(assign, "assign");
+        return index;
+    }
+
+    @Test
+    public void testLineQueries() {
+        final SourceSectionIndex<String> index = createIndex();
+        assertEquals(Arrays.asList("function"), index.findStartingOn(source.createLineLocation(1)));
+        assertEquals(Arrays.asList("assign", "add"), index.findStartingOn(source.createLineLocation(2)));
+        assertEquals(Arrays.asList("d"), index.findStartingOn(source.createLineLocation(3)));
+        assertEquals(Collections.emptyList(), index.findStartingOn(source.createLineLocation(4)));
+        assertEquals(Collections.emptyList(), index.findStartingOn(source.createLineLocation(10)));
+    }
+
+    @Test
+    public void testPointQueries() {
+        final SourceSectionIndex<String> index = createIndex();
+        assertEquals(Arrays.asList("function"), index.findContaining(source, 0));
+        assertEquals(Arrays.asList("function", "assign"), index.findContaining(source, 15));
+        assertEquals(Arrays.asList("function", "assign", "add"), index.findContaining(source, 21));
+        assertEquals(Arrays.asList("function", "assign"), index.findContaining(source, 24));
+        assertEquals(Arrays.asList("function"), index.findContaining(source, 25));
+        assertEquals(Collections.emptyList(), index.findContaining(source, source.getLength()));
+    }
+
+    @Test
+    public void testRangeQueries() {
+        final SourceSectionIndex<String> index = createIndex();
+        assertEquals(Arrays.asList("function", "assign", "add", "d"), index.findOverlapping(function));
+        assertEquals(Arrays.asList("function", "assign", "add"), index.findOverlapping(add));
+        assertEquals(Arrays.asList("function", "d"), index.findOverlapping(source, 26, 8));
+        assertEquals(Collections.emptyList(), index.findOverlapping(source, 26, 0));
+        assertEquals(Arrays.asList("function", "assign", "add", "d"), index.findAll(source));
+    }
+
+    @Test
+    public void testRemove() {
+        final SourceSectionIndex<String> index = createIndex();
+        index.add(assign, "assign2");
+        assertEquals(Arrays.asList("assign", "assign2", "add"), index.findStartingOn(source.createLineLocation(2)));
+        assertTrue(index.remove(assign, "assign"));
+        assertFalse(index.remove(assign, "assign"));
+        assertEquals(Arrays.asList("function", "assign2", "add"), index.findContaining(source, 20));
+
+        assertTrue(index.remove(function, "function"));
+        assertTrue(index.remove(assign, "assign2"));
+        assertTrue(index.remove(add, "add"));
+        assertEquals(Arrays.asList(source), Arrays.asList(index.getSources().toArray()));
+        assertTrue(index.remove(d, "d"));
+        assertTrue(index.getSources().isEmpty());
+    }
+
+    @Test
+    public void testManySections() {
+        final StringBuilder text = new StringBuilder();
+        for (int i = 0; i < 1000; i++) {
+            text.append("statement").append(i).append(";\n");
+        }
+        final Source many = Source.fromText(text.toString(), "many");
+        final SourceSectionIndex<Integer> index = new SourceSectionIndex<>();
+        for (int line = many.getLineCount(); line >= 1; line--) {
+            index.add(many.createSection("line", line), line);
+        }
+        for (int line = 1; line <= many.getLineCount(); line++) {
+            assertEquals(Arrays.asList(line), index.findStartingOn(many.createLineLocation(line)));
+            assertEquals(Arrays.asList(line), index.findContaining(many, many.getLineStartOffset(line)));
+        }
+    }
+
+    @Test
+    public void testWholeFileSection() {
+        final StringBuilder text = new StringBuilder();
+        for (int i = 0; i < 1000; i++) {
+            text.append("statement").append(i).append(";\n");
+        }
+        final Source many = Source.fromText(text.toString(), "wholeFile");
+        final SourceSectionIndex<Integer> index = new SourceSectionIndex<>();
+        final SourceSection file = many.createSection("file", 0, many.getLength());
+        index.add(file, 0);
+        for (int line = 1; line <= many.getLineCount(); line++) {
+            index.add(many.createSection("line", line), line);
+        }
+        index.add(file, -1);
+        for (int line = 1; line <= many.getLineCount(); line++) {
+            assertEquals(Arrays.asList(0, -1, line), index.findContaining(many, many.getLineStartOffset(line)));
+        }
+        assertEquals(Arrays.asList(0, -1, 1), index.findStartingOn(many.createLineLocation(1)));
+        assertEquals(Arrays.asList(0, -1, 500, 501), index.findOverlapping(many, many.getLineStartOffset(501) - 2, 3));
+        assertEquals(many.getLineCount() + 2, index.findOverlapping(file).size());
+
+        assertTrue(index.remove(file, 0));
+        assertEquals(Arrays.asList(-1, 700), index.findContaining(many, many.getLineStartOffset(700)));
+        assertTrue(index.remove(file, -1));
+        assertEquals(Arrays.asList(700), index.findContaining(many, many.getLineStartOffset(700)));
+    }
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.utilities;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import com.oracle.truffle.api.Assumption;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.impl.AbstractAssumption;
+import com.oracle.truffle.api.nodes.InvalidAssumptionException;
+
+public class AssumptionsTest {
+
+    @Before
+    public void resetCounts() {
+        Assumptions.resetInvalidationCounts();
+    }
+
+    @Test
+    public void testListenerRunsOnce() {
+        final Assumption assumption = Truffle.getRuntime().createAssumption("listened");
+        final int[] runs = new int[1];
+        Assumptions.addInvalidationListener(assumption, new Runnable() {
+            public void run() {
+                runs[0]++;
+            }
+        });
+        assertEquals(0, runs[0]);
+        assumption.invalidate();
+        assertEquals(1, runs[0]);
+        assumption.invalidate();
+        assertEquals(1, runs[0]);
+    }
+
+    @Test
+    public void testListenerOnInvalidAssumption() {
+        final Assumption assumption = Truffle.getRuntime().createAssumption();
+        assumption.invalidate();
+        final boolean[] run = new boolean[1];
+        Assumptions.addInvalidationListener(assumption, new Runnable() {
+            public void run() {
+                run[0] = true;
+            }
+        });
+        assertTrue(run[0]);
+    }
+
+    @Test
+    public void testUnionListenerRunsOnce() {
+        final Assumption first = Truffle.getRuntime().createAssumption();
+        final Assumption second = Truffle.getRuntime().createAssumption();
+        final int[] runs = new int[1];
+        Assumptions.addInvalidationListener(new UnionAssumption(first, second), new Runnable() {
+            public void run() {
+                runs[0]++;
+            }
+        });
+        second.invalidate();
+        first.invalidate();
+        assertEquals(1, runs[0]);
+    }
+
+    @Test
+    public void testBatchInvalidation() {
+        final Assumption first = Truffle.getRuntime().createAssumption();
+        final Assumption second = Truffle.getRuntime().createAssumption();
+        final Assumption third = Truffle.getRuntime().createAssumption();
+        final List<Boolean> observed = new ArrayList<>();
+        final Runnable listener = new Runnable() {
+            public void run() {
+                observed.add(first.isValid() || second.isValid() || third.isValid());
+            }
+        };
+        Assumptions.addInvalidationListener(first, listener);
+        Assumptions.addInvalidationListener(third, listener);
+        Assumptions.invalidate(first, new UnionAssumption(second, third));
+        assertEquals(2, observed.size());
+        assertFalse(observed.get(0));
+        assertFalse(observed.get(1));
+    }
+
+    @Test
+    public void testInvalidationCounts() {
+        final CyclicAssumption cyclic = new CyclicAssumption("churn");
+        for (int i = 0; i < 3; i++) {
+            cyclic.invalidate();
+        }
+        Truffle.getRuntime().createAssumption().invalidate();
+        assertEquals(Long.valueOf(3), Assumptions.getInvalidationCounts().get("churn"));
+        assertEquals(Long.valueOf(1), Assumptions.getInvalidationCounts().get("<unnamed>"));
+
+        Assumptions.resetInvalidationCounts();
+        assertNull(Assumptions.getInvalidationCounts().get("churn"));
+    }
+
+    @Test
+    public void testInvalidationVisibleOnOtherThread() throws InterruptedException {
+        final Assumption assumption = Truffle.getRuntime().createAssumption();
+        final Thread checker = new Thread() {
+            @Override
+            public void run() {
+                while (assumption.isValid()) {
+                    // spin until the invalidation becomes visible
+                }
+            }
+        };
+        checker.setDaemon(true);
+        checker.start();
+        assumption.invalidate();
+        checker.join(10000);
+        assertFalse(checker.isAlive());
+    }
+
+    @Test
+    public void testOverriddenInvalidateNotifiesListenersOnce() {
+        final List<String> events = new ArrayList<>();
+        final RecordingAssumption first = new RecordingAssumption("first", events);
+        final RecordingAssumption second = new RecordingAssumption("second", events);
+        Assumptions.addInvalidationListener(first, new Runnable() {
+            public void run() {
+                events.add("listener first");
+            }
+        });
+        first.invalidate();
+        first.invalidate();
+        assertEquals(3, events.size());
+        assertEquals("invalidate first", events.get(0));
+        assertEquals("listener first", events.get(1));
+        assertEquals("invalidate first", events.get(2));
+        assertEquals(Long.valueOf(1), Assumptions.getInvalidationCounts().get("first"));
+
+        events.clear();
+        final RecordingAssumption third = new RecordingAssumption("third", events);
+        Assumptions.addInvalidationListener(second, new Runnable() {
+            public void run() {
+                events.add("listener second");
+            }
+        });
+        Assumptions.invalidate(second, third);
+        assertEquals(3, events.size());
+        assertEquals("invalidate second", events.get(0));
+        assertEquals("invalidate third", events.get(1));
+        assertEquals("listener second", events.get(2));
+        assertEquals(Long.valueOf(1), Assumptions.getInvalidationCounts().get("second"));
+    }
+
+    /**
+     * Overrides {@link AbstractAssumption#invalidate()} like a runtime that invalidates dependent
+     * code, and notifies the listeners every time.
+     */
+    private static final class RecordingAssumption extends AbstractAssumption {
+
+        private final List<String> events;
+
+        RecordingAssumption(String name, List<String> events) {
+            super(name);
+            this.events = events;
+        }
+
+        @Override
+        public void invalidate() {
+            isValid = false;
+            events.add("invalidate " + name);
+            notifyInvalidated();
+        }
+
+        public void check() throws InvalidAssumptionException {
+            if (!isValid) {
+                throw new InvalidAssumptionException();
+            }
+        }
+
+        public boolean isValid() {
+            return isValid;
+        }
+    }
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.vm;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.fail;
+
+import java.io.IOException;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.TruffleLanguage;
+import com.oracle.truffle.api.frame.MaterializedFrame;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.instrument.Visualizer;
+import com.oracle.truffle.api.instrument.WrapperNode;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.Source;
+
+public class ContextPerThreadTest {
+    private static final String MIME_TYPE = "application/x-test-thread-context";
+
+    @Test
+    public void eachThreadHasItsOwnContext() throws Exception {
+        final PolyglotEngine vm = PolyglotEngine.newBuilder().contextPerThread(true).build();
+        final Source source = Source.fromText("thread", "thread.ctx").withMimeType(MIME_TYPE);
+        final int parsedBefore = ThreadContextLanguage.parsed.get();
+
+        final Object[] results = new Object[4];
+        Thread[] threads = new Thread[results.length];
+        for (int i = 0; i < threads.length; i++) {
+            final int index = i;
+            threads[i] = new Thread("ctx-" + i) {
+                @Override
+                public void run() {
+                    try {
+                        results[index] = vm.eval(source).get();
+                    } catch (IOException ex) {
+                        results[index] = ex;
+                    }
+                }
+            };
+            threads[i].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+
+        for (int i = 0; i < results.length; i++) {
+            assertEquals("ctx-" + i, results[i]);
+        }
+        assertEquals("Code is parsed once and shared", parsedBefore + 1, ThreadContextLanguage.parsed.get());
+        assertEquals(Thread.currentThread().getName(), vm.eval(source).get());
+
+        final int disposedBefore = ThreadContextLanguage.disposed.get();
+        vm.dispose();
+        assertEquals(results.length + 1, ThreadContextLanguage.disposed.get() - disposedBefore);
+    }
+
+    @Test
+    public void singleThreadedByDefault() throws Exception {
+        final PolyglotEngine vm = PolyglotEngine.newBuilder().build();
+        final Source source = Source.fromText("thread", "thread.ctx").withMimeType(MIME_TYPE);
+        assertEquals(Thread.currentThread().getName(), vm.eval(source).get());
+
+        final Object[] failure = {null};
+        Thread other = new Thread() {
+            @Override
+            public void run() {
+                try {
+                    vm.eval(source);
+                } catch (Exception ex) {
+                    failure[0] = ex;
+                }
+            }
+        };
+        other.start();
+        other.join();
+        if (!(failure[0] instanceof IllegalStateException)) {
+            fail("Expecting IllegalStateException, but was " + failure[0]);
+        }
+    }
+
+    @Test
+    public void contextsAreNotShared() throws Exception {
+        final PolyglotEngine vm = PolyglotEngine.newBuilder().contextPerThread(true).build();
+        final Source source = Source.fromText("context", "context.ctx").withMimeType(MIME_TYPE);
+        final Object mine = vm.eval(source).get();
+        final Object[] other = {null};
+        Thread thread = new Thread() {
+            @Override
+            public void run() {
+                try {
+                    other[0] = vm.eval(source).get();
+                } catch (IOException ex) {
+                    throw new IllegalStateException(ex);
+                }
+            }
+        };
+        thread.start();
+        thread.join();
+        assertNotSame(mine, other[0]);
+        assertEquals(mine, vm.eval(source).get());
+        assertNull(vm.findGlobalSymbol("unknown"));
+    }
+
+    @TruffleLanguage.Registration(name = "ThreadContext", mimeType = MIME_TYPE, version = "1.0")
+    public static final class ThreadContextLanguage extends TruffleLanguage<ThreadContext> {
+        public static final ThreadContextLanguage INSTANCE = new ThreadContextLanguage();
+
+        static final AtomicInteger parsed = new AtomicInteger();
+        static final AtomicInteger disposed = new AtomicInteger();
+
+        @Override
+        protected ThreadContext createContext(Env env) {
+            return new ThreadContext(Thread.currentThread());
+        }
+
+        @Override
+        protected void disposeContext(ThreadContext context) {
+            disposed.incrementAndGet();
+        }
+
+        @Override
+        protected CallTarget parse(final Source code, Node context, String... argumentNames) throws IOException {
+            parsed.incrementAndGet();
+            return Truffle.getRuntime().createCallTarget(new RootNode(ThreadContextLanguage.class, null, null) {
+                @Child private Node findContext = createFindContextNode();
+
+                @Override
+                public Object execute(VirtualFrame frame) {
+                    ThreadContext ctx = findContext(findContext);
+                    if (code.getCode().equals("thread")) {
+                        return ctx.thread.getName();
+                    }
+                    return ctx.toString();
+                }
+            });
+        }
+
+        @Override
+        protected Object findExportedSymbol(ThreadContext context, String globalName, boolean onlyExplicit) {
+            return null;
+        }
+
+        @Override
+        protected Object getLanguageGlobal(ThreadContext context) {
+            return null;
+        }
+
+        @Override
+        protected boolean isObjectOfLanguage(Object object) {
+            return false;
+        }
+
+        @Override
+        protected Visualizer getVisualizer() {
+            return null;
+        }
+
+        @Override
+        protected boolean isInstrumentable(Node node) {
+            return false;
+        }
+
+        @Override
+        protected WrapperNode createWrapperNode(Node node) {
+            throw new UnsupportedOperationException();
+        }
+
+        @Override
+        protected Object evalInContext(Source source, Node node, MaterializedFrame mFrame) throws IOException {
+            throw new UnsupportedOperationException();
+        }
+    }
+
+    static final class ThreadContext {
+        final Thread thread;
+
+        ThreadContext(Thread thread) {
+            this.thread = thread;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.vm;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.source.Source;
+
+public class EngineExecutorTest extends EngineTest {
+
+    @Override
+    protected Thread forbiddenThread() {
+        return Thread.currentThread();
+    }
+
+    @Override
+    protected PolyglotEngine.Builder createBuilder() {
+        return PolyglotEngine.newBuilder().executor(new EngineExecutor(16, EngineExecutor.Overflow.BLOCK));
+    }
+
+    @Test
+    public void batchEventsAreDelivered() throws Exception {
+        final CountDownLatch delivered = new CountDownLatch(1);
+        final EngineExecutor.BatchEvent[] last = {null};
+        PolyglotEngine vm = createBuilder().onEvent(new EventConsumer<EngineExecutor.BatchEvent>(EngineExecutor.BatchEvent.class) {
+            @Override
+            protected void on(EngineExecutor.BatchEvent event) {
+                last[0] = event;
+                delivered.countDown();
+            }
+        }).build();
+
+        PolyglotEngine.Language language = vm.getLanguages().get("application/x-test-hash");
+        language.eval(Source.fromText("anything", "something")).get();
+
+        assertTrue("Batch event delivered", delivered.await(10, TimeUnit.SECONDS));
+        assertTrue(last[0].getBatchSize() > 0);
+        assertTrue(last[0].getCompletedTasks() >= last[0].getBatchSize());
+        assertTrue(last[0].getMaxWaitNanos() >= 0);
+        assertEquals(0, last[0].getRejectedTasks());
+        vm.dispose();
+    }
+
+    @Test
+    public void rejectsWhenFull() throws Exception {
+        EngineExecutor executor = new EngineExecutor(1, EngineExecutor.Overflow.REJECT);
+        final CountDownLatch started = new CountDownLatch(1);
+        final CountDownLatch release = new CountDownLatch(1);
+        executor.execute(new Runnable() {
+            public void run() {
+                started.countDown();
+                try {
+                    release.await();
+                } catch (InterruptedException ex) {
+                    throw new IllegalStateException(ex);
+                }
+            }
+        });
+        assertTrue(started.await(10, TimeUnit.SECONDS));
+
+        final CountDownLatch queued = new CountDownLatch(1);
+        executor.execute(new Runnable() {
+            public void run() {
+                queued.countDown();
+            }
+        });
+        assertEquals(1, executor.getQueueDepth());
+        try {
+            executor.execute(new Runnable() {
+                public void run() {
+                }
+            });
+            fail("Expecting rejection");
+        } catch (RejectedExecutionException ex) {
+            // OK
+        }
+        assertEquals(1, executor.getRejectedCount());
+
+        release.countDown();
+        assertTrue("Queued task runs", queued.await(10, TimeUnit.SECONDS));
+        executor.shutdown();
+    }
+
+    @Test
+    public void nestedTasksRunInline() throws Exception {
+        final EngineExecutor executor = new EngineExecutor(4, EngineExecutor.Overflow.BLOCK);
+        final Thread[] threads = new Thread[2];
+        final CountDownLatch done = new CountDownLatch(1);
+        executor.execute(new Runnable() {
+            public void run() {
+                threads[0] = Thread.currentThread();
+                executor.execute(new Runnable() {
+                    public void run() {
+                        threads[1] = Thread.currentThread();
+                    }
+                });
+                done.countDown();
+            }
+        });
+        assertTrue(done.await(10, TimeUnit.SECONDS));
+        assertSame(threads[0], threads[1]);
+        executor.shutdown();
+    }
+
+    @Test(expected = RejectedExecutionException.class)
+    public void rejectsAfterShutdown() {
+        EngineExecutor executor = new EngineExecutor(4, EngineExecutor.Overflow.BLOCK);
+        executor.shutdown();
+        executor.execute(new Runnable() {
+            public void run() {
+            }
+        });
+    }
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.vm;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.logging.Level;
+
+/**
+ * Built-in {@link Executor} for {@link PolyglotEngine}. It runs all tasks on a single dedicated
+ * engine thread in the order they were submitted. Submitting threads put their tasks into a bounded
+ * queue; whenever the engine thread wakes up it drains all pending tasks and runs them as one
+ * batch. When the queue is full, the {@link Overflow overflow policy} decides whether the
+ * submitting thread waits for free space or the task is rejected.
+ * <p>
+ * Pass an instance to {@link PolyglotEngine.Builder#executor(java.util.concurrent.Executor)}. An
+ * executor can serve only one engine and is shut down when the engine is
+ * {@link PolyglotEngine#dispose() disposed}. After each batch a {@link BatchEvent} is delivered to
+ * the {@link PolyglotEngine.Builder#onEvent(EventConsumer) registered handlers} of the engine.
+ * <p>
+ * Tasks submitted from the engine thread itself, e.g. by a language calling back into the engine,
+ * are run immediately.
+ */
+public final class EngineExecutor implements Executor {
+
+    /** What happens to a task that is submitted while the queue is full. */
+    public enum Overflow {
+        /** The submitting thread waits until there is space in the queue. */
+        BLOCK,
+
+        /** The task is rejected with a {@link RejectedExecutionException}. */
+        REJECT
+    }
+
+    private final int capacity;
+    private final Overflow overflow;
+    private final BlockingQueue<Task> queue;
+    private final AtomicLong rejected = new AtomicLong();
+    private volatile Thread thread;
+    private volatile PolyglotEngine engine;
+    private volatile boolean shutdown;
+    private volatile boolean terminated;
+    private long completed;
+
+    /**
+     * Creates new executor. The engine thread is started with the first submitted task.
+     *
+     * @param capacity maximum number of tasks waiting for execution
+     * @param overflow policy to use when the queue is full
+     */
+    public EngineExecutor(int capacity, Overflow overflow) {
+        if (capacity <= 0) {
+            throw new IllegalArgumentException("Capacity must be positive: " + capacity);
+        }
+        overflow.getClass();
+        this.capacity = capacity;
+        this.overflow = overflow;
+        this.queue = new ArrayBlockingQueue<>(capacity);
+    }
+
+    public int getCapacity() {
+        return capacity;
+    }
+
+    public Overflow getOverflow() {
+        return overflow;
+    }
+
+    /**
+     * Number of tasks currently waiting for execution.
+     */
+    public int getQueueDepth() {
+        return queue.size();
+    }
+
+    /**
+     * Number of tasks rejected so far because the queue was full.
+     */
+    public long getRejectedCount() {
+        return rejected.get();
+    }
+
+    @Override
+    public void execute(Runnable command) {
+        command.getClass();
+        if (Thread.currentThread() == thread) {
+            command.run();
+            return;
+        }
+        if (shutdown) {
+            throw new RejectedExecutionException("Executor has been shut down");
+        }
+        ensureStarted();
+        Task task = new Task(command, System.nanoTime());
+        switch (overflow) {
+            case BLOCK:
+                try {
+                    queue.put(task);
+                } catch (InterruptedException ex) {
+                    Thread.currentThread().interrupt();
+                    throw new RejectedExecutionException(ex);
+                }
+                break;
+            case REJECT:
+                if (!queue.offer(task)) {
+                    rejected.incrementAndGet();
+                    throw new RejectedExecutionException("Queue is full: " + capacity + " tasks pending");
+                }
+                break;
+            default:
+                throw new IllegalStateException();
+        }
+        if (terminated && queue.remove(task)) {
+            throw new RejectedExecutionException("Executor has been shut down");
+        }
+    }
+
+    /**
+     * Stops accepting new tasks. Already submitted tasks are still executed, then the engine thread
+     * terminates.
+     */
+    public void shutdown() {
+        shutdown = true;
+        if (thread != null) {
+            // wake up the engine thread, if the queue is full it is not waiting anyway
+            queue.offer(new Task(null, System.nanoTime()));
+        }
+    }
+
+    synchronized void attach(PolyglotEngine newEngine) {
+        if (engine != null) {
+            throw new IllegalStateException("Executor is already used by " + engine);
+        }
+        engine = newEngine;
+    }
+
+    private synchronized void ensureStarted() {
+        if (thread == null) {
+            Thread t = new Thread(new Runnable() {
+                public void run() {
+                    processTasks();
+                }
+            }, "PolyglotEngine Executor");
+            t.setDaemon(true);
+            thread = t;
+            t.start();
+        }
+    }
+
+    private void processTasks() {
+        List<Task> batch = new ArrayList<>();
+        while (!shutdown || !queue.isEmpty()) {
+            try {
+                batch.add(queue.take());
+            } catch (InterruptedException ex) {
+                continue;
+            }
+            queue.drainTo(batch);
+            runBatch(batch);
+            batch.clear();
+        }
+        terminated = true;
+        queue.drainTo(batch);
+        runBatch(batch);
+    }
+
+    private void runBatch(List<Task> batch) {
+        long start = System.nanoTime();
+        long maxWait = 0;
+        long totalWait = 0;
+        int size = 0;
+        for (Task task : batch) {
+            if (task.command == null) {
+                continue;
+            }
+            long wait = start - task.submitted;
+            maxWait = Math.max(maxWait, wait);
+            totalWait += wait;
+            size++;
+            try {
+                task.command.run();
+            } catch (RuntimeException | Error ex) {
+                PolyglotEngine.LOG.log(Level.SEVERE, "Error running " + task.command, ex);
+            }
+        }
+        if (size == 0) {
+            return;
+        }
+        completed += size;
+        PolyglotEngine e = engine;
+        if (e != null) {
+            BatchEvent event = new BatchEvent(size, queue.size(), maxWait, totalWait, System.nanoTime() - start, completed, rejected.get());
+            try {
+                e.dispatch(BatchEvent.class, event);
+            } catch (RuntimeException | Error ex) {
+                PolyglotEngine.LOG.log(Level.SEVERE, "Error delivering " + event, ex);
+            }
+        }
+    }
+
+    private static final class Task {
+        final Runnable command;
+        final long submitted;
+
+        Task(Runnable command, long submitted) {
+            this.command = command;
+            this.submitted = submitted;
+        }
+    }
+
+    /**
+     * Statistics about one batch of tasks run by an {@link EngineExecutor}. The event is delivered
+     * on the engine thread after the batch completes. Register an
+     * {@link EventConsumer EventConsumer&lt;BatchEvent&gt;} to observe queue depth and wait times.
+     */
+    public static final class BatchEvent {
+        private final int batchSize;
+        private final int queueDepth;
+        private final long maxWaitNanos;
+        private final long totalWaitNanos;
+        private final long executionNanos;
+        private final long completedTasks;
+        private final long rejectedTasks;
+
+        BatchEvent(int batchSize, int queueDepth, long maxWaitNanos, long totalWaitNanos, long executionNanos, long completedTasks, long rejectedTasks) {
+            this.batchSize = batchSize;
+            this.queueDepth = queueDepth;
+            this.maxWaitNanos = maxWaitNanos;
+            this.totalWaitNanos = totalWaitNanos;
+            this.executionNanos = executionNanos;
+            this.completedTasks = completedTasks;
+            this.rejectedTasks = rejectedTasks;
+        }
+
+        /** Number of tasks run in this batch. */
+        public int getBatchSize() {
+            return batchSize;
+        }
+
+        /** Number of tasks that were waiting in the queue when the batch completed. */
+        public int getQueueDepth() {
+            return queueDepth;
+        }
+
+        /** Longest time a task of this batch waited in the queue, in nanoseconds. */
+        public long getMaxWaitNanos() {
+            return maxWaitNanos;
+        }
+
+        /** Sum of the times the tasks of this batch waited in the queue, in nanoseconds. */
+        public long getTotalWaitNanos() {
+            return totalWaitNanos;
+        }
+
+        /** Time it took to run all tasks of this batch, in nanoseconds. */
+        public long getExecutionNanos() {
+            return executionNanos;
+        }
+
+        /** Number of tasks completed by the executor so far, including this batch. */
+        public long getCompletedTasks() {
+            return completedTasks;
+        }
+
+        /** Number of tasks rejected by the executor so far. */
+        public long getRejectedTasks() {
+            return rejectedTasks;
+        }
+
+        @Override
+        public String toString() {
+            return "BatchEvent[size=" + batchSize + ", queueDepth=" + queueDepth + ", maxWait=" + maxWaitNanos + "ns, totalWait=" + totalWaitNanos + "ns, execution=" + executionNanos + "ns]";
+        }
+    }
+}
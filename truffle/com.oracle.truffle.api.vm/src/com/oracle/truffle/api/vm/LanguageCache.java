@@ -151,14 +151,16 @@ final class LanguageCache {
         if (PRELOAD) {
             return language;
         }
-        if (create) {
-            try {
-                language = LanguageCache.find(className, loader());
-            } catch (Exception ex) {
-                throw new IllegalStateException("Cannot initialize " + getName() + " language with implementation " + className, ex);
+        synchronized (this) {
+            if (create) {
+                try {
+                    language = LanguageCache.find(className, loader());
+                } catch (Exception ex) {
+                    throw new IllegalStateException("Cannot initialize " + getName() + " language with implementation " + className, ex);
+                }
             }
+            return language;
         }
-        return language;
     }
 
 }
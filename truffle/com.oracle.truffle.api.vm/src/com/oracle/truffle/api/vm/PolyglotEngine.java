@@ -114,6 +114,7 @@ public class PolyglotEngine {
     private final Map<String, Object> globals;
     private final Instrumenter instrumenter;
     private final Debugger debugger;
+    private final boolean contextPerThread;
     private boolean disposed;
 
     /**
@@ -130,18 +131,23 @@ public class PolyglotEngine {
         this.executor = null;
         this.instrumenter = null;
         this.debugger = null;
+        this.contextPerThread = false;
     }
 
     /**
      * Real constructor used from the builder.
      */
-    PolyglotEngine(Executor executor, Map<String, Object> globals, OutputStream out, OutputStream err, InputStream in, EventConsumer<?>[] handlers) {
+    PolyglotEngine(Executor executor, Map<String, Object> globals, OutputStream out, OutputStream err, InputStream in, EventConsumer<?>[] handlers, boolean contextPerThread) {
         this.executor = executor;
+        this.contextPerThread = contextPerThread;
         this.out = out;
         this.err = err;
         this.in = in;
         this.handlers = handlers;
         this.initThread = Thread.currentThread();
+        if (executor instanceof EngineExecutor) {
+            ((EngineExecutor) executor).attach(this);
+        }
         this.globals = new HashMap<>(globals);
         this.instrumenter = SPI.createInstrumenter(this);
         this.debugger = SPI.createDebugger(this, this.instrumenter);
@@ -211,6 +217,7 @@ public class PolyglotEngine {
         private final List<EventConsumer<?>> handlers = new ArrayList<>();
         private final Map<String, Object> globals = new HashMap<>();
         private Executor executor;
+        private boolean contextPerThread;
 
         Builder() {
         }
@@ -306,7 +313,8 @@ public class PolyglotEngine {
          * {@link #executor(java.util.concurrent.Executor) the builder}. The executor is expected to
          * execute all {@link Runnable runnables} passed into its
          * {@link Executor#execute(java.lang.Runnable)} method in the order they arrive and in a
-         * single (yet arbitrary) thread.
+         * single (yet arbitrary) thread. {@link EngineExecutor} is a built-in implementation that
+         * runs the tasks in batches on a dedicated thread and limits the number of pending tasks.
          *
          * @param executor the executor to use for internal execution inside the {@link #build() to
          *            be created} {@link PolyglotEngine}
@@ -318,6 +326,25 @@ public class PolyglotEngine {
             return this;
         }
 
+        /**
+         * Enables a separate language context for each thread using the {@link #build() to be
+         * created} {@link PolyglotEngine}. By default an engine can only be used by the thread
+         * that created it. With contexts per thread any thread can evaluate code in the engine:
+         * each thread gets its own context
+         * {@link TruffleLanguage#createContext(com.oracle.truffle.api.TruffleLanguage.Env) created}
+         * when it first uses a language, while the code parsed from a {@link Source} is cached by
+         * the engine and shared by all threads. Values obtained by one thread should not be used
+         * by other threads. The {@link Debugger} only observes executions in the thread that
+         * created the engine.
+         *
+         * @param enabled <code>true</code> to create a context for each thread
+         * @return instance of this builder
+         */
+        public Builder contextPerThread(boolean enabled) {
+            this.contextPerThread = enabled;
+            return this;
+        }
+
         /**
          * Creates the {@link PolyglotEngine Truffle virtual machine}. The configuration is taken
          * from values passed into configuration methods in this class.
@@ -334,7 +361,7 @@ public class PolyglotEngine {
             if (in == null) {
                 in = System.in;
             }
-            return new PolyglotEngine(executor, globals, out, err, in, handlers.toArray(new EventConsumer[0]));
+            return new PolyglotEngine(executor, globals, out, err, in, handlers.toArray(new EventConsumer[0]), contextPerThread);
         }
     }
 
@@ -385,10 +412,12 @@ public class PolyglotEngine {
                 for (Language language : getLanguages().values()) {
                     TruffleLanguage<?> impl = language.getImpl(false);
                     if (impl != null) {
-                        try {
-                            SPI.dispose(impl, language.getEnv(true));
-                        } catch (Exception | Error ex) {
-                            LOG.log(Level.SEVERE, "Error disposing " + impl, ex);
+                        for (TruffleLanguage.Env env : language.getEnvs()) {
+                            try {
+                                SPI.dispose(impl, env);
+                            } catch (Exception | Error ex) {
+                                LOG.log(Level.SEVERE, "Error disposing " + impl, ex);
+                            }
                         }
                     }
                 }
@@ -400,6 +429,9 @@ public class PolyglotEngine {
         } catch (IOException ex) {
             throw new IllegalStateException(ex);
         }
+        if (executor instanceof EngineExecutor) {
+            ((EngineExecutor) executor).shutdown();
+        }
     }
 
     private Value eval(final Language l, final Source s) throws IOException {
@@ -528,7 +560,7 @@ public class PolyglotEngine {
     }
 
     private void checkThread() {
-        if (initThread != Thread.currentThread()) {
+        if (!contextPerThread && initThread != Thread.currentThread()) {
             throw new IllegalStateException("PolyglotEngine created on " + initThread.getName() + " but used on " + Thread.currentThread().getName());
         }
         if (disposed) {
@@ -740,10 +772,19 @@ public class PolyglotEngine {
         private final Map<Source, CallTarget> cache;
         private final LanguageCache info;
         private TruffleLanguage.Env env;
+        private final ThreadLocal<TruffleLanguage.Env> threadEnv;
+        private final List<TruffleLanguage.Env> threadEnvs;
 
         Language(LanguageCache info) {
-            this.cache = new WeakHashMap<>();
+            this.cache = Collections.synchronizedMap(new WeakHashMap<Source, CallTarget>());
             this.info = info;
+            if (contextPerThread) {
+                this.threadEnv = new ThreadLocal<>();
+                this.threadEnvs = new ArrayList<>();
+            } else {
+                this.threadEnv = null;
+                this.threadEnvs = null;
+            }
         }
 
         /**
@@ -809,12 +850,32 @@ public class PolyglotEngine {
         }
 
         TruffleLanguage.Env getEnv(boolean create) {
+            if (threadEnv != null) {
+                TruffleLanguage.Env current = threadEnv.get();
+                if (current == null && create) {
+                    current = SPI.attachEnv(PolyglotEngine.this, info.getImpl(true), out, err, in, instrumenter);
+                    threadEnv.set(current);
+                    synchronized (threadEnvs) {
+                        threadEnvs.add(current);
+                    }
+                }
+                return current;
+            }
             if (env == null && create) {
                 env = SPI.attachEnv(PolyglotEngine.this, info.getImpl(true), out, err, in, instrumenter);
             }
             return env;
         }
 
+        List<TruffleLanguage.Env> getEnvs() {
+            if (threadEnvs != null) {
+                synchronized (threadEnvs) {
+                    return new ArrayList<>(threadEnvs);
+                }
+            }
+            return Collections.singletonList(getEnv(true));
+        }
+
         @Override
         public String toString() {
             return "[" + getName() + "@ " + getVersion() + " for " + getMimeTypes() + "]";
@@ -852,6 +913,10 @@ public class PolyglotEngine {
         for (Map.Entry<String, Language> entrySet : langs.entrySet()) {
             Language languageDescription = entrySet.getValue();
             Env env = languageDescription.getEnv(false);
+            if (env == null && contextPerThread && languageClazz.isInstance(languageDescription.getImpl(false))) {
+                // language already used by another thread
+                env = languageDescription.getEnv(true);
+            }
             if (env != null && languageClazz.isInstance(languageDescription.getImpl(false))) {
                 return env;
             }
@@ -960,9 +1025,19 @@ public class PolyglotEngine {
         @Override
         protected Closeable executionStart(Object obj, int currentDepth, Debugger debugger, Source s) {
             PolyglotEngine vm = (PolyglotEngine) obj;
+            if (vm.contextPerThread && vm.initThread != Thread.currentThread()) {
+                // the debugger observes only the thread that created the engine
+                return super.executionStart(vm, -1, null, s);
+            }
             return super.executionStart(vm, -1, debugger, s);
         }
 
+        @Override
+        protected boolean isContextPerThread(Object obj) {
+            PolyglotEngine vm = (PolyglotEngine) obj;
+            return vm.contextPerThread;
+        }
+
         @Override
         protected void dispatchEvent(Object obj, Object event) {
             PolyglotEngine vm = (PolyglotEngine) obj;
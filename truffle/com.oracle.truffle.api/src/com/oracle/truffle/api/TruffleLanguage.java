@@ -24,6 +24,11 @@
  */
 package com.oracle.truffle.api;
 
+import java.io.BufferedInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
 import java.io.OutputStream;
@@ -31,6 +36,10 @@ import java.lang.annotation.ElementType;
 import java.lang.annotation.Retention;
 import java.lang.annotation.RetentionPolicy;
 import java.lang.annotation.Target;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.Map;
 import java.util.Objects;
 
@@ -48,6 +57,8 @@ import com.oracle.truffle.api.instrument.Visualizer;
 import com.oracle.truffle.api.instrument.WrapperNode;
 import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.nodes.serial.NodeDeserializer;
+import com.oracle.truffle.api.nodes.serial.NodeSerializer;
 import com.oracle.truffle.api.source.Source;
 
 /**
@@ -179,6 +190,40 @@ public abstract class TruffleLanguage<C> {
      */
     protected abstract CallTarget parse(Source code, Node context, String... argumentNames) throws IOException;
 
+    /**
+     * Parses the provided source into root nodes that can be
+     * {@linkplain com.oracle.truffle.api.nodes.serial.NodeSerializer serialized} and later be turned
+     * into a call target by {@link #load(Source, List)}, possibly in another process. Unlike
+     * {@link #parse(Source, Node, String...)} this method must not create call targets, so that
+     * the returned ASTs are exactly as parsed. The default implementation returns <code>null</code>
+     * to indicate that the language does not support pre-built ASTs.
+     * <p>
+     * If {@link TruffleOptions#PrebuiltASTs} names a directory, evaluating a source stores the
+     * returned ASTs there, and evaluating a source with the same content later
+     * {@link #load(Source, List) loads} them instead of parsing the source.
+     *
+     * @param code source code to parse
+     * @return the root nodes of the source or <code>null</code>
+     * @throws IOException thrown when I/O or parsing goes wrong
+     */
+    protected List<? extends RootNode> prebuild(Source code) throws IOException {
+        return null;
+    }
+
+    /**
+     * Creates the call target for root nodes returned by {@link #prebuild(Source)}, possibly after
+     * they were serialized and deserialized. The call target must behave as the one returned by
+     * {@link #parse(Source, Node, String...) parse(code, null)}. Only called for languages that
+     * support pre-built ASTs.
+     *
+     * @param code the source the root nodes were parsed from
+     * @param roots the root nodes in the order returned by {@link #prebuild(Source)}
+     * @return a call target to invoke which also keeps the given root nodes in memory
+     */
+    protected CallTarget load(Source code, List<RootNode> roots) {
+        throw new UnsupportedOperationException();
+    }
+
     /**
      * Called when some other language is seeking for a global symbol. This method is supposed to do
      * lazy binding, e.g. there is no need to export symbols in advance, it is fine to wait until
@@ -461,13 +506,16 @@ public abstract class TruffleLanguage<C> {
 
         @Override
         protected Object eval(TruffleLanguage<?> language, Source source, Map<Source, CallTarget> cache) throws IOException {
-            CallTarget target = cache.get(source);
-            if (target == null) {
-                target = language.parse(source, null);
+            CallTarget target;
+            synchronized (cache) {
+                target = cache.get(source);
                 if (target == null) {
-                    throw new IOException("Parsing has not produced a CallTarget for " + source);
+                    target = TruffleOptions.PrebuiltASTs == null ? language.parse(source, null) : parsePrebuilt(language, source);
+                    if (target == null) {
+                        throw new IOException("Parsing has not produced a CallTarget for " + source);
+                    }
+                    cache.put(source, target);
                 }
-                cache.put(source, target);
             }
             try {
                 return target.call();
@@ -478,6 +526,57 @@ public abstract class TruffleLanguage<C> {
             }
         }
 
+        private static CallTarget parsePrebuilt(TruffleLanguage<?> language, Source source) throws IOException {
+            // sources with the same content may be evaluated by different languages
+            File file = new File(TruffleOptions.PrebuiltASTs, language.getClass().getName() + "-" + NodeSerializer.getContentHash(source) + ".ast");
+            if (file.isFile()) {
+                try (InputStream in = new BufferedInputStream(new FileInputStream(file))) {
+                    return language.load(source, NodeDeserializer.read(source, in, language.getClass().getClassLoader()));
+                } catch (IOException | RuntimeException e) {
+                    // stale, unreadable or written by another version of the language: parse again
+                }
+            }
+            List<? extends RootNode> prebuilt = language.prebuild(source);
+            if (prebuilt == null) {
+                return language.parse(source, null);
+            }
+            List<RootNode> roots = new ArrayList<>(prebuilt);
+            ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+            try {
+                NodeSerializer.write(source, roots, bytes);
+            } catch (IOException e) {
+                // the ASTs hold values that cannot be serialized
+                bytes = null;
+            }
+            if (bytes != null) {
+                writePrebuilt(file, bytes);
+            }
+            return language.load(source, roots);
+        }
+
+        /**
+         * Writes to a temporary file that is renamed when complete, so concurrent readers never
+         * see a partially written file.
+         */
+        private static void writePrebuilt(File file, ByteArrayOutputStream bytes) {
+            File temp = null;
+            try {
+                file.getParentFile().mkdirs();
+                temp = File.createTempFile(file.getName(), ".tmp", file.getParentFile());
+                try (OutputStream out = new FileOutputStream(temp)) {
+                    bytes.writeTo(out);
+                }
+                Files.move(temp.toPath(), file.toPath(), StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+                temp = null;
+            } catch (IOException e) {
+                // the directory is not writable, load the ASTs anyway
+            } finally {
+                if (temp != null) {
+                    temp.delete();
+                }
+            }
+        }
+
         @Override
         protected Object evalInContext(Object vm, SuspendedEvent ev, String code, Node node, MaterializedFrame frame) throws IOException {
             RootNode rootNode = node.getRootNode();
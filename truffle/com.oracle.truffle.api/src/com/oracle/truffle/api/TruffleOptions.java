@@ -85,6 +85,39 @@ public final class TruffleOptions {
      */
     public static final boolean TraceASTJSON;
 
+    /**
+     * Enables the aggregation of node rewrites by site in a
+     * {@link com.oracle.truffle.api.nodes.RewriteProfiler}, which is printed at shutdown.
+     * <p>
+     * Can be set with {@code -Dtruffle.ProfileRewrites=true}.
+     */
+    public static final boolean ProfileRewrites;
+
+    /**
+     * Limits the rewrite profile printed at shutdown to the sites with the most rewrites.
+     * <p>
+     * Can be set with {@code -Dtruffle.ProfileRewritesTopResults=n}.
+     */
+    public static final int ProfileRewritesTopResults;
+
+    /**
+     * Names a directory in which serialized ASTs of evaluated sources are stored and looked up by
+     * language and content hash, for languages that support {@link TruffleLanguage#prebuild
+     * pre-built ASTs}.
+     * <p>
+     * Can be set with {@code -Dtruffle.PrebuiltASTs=directory}.
+     */
+    public static final String PrebuiltASTs;
+
+    /**
+     * Registers every call target so that {@link TruffleRuntime#getCallTargets()} can enumerate
+     * them. Tools such as debuggers and profilers need this; production deployments that do not
+     * use them can disable it.
+     * <p>
+     * Can be set with {@code -Dtruffle.TrackCallTargets=false}.
+     */
+    public static final boolean TrackCallTargets;
+
     /**
      * Forces ahead-of-time initialization.
      */
@@ -99,8 +132,8 @@ public final class TruffleOptions {
     }
 
     static {
-        final boolean[] values = new boolean[4];
-        final Object[] objs = new Object[3];
+        final boolean[] values = new boolean[6];
+        final Object[] objs = new Object[5];
         AccessController.doPrivileged(new PrivilegedAction<Void>() {
             public Void run() {
                 values[0] = Boolean.getBoolean("truffle.TraceRewrites");
@@ -110,6 +143,10 @@ public final class TruffleOptions {
                 values[1] = Boolean.getBoolean("truffle.DetailedRewriteReasons");
                 values[2] = Boolean.getBoolean("truffle.TraceASTJSON");
                 values[3] = Boolean.getBoolean("com.oracle.truffle.aot");
+                values[4] = Boolean.getBoolean("truffle.ProfileRewrites");
+                values[5] = Boolean.parseBoolean(System.getProperty("truffle.TrackCallTargets", "true"));
+                objs[3] = Integer.getInteger("truffle.ProfileRewritesTopResults", Integer.MAX_VALUE);
+                objs[4] = System.getProperty("truffle.PrebuiltASTs");
                 return null;
             }
         });
@@ -117,8 +154,12 @@ public final class TruffleOptions {
         DetailedRewriteReasons = values[1];
         TraceASTJSON = values[2];
         AOT = values[3];
+        ProfileRewrites = values[4];
+        TrackCallTargets = values[5];
+        ProfileRewritesTopResults = (Integer) objs[3];
         TraceRewritesFilterClass = (String) objs[0];
         TraceRewritesFilterFromCost = (NodeCost) objs[1];
         TraceRewritesFilterToCost = (NodeCost) objs[2];
+        PrebuiltASTs = (String) objs[4];
     }
 }
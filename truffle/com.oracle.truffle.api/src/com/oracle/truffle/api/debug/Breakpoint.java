@@ -149,6 +149,17 @@ public abstract class Breakpoint {
         return null;
     }
 
+    /**
+     * Gets the expression that this breakpoint evaluates and logs when it is reached;
+     * {@code null} unless this breakpoint is a <em>logpoint</em>, which never halts execution.
+     *
+     * @see Debugger#setLineLogpoint(int, com.oracle.truffle.api.source.LineLocation, String,
+     *      Appendable)
+     */
+    public Source getLogExpression() {
+        return null;
+    }
+
     /**
      * Does this breakpoint remove itself after first activation?
      */
@@ -31,6 +31,7 @@ import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
 import java.util.List;
+import java.util.concurrent.atomic.AtomicLong;
 
 import com.oracle.truffle.api.CompilerDirectives.TruffleBoundary;
 import com.oracle.truffle.api.Truffle;
@@ -38,6 +39,7 @@ import com.oracle.truffle.api.TruffleLanguage;
 import com.oracle.truffle.api.frame.FrameInstance;
 import com.oracle.truffle.api.frame.FrameInstanceVisitor;
 import com.oracle.truffle.api.frame.MaterializedFrame;
+import com.oracle.truffle.api.frame.StackDepth;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.frame.FrameInstance.FrameAccess;
 import com.oracle.truffle.api.impl.Accessor;
@@ -71,6 +73,13 @@ public final class Debugger {
     private static final SyntaxTag STEPPING_TAG = StandardSyntaxTag.STATEMENT;
     private static final SyntaxTag CALL_TAG = StandardSyntaxTag.CALL;
 
+    /*
+     * Statistics of the stack depth queries while stepping, for tests that check the cost of a
+     * step independently of timing.
+     */
+    private static final AtomicLong stackDepthQueries = new AtomicLong();
+    private static final AtomicLong stackDepthFramesWalked = new AtomicLong();
+
     private static void trace(String format, Object... args) {
         if (TRACE) {
             OUT.println(TRACE_PREFIX + String.format(format, args));
@@ -159,6 +168,26 @@ public final class Debugger {
         return lineBreaks.create(ignoreCount, lineLocation, oneShot);
     }
 
+    /**
+     * Sets a <em>logpoint</em> at a source line: a breakpoint that never halts. Each time execution
+     * reaches the line, the expression is evaluated in the lexical context of the line and its
+     * value is appended to the sink, followed by a newline. The expression is parsed once per
+     * location, so a logpoint can observe a running program at low overhead. The sink is invoked
+     * on the executing thread and should be buffered, e.g. a {@link StringBuilder} or a
+     * {@link java.io.BufferedWriter}.
+     *
+     * @param ignoreCount number of hits to ignore before logging
+     * @param lineLocation where to set the logpoint (source, line number)
+     * @param expression the guest language expression to log
+     * @param sink receives the logged values
+     * @return a new logpoint, initially enabled
+     * @throws IOException if a breakpoint is already set at the location
+     */
+    @TruffleBoundary
+    public Breakpoint setLineLogpoint(int ignoreCount, LineLocation lineLocation, String expression, Appendable sink) throws IOException {
+        return lineBreaks.createLogpoint(ignoreCount, lineLocation, expression, sink);
+    }
+
     /**
      * Sets a breakpoint to halt at any node holding a specified {@link SyntaxTag}.
      *
@@ -848,23 +877,32 @@ public final class Debugger {
         }
     }
 
-    // TODO (mlvdv) wish there were fast-path access to stack depth
     /**
      * Depth of current Truffle stack, including nested executions. Includes the top/current frame,
-     * which the standard iterator does not count: {@code 0} if no executions.
+     * which the standard iterator does not count: {@code 0} if no executions. Stepping strategies
+     * query the depth on every statement, so it relies on the {@link StackDepth} capability of the
+     * runtime if it offers one, and iterates the frames otherwise.
      */
     @TruffleBoundary
     private static int currentStackDepth() {
-        final int[] count = {0};
-        Truffle.getRuntime().iterateFrames(new FrameInstanceVisitor<Void>() {
-            @Override
-            public Void visitFrame(FrameInstance frameInstance) {
-                count[0] = count[0] + 1;
-                return null;
-            }
-        });
-        return count[0] == 0 ? 0 : count[0] + 1;
-
+        stackDepthQueries.incrementAndGet();
+        final StackDepth stackDepth = Truffle.getRuntime().getCapability(StackDepth.class);
+        final int count;
+        if (stackDepth != null) {
+            count = stackDepth.getStackDepth();
+        } else {
+            final int[] counter = {0};
+            Truffle.getRuntime().iterateFrames(new FrameInstanceVisitor<Void>() {
+                @Override
+                public Void visitFrame(FrameInstance frameInstance) {
+                    counter[0] = counter[0] + 1;
+                    return null;
+                }
+            });
+            count = counter[0];
+            stackDepthFramesWalked.addAndGet(count);
+        }
+        return count == 0 ? 0 : count + 1;
     }
 
     void executionStarted(int depth, Source source) {
@@ -120,12 +120,6 @@ final class LineBreakpointFactory {
      */
     private final Map<LineLocation, LineBreakpointImpl> lineToBreakpoint = new HashMap<>();
 
-    /**
-     * A map of {@link LineLocation} to a collection of {@link Probe}s. This list must be
-     * initialized and filled prior to being used by this class.
-     */
-    private final LineToProbesMap lineToProbesMap;
-
     /**
      * Globally suspends all line breakpoint activity when {@code false}, ignoring whether
      * individual breakpoints are enabled.
@@ -139,9 +133,6 @@ final class LineBreakpointFactory {
         this.warningLog = warningLog;
 
         final Instrumenter instrumenter = debugger.getInstrumenter();
-        this.lineToProbesMap = new LineToProbesMap();
-        instrumenter.install(lineToProbesMap);
-
         instrumenter.addProbeListener(new DefaultProbeListener() {
 
             @Override
@@ -215,7 +206,7 @@ final class LineBreakpointFactory {
 
             lineToBreakpoint.put(lineLocation, breakpoint);
 
-            for (Probe probe : lineToProbesMap.findProbes(lineLocation)) {
+            for (Probe probe : debugger.getInstrumenter().findProbesStartingOn(lineLocation)) {
                 if (probe.isTaggedAs(StandardSyntaxTag.STATEMENT)) {
                     breakpoint.attach(probe);
                     break;
@@ -233,6 +224,34 @@ final class LineBreakpointFactory {
         return breakpoint;
     }
 
+    /**
+     * Creates a new line logpoint, which logs the value of an expression instead of halting.
+     *
+     * @param ignoreCount number of initial hits before the logpoint starts logging
+     * @param lineLocation where to set the logpoint
+     * @param expression the expression to evaluate and log
+     * @param sink receives the logged values
+     * @return a new logpoint
+     * @throws IOException if a breakpoint already exists at the location
+     */
+    LineBreakpoint createLogpoint(int ignoreCount, LineLocation lineLocation, String expression, Appendable sink) throws IOException {
+        if (lineToBreakpoint.containsKey(lineLocation)) {
+            throw new IOException(BREAKPOINT_NAME + " already set at line " + lineLocation);
+        }
+        final LineBreakpointImpl logpoint = new LineBreakpointImpl(ignoreCount, lineLocation, false, Source.fromText(expression, "logpoint expression from text: " + expression), sink);
+        if (TRACE) {
+            trace("NEW " + logpoint.getShortDescription());
+        }
+        lineToBreakpoint.put(lineLocation, logpoint);
+        for (Probe probe : debugger.getInstrumenter().findProbesStartingOn(lineLocation)) {
+            if (probe.isTaggedAs(StandardSyntaxTag.STATEMENT)) {
+                logpoint.attach(probe);
+                break;
+            }
+        }
+        return logpoint;
+    }
+
     /**
      * Returns the {@link LineBreakpoint} for a given line. There should only ever be one breakpoint
      * per line.
@@ -282,6 +301,13 @@ final class LineBreakpointFactory {
 
         private Source conditionSource;
 
+        /**
+         * For logpoints: the expression whose value is logged instead of halting, and the sink it
+         * is logged to; both {@code null} for ordinary breakpoints.
+         */
+        private final Source logSource;
+        private final Appendable logSink;
+
         /**
          * The instrument(s) that this breakpoint currently has attached to a {@link Probe}:
          * {@code null} if not attached.
@@ -289,8 +315,14 @@ final class LineBreakpointFactory {
         private List<ProbeInstrument> instruments = new ArrayList<>();
 
         public LineBreakpointImpl(int ignoreCount, LineLocation lineLocation, boolean oneShot) {
+            this(ignoreCount, lineLocation, oneShot, null, null);
+        }
+
+        public LineBreakpointImpl(int ignoreCount, LineLocation lineLocation, boolean oneShot, Source logSource, Appendable logSink) {
             super(ENABLED_UNRESOLVED, ignoreCount, oneShot);
             this.lineLocation = lineLocation;
+            this.logSource = logSource;
+            this.logSink = logSink;
 
             this.breakpointsActiveAssumption = LineBreakpointFactory.this.breakpointsActiveUnchanged.getAssumption();
             this.isEnabled = true;
@@ -338,6 +370,9 @@ final class LineBreakpointFactory {
 
         @Override
         public void setCondition(String expr) throws IOException {
+            if (logSource != null) {
+                throw new UnsupportedOperationException("Logpoints do not support conditions");
+            }
             if (this.conditionSource != null || expr != null) {
                 // De-instrument the Probes instrumented by this breakpoint
                 final ArrayList<Probe> probes = new ArrayList<>();
@@ -359,6 +394,11 @@ final class LineBreakpointFactory {
             return conditionSource;
         }
 
+        @Override
+        public Source getLogExpression() {
+            return logSource;
+        }
+
         @TruffleBoundary
         @Override
         public void dispose() {
@@ -377,7 +417,9 @@ final class LineBreakpointFactory {
             }
             ProbeInstrument newInstrument = null;
             final Instrumenter instrumenter = debugger.getInstrumenter();
-            if (conditionSource == null) {
+            if (logSource != null) {
+                newInstrument = instrumenter.attach(newProbe, logSource, this, BREAKPOINT_NAME, null);
+            } else if (conditionSource == null) {
                 newInstrument = instrumenter.attach(newProbe, new UnconditionalLineBreakInstrumentListener(), BREAKPOINT_NAME);
             } else {
                 newInstrument = instrumenter.attach(newProbe, conditionSource, this, BREAKPOINT_NAME, null);
@@ -417,7 +459,24 @@ final class LineBreakpointFactory {
          * unconditional "halt" call to the debugger or nothing.
          */
         private void nodeEnter(Node astNode, VirtualFrame vFrame) {
+            if (isActive()) {
+                if (isOneShot()) {
+                    dispose();
+                }
+                LineBreakpointImpl.this.doBreak(astNode, vFrame);
+            }
+        }
 
+        /**
+         * Receives the value of the expression of a logpoint; never halts.
+         */
+        private void nodeLog(Object value) {
+            if (isActive() && incrHitCountCheckIgnore()) {
+                log(value);
+            }
+        }
+
+        private boolean isActive() {
             // Deopt if the global active/inactive flag has changed
             try {
                 this.breakpointsActiveAssumption.check();
@@ -432,16 +491,22 @@ final class LineBreakpointFactory {
                 this.enabledUnchangedAssumption = Truffle.getRuntime().createAssumption("LineBreakpoint enabled state unchanged");
             }
 
-            if (LineBreakpointFactory.this.breakpointsActive && this.isEnabled) {
-                if (isOneShot()) {
-                    dispose();
-                }
-                LineBreakpointImpl.this.doBreak(astNode, vFrame);
+            return LineBreakpointFactory.this.breakpointsActive && this.isEnabled;
+        }
+
+        @TruffleBoundary
+        private void log(Object value) {
+            try {
+                logSink.append(String.valueOf(value)).append('\n');
+            } catch (IOException ex) {
+                addExceptionWarning(ex);
             }
         }
 
         public void onExecution(Node node, VirtualFrame vFrame, Object result) {
-            if (result instanceof Boolean) {
+            if (logSink != null) {
+                nodeLog(result);
+            } else if (result instanceof Boolean) {
                 final boolean condition = (Boolean) result;
                 if (TRACE) {
                     trace("breakpoint condition = %b  %s", condition, getShortDescription());
@@ -459,8 +524,10 @@ final class LineBreakpointFactory {
             if (TRACE) {
                 trace("breakpoint failure = %s  %s", ex, getShortDescription());
             }
-            // Take the breakpoint if evaluation fails.
-            nodeEnter(node, vFrame);
+            if (logSink == null) {
+                // Take the breakpoint if evaluation fails.
+                nodeEnter(node, vFrame);
+            }
         }
 
         @TruffleBoundary
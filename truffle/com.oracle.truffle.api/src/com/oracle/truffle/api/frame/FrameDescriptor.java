@@ -43,6 +43,8 @@ public final class FrameDescriptor implements Cloneable {
     private final Object defaultValue;
     private final ArrayList<FrameSlot> slots;
     private final HashMap<Object, FrameSlot> identifierToSlotMap;
+    private final ArrayList<FrameSlot> parameterSlots;
+    private final List<FrameSlot> parameterSlotsView;
     private Assumption version;
     private HashMap<Object, Assumption> identifierToNotInFrameAssumptionMap;
 
@@ -65,6 +67,8 @@ public final class FrameDescriptor implements Cloneable {
         this.defaultValue = defaultValue;
         slots = new ArrayList<>();
         identifierToSlotMap = new HashMap<>();
+        parameterSlots = new ArrayList<>();
+        parameterSlotsView = Collections.unmodifiableList(parameterSlots);
         version = createVersion();
     }
 
@@ -210,11 +214,43 @@ public final class FrameDescriptor implements Cloneable {
             throw new IllegalArgumentException("no such frame slot: " + identifier);
         }
         slots.remove(identifierToSlotMap.get(identifier));
+        parameterSlots.remove(identifierToSlotMap.get(identifier));
         identifierToSlotMap.remove(identifier);
         updateVersion();
         getNotInFrameAssumption(identifier);
     }
 
+    /**
+     * Declares a slot of this descriptor as the next parameter of the root node that uses the
+     * descriptor. Callers that use
+     * {@linkplain com.oracle.truffle.api.nodes.DirectCallNode#createArgumentFrame(int) typed
+     * argument passing} store argument {@code i} of a call directly in parameter slot {@code i}.
+     * Other calls, and all calls on runtimes without typed calls, pass the arguments in
+     * {@link Frame#getArguments()} only and leave the parameter slots at the
+     * {@linkplain #getDefaultValue() default value}; the root node copies the arguments into the
+     * slots itself in that case. This is a slow operation.
+     *
+     * @param slot a slot of this descriptor
+     * @throws IllegalArgumentException if the slot belongs to another descriptor or is already a
+     *             parameter
+     */
+    public void addParameterSlot(FrameSlot slot) {
+        CompilerAsserts.neverPartOfCompilation(NEVER_PART_OF_COMPILATION_MESSAGE);
+        if (identifierToSlotMap.get(slot.getIdentifier()) != slot || parameterSlots.contains(slot)) {
+            throw new IllegalArgumentException("not a new parameter of this descriptor: " + slot);
+        }
+        parameterSlots.add(slot);
+    }
+
+    /**
+     * The slots declared as parameters, in the order of the arguments.
+     *
+     * @return unmodifiable list of {@link FrameSlot}
+     */
+    public List<? extends FrameSlot> getParameterSlots() {
+        return parameterSlotsView;
+    }
+
     /**
      * Returns number of slots in the descriptor.
      *
@@ -255,6 +291,9 @@ public final class FrameDescriptor implements Cloneable {
             FrameSlot slot = slots.get(i);
             clonedFrameDescriptor.addFrameSlot(slot.getIdentifier(), slot.getInfo(), FrameSlotKind.Illegal);
         }
+        for (FrameSlot parameter : parameterSlots) {
+            clonedFrameDescriptor.addParameterSlot(clonedFrameDescriptor.findFrameSlot(parameter.getIdentifier()));
+        }
         return clonedFrameDescriptor;
     }
 
@@ -269,6 +308,7 @@ public final class FrameDescriptor implements Cloneable {
         FrameDescriptor clonedFrameDescriptor = new FrameDescriptor(this.defaultValue);
         clonedFrameDescriptor.slots.addAll(slots);
         clonedFrameDescriptor.identifierToSlotMap.putAll(identifierToSlotMap);
+        clonedFrameDescriptor.parameterSlots.addAll(parameterSlots);
         return clonedFrameDescriptor;
     }
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.frame;
+
+import com.oracle.truffle.api.TruffleRuntime;
+
+/**
+ * A {@linkplain TruffleRuntime#getCapability(Class) capability} of runtimes that know the depth of
+ * the current stack without iterating its frames.
+ */
+public interface StackDepth {
+
+    /**
+     * Returns the number of frames that {@link TruffleRuntime#iterateFrames} would visit on the
+     * current thread, i.e., the depth of the current stack excluding the current frame. Unlike
+     * iterating the frames, this method is expected to run in constant time, so that it can be
+     * queried frequently, e.g., by a debugger on every executed statement.
+     *
+     * @return the number of caller frames of the current thread, {@code 0} if there are none
+     */
+    int getStackDepth();
+}
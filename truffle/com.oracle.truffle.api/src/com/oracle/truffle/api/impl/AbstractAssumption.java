@@ -25,11 +25,37 @@
 package com.oracle.truffle.api.impl;
 
 import com.oracle.truffle.api.Assumption;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.atomic.AtomicLong;
 
 public abstract class AbstractAssumption implements Assumption {
 
+    private static final String UNNAMED = "<unnamed>";
+    private static final ConcurrentMap<String, AtomicLong> INVALIDATION_COUNTS = new ConcurrentHashMap<>();
+
+    /** Listeners deferred by the {@link #invalidateAll(Collection)} running on this thread. */
+    private static final ThreadLocal<List<Runnable>> BATCH = new ThreadLocal<>();
+
     protected final String name;
-    protected boolean isValid;
+
+    /**
+     * Volatile so that an invalidation on one thread is observed by the next check on any other
+     * thread. Invalidation is rare, so the ordering costs nothing on the write side that matters.
+     */
+    protected volatile boolean isValid;
+
+    /** Actions to run on invalidation; guarded by this assumption. */
+    private List<Runnable> listeners;
+
+    /** Whether {@link #notifyInvalidated()} has run; guarded by this assumption. */
+    private boolean notified;
 
     protected AbstractAssumption(String name) {
         this.name = name;
@@ -41,6 +67,138 @@ public abstract class AbstractAssumption implements Assumption {
         return name;
     }
 
+    /**
+     * Registers an action to run once this assumption is invalidated, on the invalidating thread.
+     * If the assumption is already invalid, the action runs immediately.
+     */
+    public final void addInvalidationListener(Runnable listener) {
+        synchronized (this) {
+            if (isValid && !notified) {
+                if (listeners == null) {
+                    listeners = new ArrayList<>(2);
+                }
+                listeners.add(listener);
+                return;
+            }
+        }
+        listener.run();
+    }
+
+    /**
+     * Marks this assumption invalid and {@linkplain #notifyInvalidated() notifies} its listeners.
+     * Runtimes that override this method to invalidate dependent code must call
+     * {@link #notifyInvalidated()} once the assumption is invalid.
+     */
+    @Override
+    public void invalidate() {
+        isValid = false;
+        notifyInvalidated();
+    }
+
+    /**
+     * Counts the invalidation of this assumption under its name and runs its invalidation
+     * listeners. Only the first call has an effect. Subclasses that override {@link #invalidate()}
+     * must call this method after {@link #isValid} has become <code>false</code>; otherwise the
+     * listeners registered through {@link com.oracle.truffle.api.utilities.Assumptions} never run
+     * and the invalidation is not counted. During {@link #invalidateAll(Collection)} the listeners
+     * run only after all assumptions of the batch are invalid.
+     */
+    protected final void notifyInvalidated() {
+        List<Runnable> toRun = takeListeners();
+        if (toRun == null) {
+            return;
+        }
+        List<Runnable> batch = BATCH.get();
+        if (batch != null) {
+            batch.addAll(toRun);
+        } else {
+            runListeners(toRun);
+        }
+    }
+
+    /**
+     * Counts the invalidation under the name of this assumption and returns the listeners the
+     * caller has to {@linkplain #runListeners(List) run}, or <code>null</code> if the invalidation
+     * was already notified.
+     */
+    private synchronized List<Runnable> takeListeners() {
+        if (notified) {
+            return null;
+        }
+        notified = true;
+        String key = name == null ? UNNAMED : name;
+        AtomicLong count = INVALIDATION_COUNTS.get(key);
+        if (count == null) {
+            AtomicLong newCount = new AtomicLong();
+            count = INVALIDATION_COUNTS.putIfAbsent(key, newCount);
+            if (count == null) {
+                count = newCount;
+            }
+        }
+        count.incrementAndGet();
+        List<Runnable> result = listeners == null ? Collections.<Runnable> emptyList() : listeners;
+        listeners = null;
+        return result;
+    }
+
+    /**
+     * Runs invalidation listeners. All listeners run even if some fail; the first failure is
+     * rethrown afterwards.
+     */
+    private static void runListeners(List<Runnable> toRun) {
+        RuntimeException failure = null;
+        for (Runnable listener : toRun) {
+            try {
+                listener.run();
+            } catch (RuntimeException e) {
+                if (failure == null) {
+                    failure = e;
+                }
+            }
+        }
+        if (failure != null) {
+            throw failure;
+        }
+    }
+
+    /**
+     * Invalidates several assumptions at once. All of them are invalid before the first listener
+     * runs, so listeners never observe a partially invalidated set.
+     */
+    public static void invalidateAll(Collection<? extends Assumption> assumptions) {
+        List<Runnable> outerBatch = BATCH.get();
+        List<Runnable> toRun = new ArrayList<>();
+        BATCH.set(toRun);
+        try {
+            for (Assumption assumption : assumptions) {
+                assumption.invalidate();
+            }
+        } finally {
+            BATCH.set(outerBatch);
+        }
+        if (outerBatch != null) {
+            outerBatch.addAll(toRun);
+        } else {
+            runListeners(toRun);
+        }
+    }
+
+    /**
+     * Returns the number of invalidations of assumptions created by this runtime, by assumption
+     * name, sorted by name.
+     */
+    public static Map<String, Long> getInvalidationCounts() {
+        Map<String, Long> result = new TreeMap<>();
+        for (Map.Entry<String, AtomicLong> entry : INVALIDATION_COUNTS.entrySet()) {
+            result.put(entry.getKey(), entry.getValue().get());
+        }
+        return result;
+    }
+
+    public static void resetInvalidationCounts() {
+        INVALIDATION_COUNTS.clear();
+    }
+
     @Override
     public String toString() {
         return "Assumption(" + (isValid ? "valid" : "invalid") + ", name=" + name + ")";
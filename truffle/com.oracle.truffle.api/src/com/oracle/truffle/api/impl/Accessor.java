@@ -273,7 +273,7 @@ public abstract class Accessor {
     protected Closeable executionStart(Object vm, int currentDepth, Debugger debugger, Source s) {
         vm.getClass();
         final Object prev = CURRENT_VM.get();
-        final Closeable debugClose = DEBUG.executionStart(vm, prev == null ? 0 : -1, debugger, s);
+        final Closeable debugClose = debugger == null ? null : DEBUG.executionStart(vm, prev == null ? 0 : -1, debugger, s);
         if (!(vm == previousVM.get())) {
             previousVM = new WeakReference<>(vm);
             oneVM.invalidate();
@@ -286,7 +286,9 @@ public abstract class Accessor {
             @Override
             public void close() throws IOException {
                 CURRENT_VM.set(prev);
-                debugClose.close();
+                if (debugClose != null) {
+                    debugClose.close();
+                }
             }
         }
         return new ContextCloseable();
@@ -300,6 +302,15 @@ public abstract class Accessor {
         return oneVM;
     }
 
+    protected boolean isContextPerThread(Object vm) {
+        return SPI.isContextPerThread(vm);
+    }
+
+    static boolean isContextPerThread() {
+        Object vm = CURRENT_VM.get();
+        return vm != null && SPI.isContextPerThread(vm);
+    }
+
     @SuppressWarnings({"unchecked", "rawtypes"})
     static <C> C findContext(Class<? extends TruffleLanguage> type) {
         Env env = SPI.findLanguage(CURRENT_VM.get(), type);
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.impl;
+
+import com.oracle.truffle.api.RootCallTarget;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.WeakHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Weak set of the call targets created by a runtime. The set is split into stripes selected by
+ * identity hash, each guarded by its own lock, so that threads creating call targets rarely contend.
+ * Enumeration copies every stripe under its lock and returns the snapshot, which is safe to iterate
+ * while other threads keep registering targets.
+ */
+final class CallTargetRegistry {
+
+    private final boolean enabled;
+    private final Stripe[] stripes;
+    private final AtomicLong createdCount = new AtomicLong();
+
+    CallTargetRegistry(boolean enabled) {
+        this.enabled = enabled;
+        int count = Integer.highestOneBit(Runtime.getRuntime().availableProcessors()) << 2;
+        this.stripes = new Stripe[enabled ? count : 0];
+        for (int i = 0; i < stripes.length; i++) {
+            stripes[i] = new Stripe();
+        }
+    }
+
+    void register(RootCallTarget target) {
+        createdCount.incrementAndGet();
+        if (enabled) {
+            Stripe stripe = stripeFor(target);
+            synchronized (stripe) {
+                stripe.targets.put(target, null);
+            }
+        }
+    }
+
+    /** Returns the targets that are still referenced, or none if tracking is disabled. */
+    Collection<RootCallTarget> snapshot() {
+        List<RootCallTarget> result = new ArrayList<>();
+        for (Stripe stripe : stripes) {
+            synchronized (stripe) {
+                result.addAll(stripe.targets.keySet());
+            }
+        }
+        return Collections.unmodifiableList(result);
+    }
+
+    /** Returns the number of targets that are still referenced, or zero if tracking is disabled. */
+    int liveCount() {
+        int result = 0;
+        for (Stripe stripe : stripes) {
+            synchronized (stripe) {
+                result += stripe.targets.size();
+            }
+        }
+        return result;
+    }
+
+    long createdCount() {
+        return createdCount.get();
+    }
+
+    private Stripe stripeFor(Object target) {
+        int hash = System.identityHashCode(target);
+        return stripes[(hash ^ (hash >>> 16)) & (stripes.length - 1)];
+    }
+
+    private static final class Stripe {
+
+        final Map<RootCallTarget, Void> targets = new WeakHashMap<>();
+    }
+}
@@ -45,11 +45,6 @@ final class DefaultAssumption extends AbstractAssumption {
         }
     }
 
-    @Override
-    public void invalidate() {
-        isValid = false;
-    }
-
     @Override
     public boolean isValid() {
         return isValid;
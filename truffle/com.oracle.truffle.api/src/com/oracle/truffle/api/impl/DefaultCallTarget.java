@@ -25,10 +25,12 @@
 package com.oracle.truffle.api.impl;
 
 import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.LoopCountReceiver;
 import com.oracle.truffle.api.RootCallTarget;
 import com.oracle.truffle.api.Truffle;
 import com.oracle.truffle.api.TruffleRuntime;
 import com.oracle.truffle.api.frame.Frame;
+import com.oracle.truffle.api.frame.FrameDescriptor;
 import com.oracle.truffle.api.frame.FrameInstance;
 import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.RootNode;
@@ -37,9 +39,10 @@ import com.oracle.truffle.api.nodes.RootNode;
  * This is an implementation-specific class. Do not use or instantiate it. Instead, use
  * {@link TruffleRuntime#createCallTarget(RootNode)} to create a {@link RootCallTarget}.
  */
-public class DefaultCallTarget implements RootCallTarget {
+public class DefaultCallTarget implements RootCallTarget, LoopCountReceiver {
 
     private final RootNode rootNode;
+    private long loopCount;
 
     protected DefaultCallTarget(RootNode function) {
         this.rootNode = function;
@@ -59,6 +62,32 @@ public class DefaultCallTarget implements RootCallTarget {
     @Override
     public Object call(Object... args) {
         final DefaultVirtualFrame frame = new DefaultVirtualFrame(getRootNode().getFrameDescriptor(), args);
+        return callWithFrame(frame);
+    }
+
+    /**
+     * Creates an empty frame whose declared parameter slots a caller fills with the argument values
+     * directly, or returns <code>null</code> if the root node does not declare exactly
+     * <code>argumentCount</code> parameter slots.
+     */
+    final DefaultVirtualFrame createArgumentFrame(int argumentCount) {
+        final FrameDescriptor descriptor = rootNode.getFrameDescriptor();
+        if (descriptor.getParameterSlots().size() != argumentCount) {
+            return null;
+        }
+        return new DefaultVirtualFrame(descriptor, null);
+    }
+
+    /**
+     * Calls this target with a frame created by {@link #createArgumentFrame(int)} once the caller
+     * has written all parameter slots.
+     */
+    final Object callWithArgumentFrame(DefaultVirtualFrame frame) {
+        frame.sealParameters();
+        return callWithFrame(frame);
+    }
+
+    private Object callWithFrame(final DefaultVirtualFrame frame) {
         FrameInstance oldCurrentFrame = defaultTruffleRuntime().setCurrentFrame(new FrameInstance() {
 
             public Frame getFrame(FrameAccess access, boolean slowPath) {
@@ -87,6 +116,19 @@ public class DefaultCallTarget implements RootCallTarget {
         }
     }
 
+    @Override
+    public void reportLoopCount(int count) {
+        loopCount += count;
+    }
+
+    /**
+     * Returns the number of loop iterations that loops in the AST of this call target have
+     * reported so far.
+     */
+    public final long getLoopCount() {
+        return loopCount;
+    }
+
     private static DefaultTruffleRuntime defaultTruffleRuntime() {
         return (DefaultTruffleRuntime) Truffle.getRuntime();
     }
@@ -45,6 +45,34 @@ public final class DefaultDirectCallNode extends DirectCallNode {
 
     @Override
     public Object call(final VirtualFrame frame, Object[] arguments) {
+        pushCallerFrame(frame);
+        try {
+            return getCurrentCallTarget().call(arguments);
+        } finally {
+            defaultTruffleRuntime().popFrame();
+        }
+    }
+
+    @Override
+    public Frame createArgumentFrame(int argumentCount) {
+        final CallTarget target = getCurrentCallTarget();
+        if (target instanceof DefaultCallTarget) {
+            return ((DefaultCallTarget) target).createArgumentFrame(argumentCount);
+        }
+        return null;
+    }
+
+    @Override
+    public Object call(final VirtualFrame frame, Frame argumentFrame) {
+        pushCallerFrame(frame);
+        try {
+            return ((DefaultCallTarget) getCurrentCallTarget()).callWithArgumentFrame((DefaultVirtualFrame) argumentFrame);
+        } finally {
+            defaultTruffleRuntime().popFrame();
+        }
+    }
+
+    private void pushCallerFrame(final VirtualFrame frame) {
         final CallTarget currentCallTarget = defaultTruffleRuntime().getCurrentFrame().getCallTarget();
         FrameInstance frameInstance = new FrameInstance() {
 
@@ -65,11 +93,6 @@ public final class DefaultDirectCallNode extends DirectCallNode {
             }
         };
         defaultTruffleRuntime().pushFrame(frameInstance);
-        try {
-            return getCurrentCallTarget().call(arguments);
-        } finally {
-            defaultTruffleRuntime().popFrame();
-        }
     }
 
     @Override
@@ -24,12 +24,23 @@
  */
 package com.oracle.truffle.api.impl;
 
+import com.oracle.truffle.api.LoopCountReceiver;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.LoopNode;
 import com.oracle.truffle.api.nodes.RepeatingNode;
+import com.oracle.truffle.api.nodes.RootNode;
 
+/**
+ * Loop node of the {@link DefaultTruffleRuntime}. It counts iterations in a local variable and
+ * reports them to the {@link LoopCountReceiver} of the enclosing call target every
+ * {@link #REPORT_INTERVAL} iterations and when the loop exits, so that long running loops are
+ * visible while they run.
+ */
 public final class DefaultLoopNode extends LoopNode {
 
+    /** Number of iterations between loop count reports. */
+    static final int REPORT_INTERVAL = Integer.getInteger("truffle.LoopCountReportInterval", 1000);
+
     @Child private RepeatingNode repeatNode;
 
     public DefaultLoopNode(RepeatingNode repeatNode) {
@@ -43,8 +54,28 @@ public final class DefaultLoopNode extends LoopNode {
 
     @Override
     public void executeLoop(VirtualFrame frame) {
-        while (repeatNode.executeRepeating(frame)) {
-            // Empty
+        int iterations = 0;
+        try {
+            while (repeatNode.executeRepeating(frame)) {
+                if (++iterations >= REPORT_INTERVAL) {
+                    reportIterations(iterations);
+                    iterations = 0;
+                }
+            }
+        } finally {
+            reportIterations(iterations);
+        }
+    }
+
+    /**
+     * Reports loop iterations to the {@link RootNode#reportLoopCount(int) root node} of this loop.
+     */
+    private void reportIterations(int iterations) {
+        if (iterations > 0) {
+            RootNode rootNode = getRootNode();
+            if (rootNode != null) {
+                rootNode.reportLoopCount(iterations);
+            }
         }
     }
 }
@@ -27,13 +27,16 @@ package com.oracle.truffle.api.impl;
 import com.oracle.truffle.api.Assumption;
 import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.CompilerOptions;
+import com.oracle.truffle.api.LoopCounts;
 import com.oracle.truffle.api.RootCallTarget;
 import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.TruffleOptions;
 import com.oracle.truffle.api.TruffleRuntime;
 import com.oracle.truffle.api.frame.FrameDescriptor;
 import com.oracle.truffle.api.frame.FrameInstance;
 import com.oracle.truffle.api.frame.FrameInstanceVisitor;
 import com.oracle.truffle.api.frame.MaterializedFrame;
+import com.oracle.truffle.api.frame.StackDepth;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.DirectCallNode;
 import com.oracle.truffle.api.nodes.IndirectCallNode;
@@ -42,10 +45,7 @@ import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.RepeatingNode;
 import com.oracle.truffle.api.nodes.RootNode;
 import java.util.Collection;
-import java.util.Collections;
 import java.util.LinkedList;
-import java.util.Map;
-import java.util.WeakHashMap;
 
 /**
  * Default implementation of the Truffle runtime if the virtual machine does not provide a better
@@ -54,11 +54,11 @@ import java.util.WeakHashMap;
  * This is an implementation-specific class. Do not use or instantiate it. Instead, use
  * {@link Truffle#getRuntime()} to retrieve the current {@link TruffleRuntime}.
  */
-public final class DefaultTruffleRuntime implements TruffleRuntime {
+public final class DefaultTruffleRuntime implements TruffleRuntime, StackDepth, LoopCounts {
 
     private final ThreadLocal<LinkedList<FrameInstance>> stackTraces = new ThreadLocal<>();
     private final ThreadLocal<FrameInstance> currentFrames = new ThreadLocal<>();
-    private final Map<RootCallTarget, Void> callTargets = Collections.synchronizedMap(new WeakHashMap<RootCallTarget, Void>());
+    private final CallTargetRegistry callTargets = new CallTargetRegistry(TruffleOptions.TrackCallTargets);
 
     public DefaultTruffleRuntime() {
     }
@@ -72,7 +72,7 @@ public final class DefaultTruffleRuntime implements TruffleRuntime {
     public RootCallTarget createCallTarget(RootNode rootNode) {
         DefaultCallTarget target = new DefaultCallTarget(rootNode);
         rootNode.setCallTarget(target);
-        callTargets.put(target, null);
+        callTargets.register(target);
         return target;
     }
 
@@ -149,6 +149,17 @@ public final class DefaultTruffleRuntime implements TruffleRuntime {
         return result;
     }
 
+    @Override
+    public int getStackDepth() {
+        LinkedList<FrameInstance> stack = stackTraces.get();
+        return stack == null ? 0 : stack.size();
+    }
+
+    @Override
+    public long getLoopCount(CallTarget target) {
+        return target instanceof DefaultCallTarget ? ((DefaultCallTarget) target).getLoopCount() : 0;
+    }
+
     @Override
     public FrameInstance getCallerFrame() {
         return getThreadLocalStackTrace().peekFirst();
@@ -156,7 +167,23 @@ public final class DefaultTruffleRuntime implements TruffleRuntime {
 
     @Override
     public Collection<RootCallTarget> getCallTargets() {
-        return Collections.unmodifiableSet(callTargets.keySet());
+        return callTargets.snapshot();
+    }
+
+    /**
+     * Returns the number of call targets that are still referenced. Together with
+     * {@link #getCreatedCallTargetCount()} this helps to diagnose call target leaks. Returns zero if
+     * call targets are not {@linkplain TruffleOptions#TrackCallTargets tracked}.
+     */
+    public int getLiveCallTargetCount() {
+        return callTargets.liveCount();
+    }
+
+    /**
+     * Returns the number of call targets created by this runtime.
+     */
+    public long getCreatedCallTargetCount() {
+        return callTargets.createdCount();
     }
 
     @Override
@@ -165,6 +192,9 @@ public final class DefaultTruffleRuntime implements TruffleRuntime {
     }
 
     public <T> T getCapability(Class<T> capability) {
+        if (capability == StackDepth.class || capability == LoopCounts.class) {
+            return capability.cast(this);
+        }
         return null;
     }
 
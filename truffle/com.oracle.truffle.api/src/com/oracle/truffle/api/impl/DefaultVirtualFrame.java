@@ -32,32 +32,80 @@ import com.oracle.truffle.api.frame.FrameSlotTypeException;
 import com.oracle.truffle.api.frame.MaterializedFrame;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import java.util.Arrays;
+import java.util.List;
 
 /**
  * This is an implementation-specific class. Do not use or instantiate it. Instead, use
  * {@link TruffleRuntime#createVirtualFrame(Object[], FrameDescriptor)} to create a
  * {@link VirtualFrame}.
+ * <p>
+ * Primitive values are stored unboxed in {@link #primitiveLocals}, as raw bits for floating point
+ * values. A frame created for a typed call has no arguments array; its arguments are the values of
+ * the {@linkplain FrameDescriptor#getParameterSlots() parameter slots} at the time of the call,
+ * boxed on the first request or before the first write to a parameter slot.
  */
 final class DefaultVirtualFrame implements VirtualFrame {
 
+    private static final FrameSlotKind[] KINDS = FrameSlotKind.values();
+
     private final FrameDescriptor descriptor;
-    private final Object[] arguments;
+    private Object[] arguments;
     private Object[] locals;
+    private long[] primitiveLocals;
     private byte[] tags;
 
+    /**
+     * Bit {@code i} is set if slot {@code i} is a parameter whose value is an argument of a typed
+     * call that has not been boxed yet.
+     */
+    private long pendingParameterMask;
+
     DefaultVirtualFrame(FrameDescriptor descriptor, Object[] arguments) {
         this.descriptor = descriptor;
         this.arguments = arguments;
         this.locals = new Object[descriptor.getSize()];
         Arrays.fill(locals, descriptor.getDefaultValue());
+        this.primitiveLocals = new long[descriptor.getSize()];
         this.tags = new byte[descriptor.getSize()];
     }
 
+    /**
+     * Marks the parameter slots filled by the caller of a typed call as the arguments of this
+     * frame. Parameters that do not fit into the mask are boxed right away. Frames of other calls
+     * leave the parameter slots to the callee.
+     */
+    void sealParameters() {
+        assert arguments == null;
+        long mask = 0;
+        for (FrameSlot slot : descriptor.getParameterSlots()) {
+            int slotIndex = slot.getIndex();
+            if (slotIndex >= Long.SIZE) {
+                boxParameters();
+                return;
+            }
+            mask |= 1L << slotIndex;
+        }
+        pendingParameterMask = mask;
+    }
+
     @Override
     public Object[] getArguments() {
+        if (arguments == null) {
+            boxParameters();
+        }
         return arguments;
     }
 
+    private void boxParameters() {
+        List<? extends FrameSlot> parameters = descriptor.getParameterSlots();
+        pendingParameterMask = 0;
+        Object[] result = new Object[parameters.size()];
+        for (int i = 0; i < result.length; i++) {
+            result[i] = getValue(parameters.get(i));
+        }
+        arguments = result;
+    }
+
     @Override
     public MaterializedFrame materialize() {
         return new DefaultMaterializedFrame(this);
@@ -78,73 +126,67 @@ final class DefaultVirtualFrame implements VirtualFrame {
     @Override
     public byte getByte(FrameSlot slot) throws FrameSlotTypeException {
         verifyGet(slot, FrameSlotKind.Byte);
-        return (byte) locals[slot.getIndex()];
+        return (byte) primitiveLocals[slot.getIndex()];
     }
 
     @Override
     public void setByte(FrameSlot slot, byte value) {
-        verifySet(slot, FrameSlotKind.Byte);
-        locals[slot.getIndex()] = value;
+        setPrimitive(slot, FrameSlotKind.Byte, value);
     }
 
     @Override
     public boolean getBoolean(FrameSlot slot) throws FrameSlotTypeException {
         verifyGet(slot, FrameSlotKind.Boolean);
-        return (boolean) locals[slot.getIndex()];
+        return primitiveLocals[slot.getIndex()] != 0;
     }
 
     @Override
     public void setBoolean(FrameSlot slot, boolean value) {
-        verifySet(slot, FrameSlotKind.Boolean);
-        locals[slot.getIndex()] = value;
+        setPrimitive(slot, FrameSlotKind.Boolean, value ? 1 : 0);
     }
 
     @Override
     public int getInt(FrameSlot slot) throws FrameSlotTypeException {
         verifyGet(slot, FrameSlotKind.Int);
-        return (int) locals[slot.getIndex()];
+        return (int) primitiveLocals[slot.getIndex()];
     }
 
     @Override
     public void setInt(FrameSlot slot, int value) {
-        verifySet(slot, FrameSlotKind.Int);
-        locals[slot.getIndex()] = value;
+        setPrimitive(slot, FrameSlotKind.Int, value);
     }
 
     @Override
     public long getLong(FrameSlot slot) throws FrameSlotTypeException {
         verifyGet(slot, FrameSlotKind.Long);
-        return (long) locals[slot.getIndex()];
+        return primitiveLocals[slot.getIndex()];
     }
 
     @Override
     public void setLong(FrameSlot slot, long value) {
-        verifySet(slot, FrameSlotKind.Long);
-        locals[slot.getIndex()] = value;
+        setPrimitive(slot, FrameSlotKind.Long, value);
     }
 
     @Override
     public float getFloat(FrameSlot slot) throws FrameSlotTypeException {
         verifyGet(slot, FrameSlotKind.Float);
-        return (float) locals[slot.getIndex()];
+        return Float.intBitsToFloat((int) primitiveLocals[slot.getIndex()]);
     }
 
     @Override
     public void setFloat(FrameSlot slot, float value) {
-        verifySet(slot, FrameSlotKind.Float);
-        locals[slot.getIndex()] = value;
+        setPrimitive(slot, FrameSlotKind.Float, Float.floatToRawIntBits(value));
     }
 
     @Override
     public double getDouble(FrameSlot slot) throws FrameSlotTypeException {
         verifyGet(slot, FrameSlotKind.Double);
-        return (double) locals[slot.getIndex()];
+        return Double.longBitsToDouble(primitiveLocals[slot.getIndex()]);
     }
 
     @Override
     public void setDouble(FrameSlot slot, double value) {
-        verifySet(slot, FrameSlotKind.Double);
-        locals[slot.getIndex()] = value;
+        setPrimitive(slot, FrameSlotKind.Double, Double.doubleToRawLongBits(value));
     }
 
     @Override
@@ -155,7 +197,30 @@ final class DefaultVirtualFrame implements VirtualFrame {
     @Override
     public Object getValue(FrameSlot slot) {
         int slotIndex = getSlotIndexChecked(slot);
-        return locals[slotIndex];
+        long bits = primitiveLocals[slotIndex];
+        switch (KINDS[tags[slotIndex]]) {
+            case Long:
+                return bits;
+            case Int:
+                return (int) bits;
+            case Double:
+                return Double.longBitsToDouble(bits);
+            case Float:
+                return Float.intBitsToFloat((int) bits);
+            case Boolean:
+                return bits != 0;
+            case Byte:
+                return (byte) bits;
+            default:
+                return locals[slotIndex];
+        }
+    }
+
+    private void setPrimitive(FrameSlot slot, FrameSlotKind kind, long bits) {
+        verifySet(slot, kind);
+        int slotIndex = slot.getIndex();
+        primitiveLocals[slotIndex] = bits;
+        locals[slotIndex] = null;
     }
 
     private int getSlotIndexChecked(FrameSlot slot) {
@@ -170,6 +235,9 @@ final class DefaultVirtualFrame implements VirtualFrame {
 
     private void verifySet(FrameSlot slot, FrameSlotKind accessKind) {
         int slotIndex = getSlotIndexChecked(slot);
+        if (pendingParameterMask != 0 && slotIndex < Long.SIZE && (pendingParameterMask & (1L << slotIndex)) != 0) {
+            boxParameters();
+        }
         tags[slotIndex] = (byte) accessKind.ordinal();
     }
 
@@ -187,6 +255,7 @@ final class DefaultVirtualFrame implements VirtualFrame {
         if (newSize > oldSize) {
             locals = Arrays.copyOf(locals, newSize);
             Arrays.fill(locals, oldSize, newSize, descriptor.getDefaultValue());
+            primitiveLocals = Arrays.copyOf(primitiveLocals, newSize);
             tags = Arrays.copyOf(tags, newSize);
             return true;
         }
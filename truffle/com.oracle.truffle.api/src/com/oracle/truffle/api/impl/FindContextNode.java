@@ -33,6 +33,7 @@ public final class FindContextNode<C> extends Node {
     private final Class<? extends TruffleLanguage<C>> languageClass;
     @CompilerDirectives.CompilationFinal private C context;
     @CompilerDirectives.CompilationFinal private Assumption oneVM;
+    @CompilerDirectives.CompilationFinal private boolean perThread;
 
     public FindContextNode(Class<? extends TruffleLanguage<C>> type) {
         this.languageClass = type;
@@ -42,11 +43,25 @@ public final class FindContextNode<C> extends Node {
         if (context != null && oneVM.isValid()) {
             return context;
         }
+        if (perThread) {
+            return findThreadContext();
+        }
         CompilerDirectives.transferToInterpreterAndInvalidate();
+        if (Accessor.isContextPerThread()) {
+            // the context depends on the executing thread, never cache it
+            perThread = true;
+            context = null;
+            return findThreadContext();
+        }
         oneVM = Accessor.oneVMAssumption();
         return context = Accessor.findContext(languageClass);
     }
 
+    @CompilerDirectives.TruffleBoundary
+    private C findThreadContext() {
+        return Accessor.findContext(languageClass);
+    }
+
     public Class<? extends TruffleLanguage<C>> getLanguageClass() {
         return languageClass;
     }
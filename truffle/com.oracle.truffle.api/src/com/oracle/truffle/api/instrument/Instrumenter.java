@@ -26,6 +26,8 @@ package com.oracle.truffle.api.instrument;
 
 import java.io.IOException;
 import java.io.PrintStream;
+import java.lang.ref.Reference;
+import java.lang.ref.ReferenceQueue;
 import java.lang.ref.WeakReference;
 import java.util.ArrayList;
 import java.util.Collection;
@@ -43,9 +45,12 @@ import com.oracle.truffle.api.instrument.ProbeInstrument.EvalInstrument;
 import com.oracle.truffle.api.instrument.TagInstrument.AfterTagInstrument;
 import com.oracle.truffle.api.instrument.TagInstrument.BeforeTagInstrument;
 import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.NodeUtil;
 import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.LineLocation;
 import com.oracle.truffle.api.source.Source;
 import com.oracle.truffle.api.source.SourceSection;
+import com.oracle.truffle.api.source.SourceSectionIndex;
 import java.util.Map;
 
 /**
@@ -277,6 +282,13 @@ public final class Instrumenter {
      */
     private final List<WeakReference<Probe>> probes = new ArrayList<>();
 
+    /**
+     * All Probes with a source location, indexed by the probed {@link SourceSection}. Shared by all
+     * clients that look up Probes by location; entries of collected Probes are removed lazily.
+     */
+    private final SourceSectionIndex<ProbeReference> probeIndex = new SourceSectionIndex<>();
+    private final ReferenceQueue<Probe> collectedProbes = new ReferenceQueue<>();
+
     /**
      * A global instrument that triggers notification just before executing any Node that is Probed
      * with a matching tag.
@@ -357,6 +369,7 @@ public final class Instrumenter {
         Class<? extends TruffleLanguage> l = ACCESSOR.findLanguage(wrapper.getChild().getRootNode());
         final Probe probe = new Probe(this, l, probeNode, sourceSection);
         probes.add(new WeakReference<>(probe));
+        indexProbe(probe, sourceSection);
         probeNode.probe = probe;  // package private access
         wrapper.insertEventHandlerNode(probeNode);
         node.replace(wrapperNode);
@@ -404,6 +417,62 @@ public final class Instrumenter {
         return taggedProbes;
     }
 
+    /**
+     * Returns all {@link Probe}s whose probed source section starts on a line, ordered by their
+     * position in the line; an empty collection if none.
+     */
+    public Collection<Probe> findProbesStartingOn(LineLocation line) {
+        return toProbes(probeIndex.findStartingOn(line));
+    }
+
+    /**
+     * Returns all {@link Probe}s whose probed source section contains a character position, from
+     * the outermost to the innermost section; an empty collection if none.
+     */
+    public Collection<Probe> findProbesContaining(Source source, int charIndex) {
+        return toProbes(probeIndex.findContaining(source, charIndex));
+    }
+
+    /**
+     * Returns all {@link Probe}s whose probed source section overlaps a section, e.g. all Probes
+     * within a function, ordered by their position; an empty collection if none.
+     */
+    public Collection<Probe> findProbesOverlapping(SourceSection section) {
+        return toProbes(probeIndex.findOverlapping(section));
+    }
+
+    private void indexProbe(Probe probe, SourceSection sourceSection) {
+        Reference<? extends Probe> collected;
+        while ((collected = collectedProbes.poll()) != null) {
+            final ProbeReference ref = (ProbeReference) collected;
+            probeIndex.remove(ref.sourceSection, ref);
+        }
+        if (sourceSection != null && sourceSection.getSource() != null) {
+            probeIndex.add(sourceSection, new ProbeReference(probe, sourceSection, collectedProbes));
+        }
+    }
+
+    private static Collection<Probe> toProbes(List<ProbeReference> refs) {
+        final List<Probe> result = new ArrayList<>(refs.size());
+        for (ProbeReference ref : refs) {
+            final Probe probe = ref.get();
+            if (probe != null) {
+                result.add(probe);
+            }
+        }
+        return result;
+    }
+
+    private static final class ProbeReference extends WeakReference<Probe> {
+
+        private final SourceSection sourceSection;
+
+        ProbeReference(Probe probe, SourceSection sourceSection, ReferenceQueue<Probe> queue) {
+            super(probe, queue);
+            this.sourceSection = sourceSection;
+        }
+    }
+
     /**
      * Enables instrumentation at selected nodes in all subsequently constructed ASTs. Ignored if
      * the argument is already registered, runtime error if argument is {@code null}.
@@ -674,6 +743,8 @@ public final class Instrumenter {
             for (ProbeListener listener : probeListeners) {
                 listener.startASTProbing(rootNode);
             }
+            // probers must not wrap nodes in a tree that shares them with this one
+            NodeUtil.materializeSharedNodes(rootNode);
             for (ASTProber prober : astProbers) {
                 prober.probeAST(this, rootNode);
             }
@@ -29,9 +29,12 @@ import java.lang.ref.WeakReference;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
+import java.util.LinkedHashMap;
 import java.util.List;
+import java.util.Map;
 
 import com.oracle.truffle.api.Assumption;
+import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.CompilerDirectives.CompilationFinal;
 import com.oracle.truffle.api.TruffleLanguage;
 import com.oracle.truffle.api.instrument.TagInstrument.AfterTagInstrument;
@@ -84,6 +87,25 @@ public final class Probe {
     private final ArrayList<SyntaxTag> tags = new ArrayList<>();
     private final List<WeakReference<ProbeNode>> probeNodeClones = new ArrayList<>();
 
+    static final int MAX_EVAL_TARGETS = 16;
+
+    /**
+     * Call targets of source fragments evaluated at this probe by
+     * {@link ProbeInstrument.EvalInstrument}s. A fragment is parsed in the lexical context of the
+     * probed location, so it needs to be parsed at most once per frame descriptor, no matter how
+     * often the AST is cloned or the instrument is re-attached. Conditions and logpoints may be
+     * changed arbitrarily often, so only the {@link #MAX_EVAL_TARGETS} most recently used call
+     * targets are kept.
+     */
+    private final Map<Object, CallTarget> evalTargets = new LinkedHashMap<Object, CallTarget>(16, 0.75f, true) {
+        private static final long serialVersionUID = 1L;
+
+        @Override
+        protected boolean removeEldestEntry(Map.Entry<Object, CallTarget> eldest) {
+            return size() > MAX_EVAL_TARGETS;
+        }
+    };
+
     /*
      * Invalidated whenever something changes in the Probe and its Instrument chain, so need deopt
      */
@@ -228,6 +250,14 @@ public final class Probe {
         invalidateProbeUnchanged();
     }
 
+    synchronized CallTarget getEvalTarget(Object key) {
+        return evalTargets.get(key);
+    }
+
+    synchronized void putEvalTarget(Object key, CallTarget callTarget) {
+        evalTargets.put(key, callTarget);
+    }
+
     /**
      * Gets the {@link SourceSection} associated with the <en>Probed AST node</em>, possibly
      * {@code null}.
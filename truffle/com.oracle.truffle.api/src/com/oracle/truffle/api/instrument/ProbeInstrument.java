@@ -25,11 +25,14 @@
 package com.oracle.truffle.api.instrument;
 
 import java.io.IOException;
+import java.util.Arrays;
 
 import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.CompilerDirectives;
+import com.oracle.truffle.api.CompilerDirectives.CompilationFinal;
 import com.oracle.truffle.api.Truffle;
 import com.oracle.truffle.api.TruffleLanguage;
+import com.oracle.truffle.api.frame.FrameDescriptor;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.DirectCallNode;
 import com.oracle.truffle.api.nodes.Node;
@@ -377,6 +380,57 @@ public abstract class ProbeInstrument extends Instrument {
             return instrumentNode;
         }
 
+        /**
+         * Returns the call target for the source fragment in the lexical context described by the
+         * frame descriptor, parsing the fragment only if no instrument attached to the same
+         * {@link Probe} has parsed it for that context before.
+         */
+        private CallTarget findCallTarget(Node node, FrameDescriptor frameDescriptor) throws IOException {
+            final EvalKey key = new EvalKey(languageClass, source, names, frameDescriptor);
+            CallTarget callTarget = probe.getEvalTarget(key);
+            if (callTarget == null) {
+                callTarget = Instrumenter.ACCESSOR.parse(languageClass, source, node, names);
+                if (callTarget != null) {
+                    probe.putEvalTarget(key, callTarget);
+                }
+            }
+            return callTarget;
+        }
+
+        /**
+         * Identifies a parsed source fragment: the parse result depends on the language, the
+         * source, the argument names and the lexical context of the probed location.
+         */
+        private static final class EvalKey {
+
+            @SuppressWarnings("rawtypes") private final Class<? extends TruffleLanguage> languageClass;
+            private final Source source;
+            private final String[] names;
+            private final FrameDescriptor frameDescriptor;
+
+            @SuppressWarnings("rawtypes")
+            EvalKey(Class<? extends TruffleLanguage> languageClass, Source source, String[] names, FrameDescriptor frameDescriptor) {
+                this.languageClass = languageClass;
+                this.source = source;
+                this.names = names;
+                this.frameDescriptor = frameDescriptor;
+            }
+
+            @Override
+            public boolean equals(Object obj) {
+                if (!(obj instanceof EvalKey)) {
+                    return false;
+                }
+                final EvalKey other = (EvalKey) obj;
+                return languageClass == other.languageClass && source.equals(other.source) && Arrays.equals(names, other.names) && frameDescriptor == other.frameDescriptor;
+            }
+
+            @Override
+            public int hashCode() {
+                return source.hashCode() ^ System.identityHashCode(frameDescriptor);
+            }
+        }
+
         /**
          * Node that implements an {@link EvalInstrument} in a particular AST.
          */
@@ -385,15 +439,22 @@ public abstract class ProbeInstrument extends Instrument {
 
             @Child private DirectCallNode callNode;
 
+            /**
+             * Failure to parse the source fragment, reported on every execution instead of
+             * re-parsing the fragment.
+             */
+            @CompilationFinal private Exception parseFailure;
+
             private EvalInstrumentNode(AbstractInstrumentNode nextNode) {
                 super(nextNode);
             }
 
             @Override
             public void enter(Node node, VirtualFrame vFrame) {
-                if (callNode == null) {
+                if (callNode == null && parseFailure == null) {
+                    CompilerDirectives.transferToInterpreterAndInvalidate();
                     try {
-                        final CallTarget callTarget = Instrumenter.ACCESSOR.parse(languageClass, source, node, names);
+                        final CallTarget callTarget = findCallTarget(node, vFrame.getFrameDescriptor());
                         if (callTarget != null) {
                             callNode = Truffle.getRuntime().createDirectCallNode(callTarget);
                             callNode.forceInlining();
@@ -401,12 +462,14 @@ public abstract class ProbeInstrument extends Instrument {
                             EvalInstrument.this.probe.invalidateProbeUnchanged();
                         }
                     } catch (RuntimeException | IOException ex) {
-                        if (evalListener != null) {
-                            evalListener.onFailure(node, vFrame, ex);
-                        }
+                        parseFailure = ex;
                     }
                 }
-                if (callNode != null) {
+                if (parseFailure != null) {
+                    if (evalListener != null) {
+                        evalListener.onFailure(node, vFrame, parseFailure);
+                    }
+                } else if (callNode != null) {
                     try {
                         final Object result = callNode.call(vFrame, params);
                         if (evalListener != null) {
@@ -46,8 +46,8 @@
  * The framework supports many kinds of tools, for example simple collectors of data such as the
  * CoverageTracker.
  * It also supports Truffle's built-in
- * {@linkplain com.oracle.truffle.api.debug.Debugger debugging services}, as well as utilities
- * that maintain {@linkplain com.oracle.truffle.api.debug.LineToProbesMap maps of source code locations}
+ * {@linkplain com.oracle.truffle.api.debug.Debugger debugging services}, and it maintains an
+ * {@linkplain com.oracle.truffle.api.source.SourceSectionIndex index of source code locations}
  * for other tools such as {@linkplain com.oracle.truffle.api.debug.Debugger debugging}.
  *
  * <h4>Instrumentation Services</h4>
@@ -184,11 +184,13 @@
  * {@linkplain com.oracle.truffle.api.instrument.Instrumenter.Tool tools} can be dynamically
  * {@linkplain com.oracle.truffle.api.instrument.Instrumenter.Tool#setEnabled(boolean) disabled and re-enabled} and eventually
  * {@linkplain com.oracle.truffle.api.instrument.Instrumenter.Tool#dispose() disposed} when no longer needed.</li>
- * <li>A useful example is the
- * {@linkplain com.oracle.truffle.api.debug.LineToProbesMap LineToProbesMap}, which incrementally builds and maintains a map of
- * {@linkplain com.oracle.truffle.api.instrument.Probe Probes} indexed by
- * {@linkplain com.oracle.truffle.api.source.LineLocation source code line}. Truffle
- * {@linkplain com.oracle.truffle.api.debug.Debugger debugging services} depend heavily on this utility.</li>
+ * <li>The Instrumenter incrementally maintains an
+ * {@linkplain com.oracle.truffle.api.source.SourceSectionIndex index} of
+ * {@linkplain com.oracle.truffle.api.instrument.Probe Probes} by source code location, queried with
+ * {@linkplain com.oracle.truffle.api.instrument.Instrumenter#findProbesStartingOn(com.oracle.truffle.api.source.LineLocation) line},
+ * {@linkplain com.oracle.truffle.api.instrument.Instrumenter#findProbesContaining(com.oracle.truffle.api.source.Source, int) position} or
+ * {@linkplain com.oracle.truffle.api.instrument.Instrumenter#findProbesOverlapping(com.oracle.truffle.api.source.SourceSection) range}. Truffle
+ * {@linkplain com.oracle.truffle.api.debug.Debugger debugging services} depend heavily on this index.</li>
  * <li>The CoverageTracker maintains counts of execution events where a
  * {@linkplain com.oracle.truffle.api.instrument.Probe Probe} has been tagged with
  * {@linkplain com.oracle.truffle.api.instrument.StandardSyntaxTag#STATEMENT STATEMENT}, indexed by source code line.</li>
@@ -28,6 +28,8 @@ import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.RootCallTarget;
 import com.oracle.truffle.api.Truffle;
 import com.oracle.truffle.api.TruffleRuntime;
+import com.oracle.truffle.api.frame.Frame;
+import com.oracle.truffle.api.frame.FrameDescriptor;
 import com.oracle.truffle.api.frame.VirtualFrame;
 
 /**
@@ -63,6 +65,37 @@ public abstract class DirectCallNode extends Node {
      */
     public abstract Object call(VirtualFrame frame, Object[] arguments);
 
+    /**
+     * Creates a frame for a typed call of the current call target with <code>argumentCount</code>
+     * arguments. The caller stores argument {@code i} in
+     * {@linkplain FrameDescriptor#getParameterSlots() parameter slot} {@code i} of the frame, with
+     * the setter that matches the slot kind, and passes the frame to
+     * {@link #call(VirtualFrame, Frame)}. This avoids the arguments array and the boxing of
+     * primitive arguments. The callee's {@link Frame#getArguments()} still returns the arguments as
+     * passed.
+     * <p>
+     * Returns <code>null</code> if the runtime does not support typed calls or the frame descriptor
+     * of the callee does not declare exactly <code>argumentCount</code> parameters; the caller then
+     * uses {@link #call(VirtualFrame, Object[])}.
+     *
+     * @param argumentCount the number of arguments the caller passes
+     * @return a frame for the callee or <code>null</code>
+     */
+    public Frame createArgumentFrame(int argumentCount) {
+        return null;
+    }
+
+    /**
+     * Calls the current call target with a frame created by {@link #createArgumentFrame(int)}
+     * whose parameter slots hold the arguments.
+     *
+     * @param argumentFrame the frame returned by {@link #createArgumentFrame(int)}
+     * @return the return result of the call
+     */
+    public Object call(VirtualFrame frame, Frame argumentFrame) {
+        throw new UnsupportedOperationException();
+    }
+
     /**
      * Returns the originally supplied {@link CallTarget} when this call node was created. Please
      * note that the returned {@link CallTarget} is not necessarily the {@link CallTarget} that is
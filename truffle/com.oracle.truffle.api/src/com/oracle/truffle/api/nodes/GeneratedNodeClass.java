@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes;
+
+import java.lang.annotation.ElementType;
+import java.lang.annotation.Retention;
+import java.lang.annotation.RetentionPolicy;
+import java.lang.annotation.Target;
+import java.util.Iterator;
+
+/**
+ * Base class for {@link NodeClass} implementations generated by the Truffle DSL processor. The
+ * generated subclasses visit, replace and copy children with straight-line code instead of
+ * iterating the {@link NodeFieldAccessor field accessors}. The field metadata itself is still
+ * provided by the reflective implementation. A generated node class is picked up by
+ * {@link NodeClass#get(Class)} if the node class is annotated with {@link Registration}.
+ */
+public abstract class GeneratedNodeClass extends NodeClass {
+
+    private final NodeClass reflective;
+
+    protected GeneratedNodeClass(Class<? extends Node> clazz) {
+        super(clazz);
+        this.reflective = new NodeClassImpl(clazz);
+    }
+
+    @Override
+    public NodeFieldAccessor getNodeClassField() {
+        return reflective.getNodeClassField();
+    }
+
+    @Override
+    public NodeFieldAccessor[] getCloneableFields() {
+        return reflective.getCloneableFields();
+    }
+
+    @Override
+    public NodeFieldAccessor[] getFields() {
+        return reflective.getFields();
+    }
+
+    @Override
+    public NodeFieldAccessor getParentField() {
+        return reflective.getParentField();
+    }
+
+    @Override
+    public NodeFieldAccessor[] getChildFields() {
+        return reflective.getChildFields();
+    }
+
+    @Override
+    public NodeFieldAccessor[] getChildrenFields() {
+        return reflective.getChildrenFields();
+    }
+
+    @Override
+    public Iterator<Node> makeIterator(Node node) {
+        return reflective.makeIterator(node);
+    }
+
+    @Override
+    public Class<? extends Node> getType() {
+        return reflective.getType();
+    }
+
+    @Override
+    protected abstract boolean forEachChild(Node parent, NodeVisitor visitor);
+
+    @Override
+    protected abstract boolean replaceChild(Node parent, Node oldChild, Node newChild, boolean adopt);
+
+    @Override
+    protected abstract void copyChildren(Node original, Node copy);
+
+    protected static boolean visitChild(Node child, NodeVisitor visitor) {
+        return child == null || visitor.visit(child);
+    }
+
+    protected static boolean visitChildren(Object[] children, NodeVisitor visitor) {
+        if (children != null) {
+            for (int i = 0; i < children.length; i++) {
+                if (!visitChild((Node) children[i], visitor)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    protected static boolean replaceChildren(Node parent, Object[] children, Node oldChild, Node newChild, boolean adopt) {
+        if (children != null) {
+            for (int i = 0; i < children.length; i++) {
+                if (children[i] == oldChild) {
+                    if (adopt) {
+                        adoptChild(parent, newChild);
+                    }
+                    children[i] = newChild;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Registers the generated {@link NodeClass} of the annotated {@link Node} subclass. The
+     * registered class must declare a constructor without arguments.
+     */
+    @Retention(RetentionPolicy.RUNTIME)
+    @Target({ElementType.TYPE})
+    public @interface Registration {
+
+        Class<? extends GeneratedNodeClass> value();
+
+    }
+}
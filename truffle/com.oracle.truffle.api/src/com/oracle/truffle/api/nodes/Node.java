@@ -51,6 +51,8 @@ public abstract class Node implements NodeInterface, Cloneable {
     private final NodeClass nodeClass;
     @CompilationFinal private Node parent;
     @CompilationFinal private SourceSection sourceSection;
+    /** Set once a deep copy shares this node with another tree. */
+    boolean shared;
 
     /**
      * Marks array fields that are children of this node.
@@ -202,7 +204,7 @@ public abstract class Node implements NodeInterface, Cloneable {
     private void adoptHelper() {
         NodeUtil.forEachChild(this, new NodeVisitor() {
             public boolean visit(Node child) {
-                if (child != null && child.getParent() != Node.this) {
+                if (child != null && child.getParent() != Node.this && !NodeUtil.isSharedChild(Node.this, child)) {
                     Node.this.adoptHelper(child);
                 }
                 return true;
@@ -289,11 +291,19 @@ public abstract class Node implements NodeInterface, Cloneable {
             // Pass on the source section to the new node.
             newNode.assignSourceSection(sourceSection);
         }
+        Node oldParent = this.parent;
+        if (NodeUtil.isInSharedSubtree(oldParent)) {
+            // copy on write: other trees keep the shared parent
+            oldParent = NodeUtil.materializeAncestors(oldParent);
+        }
         // (aw) need to set parent *before* replace, so that (unsynchronized) getRootNode()
         // will always find the root node
-        newNode.parent = this.parent;
-        if (!NodeUtil.replaceChild(this.parent, this, newNode, true)) {
-            this.parent.adoptUnadoptedHelper(newNode);
+        newNode.parent = oldParent;
+        if (!NodeUtil.replaceChild(oldParent, this, newNode, true)) {
+            oldParent.adoptUnadoptedHelper(newNode);
+        } else if (shared && this.parent == oldParent) {
+            // a shared node that moved below its replacement is adopted now that its parent let go
+            newNode.adoptHelper();
         }
         reportReplace(this, newNode, reason);
         onReplace(newNode, reason);
@@ -306,6 +316,20 @@ public abstract class Node implements NodeInterface, Cloneable {
         return NodeUtil.isReplacementSafe(getParent(), this, newNode);
     }
 
+    /**
+     * Reports that this node changed its behavior in place instead of being replaced, e.g. when a
+     * DSL generated node activates a specialization in its state field. Observers, rewrite tracing
+     * and the {@link RewriteProfiler} see it as a replace of this node with itself. Must be called
+     * within an {@link #atomic(Runnable) atomic} block.
+     *
+     * @param reason the reason of the rewrite
+     */
+    public final void reportRewrite(CharSequence reason) {
+        CompilerAsserts.neverPartOfCompilation();
+        assert inAtomicBlock();
+        reportReplace(this, this, reason);
+    }
+
     private void reportReplace(Node oldNode, Node newNode, CharSequence reason) {
         Node node = this;
         while (node != null) {
@@ -329,6 +353,10 @@ public abstract class Node implements NodeInterface, Cloneable {
         if (TruffleOptions.TraceASTJSON) {
             JSONHelper.dumpReplaceChild(this, newNode, reason);
         }
+        final RewriteProfiler rewriteProfiler = RewriteProfiler.getInstance();
+        if (rewriteProfiler != null) {
+            rewriteProfiler.nodeReplaced(this, newNode, reason);
+        }
     }
 
     /**
@@ -376,7 +404,9 @@ public abstract class Node implements NodeInterface, Cloneable {
         CompilerAsserts.neverPartOfCompilation();
 
         try {
-            return (Node) super.clone();
+            Node copy = (Node) super.clone();
+            copy.shared = false;
+            return copy;
         } catch (CloneNotSupportedException e) {
             throw new AssertionError(e);
         }
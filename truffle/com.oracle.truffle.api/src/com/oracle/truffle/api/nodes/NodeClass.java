@@ -24,10 +24,14 @@
  */
 package com.oracle.truffle.api.nodes;
 
+import java.lang.reflect.Array;
+import java.lang.reflect.Constructor;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import java.util.Iterator;
 
+import com.oracle.truffle.api.nodes.NodeFieldAccessor.NodeFieldKind;
+
 /**
  * Information about a {@link Node} class. A single instance of this class is allocated for every
  * subclass of {@link Node} that is used.
@@ -40,12 +44,26 @@ public abstract class NodeClass {
             assert Node.class.isAssignableFrom(clazz);
             return AccessController.doPrivileged(new PrivilegedAction<NodeClass>() {
                 public NodeClass run() {
+                    GeneratedNodeClass.Registration registration = clazz.getAnnotation(GeneratedNodeClass.Registration.class);
+                    if (registration != null) {
+                        return createGenerated(registration.value());
+                    }
                     return new NodeClassImpl((Class<? extends Node>) clazz);
                 }
             });
         }
     };
 
+    private static NodeClass createGenerated(Class<? extends GeneratedNodeClass> generatedClass) {
+        try {
+            Constructor<? extends GeneratedNodeClass> constructor = generatedClass.getDeclaredConstructor();
+            constructor.setAccessible(true);
+            return constructor.newInstance();
+        } catch (ReflectiveOperationException e) {
+            throw new AssertionError("Cannot instantiate generated node class " + generatedClass.getName(), e);
+        }
+    }
+
     public static NodeClass get(Class<? extends Node> clazz) {
         return nodeClasses.get(clazz);
     }
@@ -54,8 +72,10 @@ public abstract class NodeClass {
         return node.getNodeClass();
     }
 
-    @SuppressWarnings("unused")
+    private final boolean shareable;
+
     public NodeClass(Class<? extends Node> clazz) {
+        this.shareable = clazz.isAnnotationPresent(Shareable.class);
     }
 
     public abstract NodeFieldAccessor getNodeClassField();
@@ -79,4 +99,163 @@ public abstract class NodeClass {
      * @return the clazz of node this <code>NodeClass</code> describes
      */
     public abstract Class<? extends Node> getType();
+
+    /**
+     * Returns {@code true} if the described class is annotated with {@link Shareable}.
+     */
+    public final boolean isShareable() {
+        return shareable;
+    }
+
+    /**
+     * Invokes the visitor for every non-null child of a node of this class. The default
+     * implementation iterates the {@link #getChildFields() child} and {@link #getChildrenFields()
+     * children} fields; generated subclasses replace it with straight-line code.
+     *
+     * @return {@code true} if all children were visited, {@code false} otherwise
+     */
+    protected boolean forEachChild(Node parent, NodeVisitor visitor) {
+        for (NodeFieldAccessor field : getChildFields()) {
+            Object child = field.getObject(parent);
+            if (child != null) {
+                if (!visitor.visit((Node) child)) {
+                    return false;
+                }
+            }
+        }
+
+        for (NodeFieldAccessor field : getChildrenFields()) {
+            Object arrayObject = field.getObject(parent);
+            if (arrayObject != null) {
+                Object[] array = (Object[]) arrayObject;
+                for (int i = 0; i < array.length; i++) {
+                    Object child = array[i];
+                    if (child != null) {
+                        if (!visitor.visit((Node) child)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Replaces the first occurrence of {@code oldChild} in a node of this class with
+     * {@code newChild}. If {@code adopt} is set the new child is {@link #adoptChild(Node, Node)
+     * adopted} before it becomes reachable from the parent.
+     *
+     * @return {@code true} if the old child was found and replaced, {@code false} otherwise
+     */
+    @SuppressWarnings("deprecation")
+    protected boolean replaceChild(Node parent, Node oldChild, Node newChild, boolean adopt) {
+        for (NodeFieldAccessor nodeField : getChildFields()) {
+            if (nodeField.getObject(parent) == oldChild) {
+                assert assertAssignable(nodeField, newChild);
+                if (adopt) {
+                    adoptChild(parent, newChild);
+                }
+                nodeField.putObject(parent, newChild);
+                return true;
+            }
+        }
+
+        for (NodeFieldAccessor nodeField : getChildrenFields()) {
+            Object arrayObject = nodeField.getObject(parent);
+            if (arrayObject != null) {
+                Object[] array = (Object[]) arrayObject;
+                for (int i = 0; i < array.length; i++) {
+                    if (array[i] == oldChild) {
+                        assert assertAssignable(nodeField, newChild);
+                        if (adopt) {
+                            adoptChild(parent, newChild);
+                        }
+                        array[i] = newChild;
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Deep copies all children of {@code original} into {@code copy}, which is a shallow
+     * {@link Node#copy() copy} of {@code original}.
+     */
+    @SuppressWarnings("deprecation")
+    protected void copyChildren(Node original, Node copy) {
+        for (NodeFieldAccessor childField : getChildFields()) {
+            Node child = (Node) childField.getObject(original);
+            if (child != null) {
+                childField.putObject(copy, copyChild(copy, child));
+            }
+        }
+        copyChildrenFields(original, copy);
+    }
+
+    /**
+     * Deep copies the arrays of all {@link Node.Children} fields. These fields are final, so
+     * generated subclasses cannot assign them directly and delegate to this method instead.
+     */
+    @SuppressWarnings("deprecation")
+    protected final void copyChildrenFields(Node original, Node copy) {
+        for (NodeFieldAccessor childrenField : getChildrenFields()) {
+            Object[] children = (Object[]) childrenField.getObject(original);
+            if (children != null) {
+                Object[] clonedChildren = (Object[]) Array.newInstance(children.getClass().getComponentType(), children.length);
+                for (int i = 0; i < children.length; i++) {
+                    if (children[i] != null) {
+                        clonedChildren[i] = copyChild(copy, (Node) children[i]);
+                    }
+                }
+                childrenField.putObject(copy, clonedChildren);
+            }
+        }
+    }
+
+    /**
+     * Creates a deep copy of a child node whose parent is {@code parentCopy}. Children that are
+     * {@link NodeUtil#isShareable(Node) shareable} are returned as is.
+     */
+    @SuppressWarnings("deprecation")
+    protected final Node copyChild(Node parentCopy, Node child) {
+        if (NodeUtil.isShareable(child)) {
+            NodeUtil.markShared(child);
+            return child;
+        }
+        Node clonedChild = child.deepCopy();
+        getParentField().putObject(clonedChild, parentCopy);
+        return clonedChild;
+    }
+
+    /**
+     * Makes {@code parent} the parent of {@code child} and adopts all of its children.
+     */
+    protected static void adoptChild(Node parent, Node child) {
+        parent.adoptHelper(child);
+    }
+
+    private static boolean assertAssignable(NodeFieldAccessor field, Object newValue) {
+        if (newValue == null) {
+            return true;
+        }
+        if (field.getKind() == NodeFieldKind.CHILD) {
+            if (field.getType().isAssignableFrom(newValue.getClass())) {
+                return true;
+            } else {
+                assert false : "Child class " + newValue.getClass().getName() + " is not assignable to field \"" + field.getName() + "\" of type " + field.getType().getName();
+                return false;
+            }
+        } else if (field.getKind() == NodeFieldKind.CHILDREN) {
+            if (field.getType().getComponentType().isAssignableFrom(newValue.getClass())) {
+                return true;
+            } else {
+                assert false : "Child class " + newValue.getClass().getName() + " is not assignable to field \"" + field.getName() + "\" of type " + field.getType().getName();
+                return false;
+            }
+        }
+        throw new IllegalArgumentException();
+    }
 }
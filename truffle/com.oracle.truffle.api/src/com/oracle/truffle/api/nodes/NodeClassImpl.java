@@ -99,7 +99,7 @@ final class NodeClassImpl extends NodeClass {
             }
 
             NodeFieldAccessor nodeField;
-            if (field.getDeclaringClass() == Node.class && (field.getName().equals("parent") || field.getName().equals("nodeClass"))) {
+            if (field.getDeclaringClass() == Node.class && (field.getName().equals("parent") || field.getName().equals("nodeClass") || field.getName().equals("shared"))) {
                 continue;
             } else if (field.getAnnotation(Child.class) != null) {
                 checkChildField(field);
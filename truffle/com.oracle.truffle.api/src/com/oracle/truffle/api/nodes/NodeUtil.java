@@ -29,14 +29,15 @@ import java.io.PrintStream;
 import java.io.PrintWriter;
 import java.io.StringWriter;
 import java.lang.annotation.Annotation;
-import java.lang.reflect.Array;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collection;
+import java.util.Collections;
 import java.util.Iterator;
 import java.util.List;
 import java.util.NoSuchElementException;
 import java.util.Objects;
+import java.util.concurrent.Callable;
 
 import com.oracle.truffle.api.CompilerAsserts;
 import com.oracle.truffle.api.TruffleOptions;
@@ -136,36 +137,208 @@ public final class NodeUtil {
         NodeClass nodeClass = clone.getNodeClass();
 
         nodeClass.getParentField().putObject(clone, null);
+        nodeClass.copyChildren(orig, clone);
+        copyCloneableFields(nodeClass, orig, clone);
+        return clone;
+    }
 
-        for (NodeFieldAccessor childField : nodeClass.getChildFields()) {
-            Node child = (Node) childField.getObject(orig);
-            if (child != null) {
-                Node clonedChild = child.deepCopy();
-                nodeClass.getParentField().putObject(clonedChild, clone);
-                childField.putObject(clone, clonedChild);
+    @SuppressWarnings("deprecation")
+    private static void copyCloneableFields(NodeClass nodeClass, Node orig, Node clone) {
+        for (NodeFieldAccessor cloneableField : nodeClass.getCloneableFields()) {
+            Object cloneable = cloneableField.getObject(clone);
+            if (cloneable != null && cloneable == cloneableField.getObject(orig)) {
+                cloneableField.putObject(clone, ((NodeCloneable) cloneable).clone());
+            }
+        }
+    }
+
+    /**
+     * Returns {@code true} if {@link Node#deepCopy() deep copies} of a parent of {@code node} may
+     * share it instead of copying it. This is the case if the class of the node is annotated with
+     * {@link Shareable}, the node is already adopted and its {@link Node#getCost() cost} is
+     * {@link NodeCost#MONOMORPHIC}.
+     */
+    public static boolean isShareable(Node node) {
+        return node.getParent() != null && node.getNodeClass().isShareable() && node.getCost() == NodeCost.MONOMORPHIC;
+    }
+
+    /**
+     * Set once a {@link Node#deepCopy() deep copy} shared a node, so that rewrites do not look for
+     * shared ancestors before that.
+     */
+    private static volatile boolean sharingUsed;
+
+    static void markShared(Node node) {
+        node.shared = true;
+        if (!sharingUsed) {
+            sharingUsed = true;
+        }
+    }
+
+    /**
+     * Returns {@code true} if {@code child} is a child of {@code parent} that is shared with
+     * another tree, which owns it. The owner is the parent the child points to, as long as that
+     * parent still holds it. Moving a shared node within the tree that owns it, e.g., when it is
+     * wrapped for instrumentation, is not sharing.
+     */
+    static boolean isSharedChild(Node parent, Node child) {
+        if (!child.shared) {
+            return false;
+        }
+        Node childParent = child.getParent();
+        return childParent != null && childParent != parent && isChild(childParent, child);
+    }
+
+    private static boolean isChild(Node parent, final Node child) {
+        return !forEachChild(parent, new NodeVisitor() {
+            public boolean visit(Node node) {
+                return node != child;
+            }
+        });
+    }
+
+    /**
+     * Returns {@code true} if {@code node} or one of its ancestors is shared with another tree.
+     */
+    static boolean isInSharedSubtree(Node node) {
+        if (!sharingUsed) {
+            return false;
+        }
+        for (Node current = node; current != null; current = current.getParent()) {
+            if (current.shared) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Materializes the path from {@code root} to {@code node} in a tree that shares subtrees with
+     * other trees. Every {@link Shareable shared} node on the path, and every node below it, is
+     * replaced with a shallow copy owned by the tree of {@code root}; children that are not on the
+     * path stay shared. {@link Node#replace(Node) Rewrites} and
+     * {@link #materializeSharedNodes(Node) probing} do this on their own; call this method to get
+     * the node of a specific tree before handing it to code that modifies it in another way.
+     *
+     * @param root the root of the tree that is about to be modified
+     * @param node a node reachable from {@code root}
+     * @return the copy of {@code node} owned by the tree of {@code root}, or {@code node} itself if
+     *         it is not shared
+     * @throws IllegalArgumentException if {@code node} is not reachable from {@code root}
+     */
+    public static <T extends Node> T materializePath(final Node root, final T node) {
+        CompilerAsserts.neverPartOfCompilation();
+        final List<Node> path = new ArrayList<>();
+        if (!findPath(root, node, path)) {
+            throw new IllegalArgumentException("Node " + node + " is not reachable from " + root + ".");
+        }
+        return root.atomic(new Callable<T>() {
+            @SuppressWarnings("unchecked")
+            public T call() {
+                return (T) materialize(path);
+            }
+        });
+    }
+
+    /**
+     * Materializes the path to {@code node} in the tree its parents belong to. Must be called in
+     * an atomic block.
+     */
+    static Node materializeAncestors(Node node) {
+        final List<Node> path = new ArrayList<>();
+        for (Node current = node; current != null; current = current.getParent()) {
+            path.add(current);
+        }
+        Collections.reverse(path);
+        return materialize(path);
+    }
+
+    private static Node materialize(List<Node> path) {
+        Node owner = path.get(0);
+        boolean inSharedSubtree = owner.shared;
+        for (int i = 1; i < path.size(); i++) {
+            Node current = path.get(i);
+            inSharedSubtree |= current.shared;
+            if (inSharedSubtree) {
+                current = privateCopy(owner, current);
             }
+            owner = current;
         }
+        return owner;
+    }
+
+    /**
+     * Replaces {@code child} in {@code owner} with a shallow copy. The children of the copy are
+     * shared with {@code child}; if {@code owner} is the tree that owns {@code child}, they move
+     * along with the copy.
+     */
+    @SuppressWarnings("deprecation")
+    private static Node privateCopy(final Node owner, final Node child) {
+        final boolean owned = child.getParent() == owner;
+        final Node copy = child.copy();
+        NodeClass nodeClass = copy.getNodeClass();
+        nodeClass.getParentField().putObject(copy, owner);
+        copyCloneableFields(nodeClass, child, copy);
         for (NodeFieldAccessor childrenField : nodeClass.getChildrenFields()) {
-            Object[] children = (Object[]) childrenField.getObject(orig);
+            Object[] children = (Object[]) childrenField.getObject(copy);
             if (children != null) {
-                Object[] clonedChildren = (Object[]) Array.newInstance(children.getClass().getComponentType(), children.length);
-                for (int i = 0; i < children.length; i++) {
-                    if (children[i] != null) {
-                        Node clonedChild = ((Node) children[i]).deepCopy();
-                        clonedChildren[i] = clonedChild;
-                        nodeClass.getParentField().putObject(clonedChild, clone);
+                childrenField.putObject(copy, children.clone());
+            }
+        }
+        owner.getNodeClass().replaceChild(owner, child, copy, false);
+        forEachChild(copy, new NodeVisitor() {
+            public boolean visit(Node grandChild) {
+                if (grandChild != null) {
+                    markShared(grandChild);
+                    if (owned && grandChild.getParent() == child) {
+                        grandChild.getNodeClass().getParentField().putObject(grandChild, copy);
                     }
                 }
-                childrenField.putObject(clone, clonedChildren);
+                return true;
             }
+        });
+        return copy;
+    }
+
+    /**
+     * Gives the tree of {@code root} private copies of all nodes it shares with a tree that owns
+     * them, so that the nodes reached from {@code root} have their parents in that tree. The
+     * instrumentation framework calls this before it probes a tree.
+     */
+    public static void materializeSharedNodes(final Node root) {
+        CompilerAsserts.neverPartOfCompilation();
+        if (!sharingUsed) {
+            return;
         }
-        for (NodeFieldAccessor cloneableField : nodeClass.getCloneableFields()) {
-            Object cloneable = cloneableField.getObject(clone);
-            if (cloneable != null && cloneable == cloneableField.getObject(orig)) {
-                cloneableField.putObject(clone, ((NodeCloneable) cloneable).clone());
+        root.atomic(new Runnable() {
+            public void run() {
+                materializeSharedChildren(root);
+            }
+        });
+    }
+
+    private static void materializeSharedChildren(final Node owner) {
+        for (Node child : findNodeChildren(owner)) {
+            Node current = child;
+            if (isSharedChild(owner, child)) {
+                current = privateCopy(owner, child);
             }
+            materializeSharedChildren(current);
         }
-        return clone;
+    }
+
+    private static boolean findPath(Node current, Node target, List<Node> path) {
+        path.add(current);
+        if (current == target) {
+            return true;
+        }
+        for (Node child : current.getChildren()) {
+            if (child != null && findPath(child, target, path)) {
+                return true;
+            }
+        }
+        path.remove(path.size() - 1);
+        return false;
     }
 
     public static List<Node> findNodeChildren(Node node) {
@@ -202,61 +375,9 @@ public final class NodeUtil {
         return replaceChild(parent, oldChild, newChild, false);
     }
 
-    @SuppressWarnings("deprecation")
     static boolean replaceChild(Node parent, Node oldChild, Node newChild, boolean adopt) {
         CompilerAsserts.neverPartOfCompilation();
-        NodeClass nodeClass = parent.getNodeClass();
-
-        for (NodeFieldAccessor nodeField : nodeClass.getChildFields()) {
-            if (nodeField.getObject(parent) == oldChild) {
-                assert assertAssignable(nodeField, newChild);
-                if (adopt) {
-                    parent.adoptHelper(newChild);
-                }
-                nodeField.putObject(parent, newChild);
-                return true;
-            }
-        }
-
-        for (NodeFieldAccessor nodeField : nodeClass.getChildrenFields()) {
-            Object arrayObject = nodeField.getObject(parent);
-            if (arrayObject != null) {
-                Object[] array = (Object[]) arrayObject;
-                for (int i = 0; i < array.length; i++) {
-                    if (array[i] == oldChild) {
-                        assert assertAssignable(nodeField, newChild);
-                        if (adopt) {
-                            parent.adoptHelper(newChild);
-                        }
-                        array[i] = newChild;
-                        return true;
-                    }
-                }
-            }
-        }
-        return false;
-    }
-
-    private static boolean assertAssignable(NodeFieldAccessor field, Object newValue) {
-        if (newValue == null) {
-            return true;
-        }
-        if (field.getKind() == NodeFieldKind.CHILD) {
-            if (field.getType().isAssignableFrom(newValue.getClass())) {
-                return true;
-            } else {
-                assert false : "Child class " + newValue.getClass().getName() + " is not assignable to field \"" + field.getName() + "\" of type " + field.getType().getName();
-                return false;
-            }
-        } else if (field.getKind() == NodeFieldKind.CHILDREN) {
-            if (field.getType().getComponentType().isAssignableFrom(newValue.getClass())) {
-                return true;
-            } else {
-                assert false : "Child class " + newValue.getClass().getName() + " is not assignable to field \"" + field.getName() + "\" of type " + field.getType().getName();
-                return false;
-            }
-        }
-        throw new IllegalArgumentException();
+        return parent.getNodeClass().replaceChild(parent, oldChild, newChild, adopt);
     }
 
     /**
@@ -317,71 +438,27 @@ public final class NodeUtil {
     public static boolean forEachChild(Node parent, NodeVisitor visitor) {
         CompilerAsserts.neverPartOfCompilation();
         Objects.requireNonNull(visitor);
-        NodeClass parentNodeClass = parent.getNodeClass();
-
-        for (NodeFieldAccessor field : parentNodeClass.getChildFields()) {
-            Object child = field.getObject(parent);
-            if (child != null) {
-                if (!visitor.visit((Node) child)) {
-                    return false;
-                }
-            }
-        }
-
-        for (NodeFieldAccessor field : parentNodeClass.getChildrenFields()) {
-            Object arrayObject = field.getObject(parent);
-            if (arrayObject != null) {
-                Object[] array = (Object[]) arrayObject;
-                for (int i = 0; i < array.length; i++) {
-                    Object child = array[i];
-                    if (child != null) {
-                        if (!visitor.visit((Node) child)) {
-                            return false;
-                        }
-                    }
-                }
-            }
-        }
-
-        return true;
+        return parent.getNodeClass().forEachChild(parent, visitor);
     }
 
     static boolean forEachChildRecursive(Node parent, NodeVisitor visitor) {
-        NodeClass parentNodeClass = parent.getNodeClass();
-
-        for (NodeFieldAccessor field : parentNodeClass.getChildFields()) {
-            if (!visitChild((Node) field.getObject(parent), visitor)) {
-                return false;
-            }
-        }
+        return parent.getNodeClass().forEachChild(parent, new RecursiveVisitor(visitor));
+    }
 
-        for (NodeFieldAccessor field : parentNodeClass.getChildrenFields()) {
-            Object arrayObject = field.getObject(parent);
-            if (arrayObject == null) {
-                continue;
-            }
-            Object[] array = (Object[]) arrayObject;
-            for (int i = 0; i < array.length; i++) {
-                if (!visitChild((Node) array[i], visitor)) {
-                    return false;
-                }
-            }
-        }
+    private static final class RecursiveVisitor implements NodeVisitor {
 
-        return true;
-    }
+        private final NodeVisitor visitor;
 
-    private static boolean visitChild(Node child, NodeVisitor visitor) {
-        if (child == null) {
-            return true;
-        }
-        if (!visitor.visit(child)) {
-            return false;
+        RecursiveVisitor(NodeVisitor visitor) {
+            this.visitor = visitor;
         }
-        if (!forEachChildRecursive(child, visitor)) {
-            return false;
+
+        public boolean visit(Node child) {
+            if (!visitor.visit(child)) {
+                return false;
+            }
+            return child.getNodeClass().forEachChild(child, this);
         }
-        return true;
     }
 
     public static <T> T[] concat(T[] first, T[] second) {
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes;
+
+import java.io.PrintStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+import com.oracle.truffle.api.CompilerAsserts;
+import com.oracle.truffle.api.TruffleOptions;
+import com.oracle.truffle.api.source.SourceSection;
+
+/**
+ * Aggregates {@linkplain Node#replace(Node, CharSequence) node rewrites} by site, where a site is
+ * identified by its {@link RootNode} and {@linkplain Node#getEncapsulatingSourceSection() source
+ * section}. For every site the profiler counts the rewrites for each combination of node class and
+ * {@link NodeCost} transition, and flags the site as <em>unstable</em> once a rewrite returns it to
+ * a state it left earlier; a site that keeps flipping between specializations never stabilizes and
+ * is invalidated over and over.
+ * <p>
+ * Rewrites of nodes whose cost is {@link NodeCost#NONE}, such as the specialization chain of a DSL
+ * generated node, are attributed to the nearest enclosing node that reports a cost, so that
+ * specialization inserts, merges and removals are reported against the specialized node itself.
+ * <p>
+ * Enabled with {@code -Dtruffle.ProfileRewrites=true}, in which case a report is printed to
+ * {@link System#out} at shutdown. A profiler can also be {@linkplain #install(RewriteProfiler)
+ * installed} programmatically and {@linkplain #print(PrintStream, int) printed} on demand.
+ */
+public final class RewriteProfiler {
+
+    private static volatile RewriteProfiler instance;
+
+    /** Rewrite counts per site, in order of the first rewrite. */
+    private final Map<SiteKey, SiteRecord> sites = new LinkedHashMap<>();
+
+    /**
+     * Returns the profiler that is notified of node rewrites, or {@code null} if rewrites are not
+     * profiled.
+     */
+    public static RewriteProfiler getInstance() {
+        return instance;
+    }
+
+    /**
+     * Sets the profiler that is notified of node rewrites; {@code null} disables profiling.
+     */
+    public static void install(RewriteProfiler profiler) {
+        instance = profiler;
+    }
+
+    /**
+     * Rewrite counts at a single site.
+     */
+    public interface RewriteSite {
+        RootNode rootNode();
+
+        /** The source section of the site, {@code null} if not available. */
+        SourceSection sourceSection();
+
+        long rewriteCount();
+
+        /** Number of rewrites that returned the site to a state it left earlier. */
+        long flipCount();
+
+        /** Whether the site was rewritten back to a state it left earlier. */
+        boolean isUnstable();
+
+        /** The reason given for the most recent rewrite. */
+        String lastReason();
+
+        RewriteTransition[] transitions();
+    }
+
+    /**
+     * Count of rewrites of a particular node class from one cost to another.
+     */
+    public interface RewriteTransition {
+        Class<?> nodeClass();
+
+        NodeCost fromCost();
+
+        NodeCost toCost();
+
+        long count();
+    }
+
+    /**
+     * Gets a modification-safe summary of the current rewrite counts; does not affect the counts.
+     */
+    public synchronized RewriteSite[] getSites() {
+        final RewriteSite[] result = new RewriteSite[sites.size()];
+        int i = 0;
+        for (Map.Entry<SiteKey, SiteRecord> entry : sites.entrySet()) {
+            result[i++] = new RewriteSiteImpl(entry.getKey(), entry.getValue());
+        }
+        return result;
+    }
+
+    /**
+     * Discards all rewrite counts.
+     */
+    public synchronized void reset() {
+        sites.clear();
+    }
+
+    /**
+     * A default printer for the current rewrite counts, listing every site in descending order of
+     * rewrite count.
+     */
+    public void print(PrintStream out) {
+        print(out, Integer.MAX_VALUE);
+    }
+
+    /**
+     * A default printer for the current rewrite counts, listing sites in descending order of
+     * rewrite count, each followed by lines of the form
+     * " <count> : <node class> <from cost> -> <to cost>". Unstable sites are marked with "!".
+     *
+     * @param out
+     * @param topN the maximum number of sites to describe
+     */
+    public void print(PrintStream out, int topN) {
+        final RewriteSite[] sorted = getSites();
+        Arrays.sort(sorted, new Comparator<RewriteSite>() {
+
+            public int compare(RewriteSite o1, RewriteSite o2) {
+                return Long.compare(o2.rewriteCount(), o1.rewriteCount());
+            }
+        });
+        int unstable = 0;
+        for (RewriteSite site : sorted) {
+            if (site.isUnstable()) {
+                unstable++;
+            }
+        }
+        out.println();
+        out.println("Node rewrites by site (" + sorted.length + " sites, " + unstable + " unstable):");
+        final int count = Math.min(topN, sorted.length);
+        for (int i = 0; i < count; i++) {
+            final RewriteSite site = sorted[i];
+            final SourceSection section = site.sourceSection();
+            out.format("%s%11d : %s at %s%n", site.isUnstable() ? "!" : " ", site.rewriteCount(), site.rootNode(), section == null ? "<unknown>" : section.getShortDescription());
+            if (site.isUnstable()) {
+                out.format("%14s %d flips, last reason: %s%n", "", site.flipCount(), site.lastReason());
+            }
+            for (RewriteTransition transition : site.transitions()) {
+                out.format("%14s %6d : %s %s -> %s%n", "", transition.count(), transition.nodeClass().getSimpleName(), transition.fromCost(), transition.toCost());
+            }
+        }
+        if (count < sorted.length) {
+            out.println("(" + (sorted.length - count) + " more sites not shown)");
+        }
+    }
+
+    /**
+     * Called by {@link Node} after a replacement, inside the atomic block of the rewrite.
+     */
+    synchronized void nodeReplaced(Node oldNode, Node newNode, CharSequence reason) {
+        CompilerAsserts.neverPartOfCompilation();
+        Node site = null;
+        if (oldNode.getCost() == NodeCost.NONE && newNode.getCost() == NodeCost.NONE) {
+            site = newNode.getParent();
+            while (site != null && site.getCost() == NodeCost.NONE) {
+                site = site.getParent();
+            }
+            if (site instanceof RootNode) {
+                site = null;
+            }
+        }
+        final SourceSection section;
+        final SiteKey key;
+        if (site == null) {
+            section = newNode.getEncapsulatingSourceSection();
+            key = new SiteKey(newNode.getRootNode(), section, section == null ? newNode.getParent() : null);
+        } else {
+            section = site.getEncapsulatingSourceSection();
+            key = new SiteKey(site.getRootNode(), section, section == null ? site : null);
+        }
+        SiteRecord record = sites.get(key);
+        if (record == null) {
+            record = new SiteRecord();
+            sites.put(key, record);
+        }
+        if (site == null) {
+            record.rewrite(oldNode.getClass(), oldNode.getCost(), newNode.getClass(), newNode.getCost(), reason);
+        } else {
+            final NodeCost fromCost = record.lastCost == null ? NodeCost.UNINITIALIZED : record.lastCost;
+            record.rewrite(site.getClass(), fromCost, site.getClass(), site.getCost(), reason);
+        }
+    }
+
+    private static final class SiteKey {
+
+        private final RootNode rootNode;
+        private final SourceSection sourceSection;
+        private final Node anchor; // Distinguishes sites without source section.
+
+        SiteKey(RootNode rootNode, SourceSection sourceSection, Node anchor) {
+            this.rootNode = rootNode;
+            this.sourceSection = sourceSection;
+            this.anchor = anchor;
+        }
+
+        @Override
+        public int hashCode() {
+            int result = System.identityHashCode(rootNode);
+            result = 31 * result + (sourceSection == null ? 0 : sourceSection.hashCode());
+            result = 31 * result + System.identityHashCode(anchor);
+            return result;
+        }
+
+        @Override
+        public boolean equals(Object obj) {
+            if (!(obj instanceof SiteKey)) {
+                return false;
+            }
+            final SiteKey other = (SiteKey) obj;
+            return rootNode == other.rootNode && anchor == other.anchor && (sourceSection == null ? other.sourceSection == null : sourceSection.equals(other.sourceSection));
+        }
+    }
+
+    private static final class SiteRecord {
+
+        private final Map<TransitionKey, long[]> transitions = new LinkedHashMap<>();
+        private final Set<TransitionKey> leftStates = new HashSet<>(); // (class, cost) left earlier
+        private long rewrites;
+        private long flips;
+        private NodeCost lastCost;
+        private String lastReason;
+
+        void rewrite(Class<?> fromClass, NodeCost fromCost, Class<?> toClass, NodeCost toCost, CharSequence reason) {
+            rewrites++;
+            final TransitionKey transition = new TransitionKey(fromClass, fromCost, toCost);
+            long[] count = transitions.get(transition);
+            if (count == null) {
+                count = new long[1];
+                transitions.put(transition, count);
+            }
+            count[0]++;
+            final TransitionKey from = new TransitionKey(fromClass, fromCost, null);
+            final TransitionKey to = new TransitionKey(toClass, toCost, null);
+            if (!from.equals(to)) {
+                // Growing a polymorphic cache rewrites a site without changing its state.
+                leftStates.add(from);
+                if (leftStates.contains(to)) {
+                    flips++;
+                }
+            }
+            lastCost = toCost;
+            // Do not keep the reason itself, DSL rewrite events refer to the frame.
+            lastReason = reason == null ? null : reason.toString();
+        }
+    }
+
+    private static final class TransitionKey {
+
+        private final Class<?> nodeClass;
+        private final NodeCost fromCost;
+        private final NodeCost toCost;
+
+        TransitionKey(Class<?> nodeClass, NodeCost fromCost, NodeCost toCost) {
+            this.nodeClass = nodeClass;
+            this.fromCost = fromCost;
+            this.toCost = toCost;
+        }
+
+        @Override
+        public int hashCode() {
+            int result = nodeClass.hashCode();
+            result = 31 * result + (fromCost == null ? 0 : fromCost.hashCode());
+            result = 31 * result + (toCost == null ? 0 : toCost.hashCode());
+            return result;
+        }
+
+        @Override
+        public boolean equals(Object obj) {
+            if (!(obj instanceof TransitionKey)) {
+                return false;
+            }
+            final TransitionKey other = (TransitionKey) obj;
+            return nodeClass == other.nodeClass && fromCost == other.fromCost && toCost == other.toCost;
+        }
+    }
+
+    private static final class RewriteSiteImpl implements RewriteSite {
+
+        private final RootNode rootNode;
+        private final SourceSection sourceSection;
+        private final long rewrites;
+        private final long flips;
+        private final String lastReason;
+        private final RewriteTransition[] transitions;
+
+        RewriteSiteImpl(SiteKey key, SiteRecord record) {
+            this.rootNode = key.rootNode;
+            this.sourceSection = key.sourceSection;
+            this.rewrites = record.rewrites;
+            this.flips = record.flips;
+            this.lastReason = record.lastReason == null || record.lastReason.isEmpty() ? "unknown" : record.lastReason;
+            final List<RewriteTransition> list = new ArrayList<>();
+            for (Map.Entry<TransitionKey, long[]> entry : record.transitions.entrySet()) {
+                list.add(new RewriteTransitionImpl(entry.getKey(), entry.getValue()[0]));
+            }
+            this.transitions = list.toArray(new RewriteTransition[list.size()]);
+        }
+
+        public RootNode rootNode() {
+            return rootNode;
+        }
+
+        public SourceSection sourceSection() {
+            return sourceSection;
+        }
+
+        public long rewriteCount() {
+            return rewrites;
+        }
+
+        public long flipCount() {
+            return flips;
+        }
+
+        public boolean isUnstable() {
+            return flips > 0;
+        }
+
+        public String lastReason() {
+            return lastReason;
+        }
+
+        public RewriteTransition[] transitions() {
+            return transitions.clone();
+        }
+    }
+
+    private static final class RewriteTransitionImpl implements RewriteTransition {
+
+        private final TransitionKey key;
+        private final long count;
+
+        RewriteTransitionImpl(TransitionKey key, long count) {
+            this.key = key;
+            this.count = count;
+        }
+
+        public Class<?> nodeClass() {
+            return key.nodeClass;
+        }
+
+        public NodeCost fromCost() {
+            return key.fromCost;
+        }
+
+        public NodeCost toCost() {
+            return key.toCost;
+        }
+
+        public long count() {
+            return count;
+        }
+    }
+
+    static {
+        if (TruffleOptions.ProfileRewrites) {
+            instance = new RewriteProfiler();
+            Runtime.getRuntime().addShutdownHook(new Thread() {
+                @Override
+                public void run() {
+                    final RewriteProfiler profiler = getInstance();
+                    if (profiler != null) {
+                        profiler.print(System.out, TruffleOptions.ProfileRewritesTopResults);
+                    }
+                }
+            });
+        }
+    }
+}
@@ -46,7 +46,7 @@ import com.oracle.truffle.api.source.SourceSection;
 @SuppressWarnings("rawtypes")
 public abstract class RootNode extends Node {
     final Class<? extends TruffleLanguage> language;
-    private RootCallTarget callTarget;
+    private transient RootCallTarget callTarget;
     @CompilationFinal private FrameDescriptor frameDescriptor;
 
     /**
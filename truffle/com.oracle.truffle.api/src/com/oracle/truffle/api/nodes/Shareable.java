@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes;
+
+import java.lang.annotation.ElementType;
+import java.lang.annotation.Inherited;
+import java.lang.annotation.Retention;
+import java.lang.annotation.RetentionPolicy;
+import java.lang.annotation.Target;
+
+/**
+ * Marks a {@link Node} class whose instances do not change anymore once their
+ * {@link Node#getCost() cost} is {@link NodeCost#MONOMORPHIC}. {@link Node#deepCopy() Deep copies}
+ * of a tree share adopted child nodes of such classes, including their subtrees, with the original
+ * tree instead of copying them. A shared node keeps its first parent, so {@link Node#getParent()}
+ * and {@link Node#getRootNode()} of a shared node lead to the tree that owns it.
+ * <p>
+ * Shared nodes are copied on write: {@link Node#replace(Node) replacing} a node below a shared node
+ * first gives the tree of the replaced node private copies of the shared nodes above it, and
+ * probing a tree first copies all nodes it shares with other trees. Use
+ * {@link NodeUtil#materializePath(Node, Node)} to get the private copy of a node for a specific
+ * tree.
+ * <p>
+ * All nodes in the subtree of a shareable node must be shareable as well. The annotation is
+ * inherited by subclasses, including the node classes generated by the DSL.
+ */
+@Inherited
+@Retention(RetentionPolicy.RUNTIME)
+@Target(ElementType.TYPE)
+public @interface Shareable {
+}
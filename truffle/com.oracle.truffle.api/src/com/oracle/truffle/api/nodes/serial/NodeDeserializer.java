@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes.serial;
+
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.ARRAY;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.BIG_INTEGER;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.BOOLEAN;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.BYTE;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.CHAR;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.CLASS;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.CLONEABLE;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.CONSTANT;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.DOUBLE;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.ENUM;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.FLOAT;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.FRAME_DESCRIPTOR;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.FRAME_SLOT;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.INT;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.LONG;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.MAGIC;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.NODE;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.NULL;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.SHORT;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.SOURCE;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.SOURCE_SECTION;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.STRING;
+import static com.oracle.truffle.api.nodes.serial.NodeSerializer.VERSION;
+
+import java.io.DataInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.reflect.Array;
+import java.lang.reflect.Field;
+import java.math.BigInteger;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import sun.misc.Unsafe;
+
+import com.oracle.truffle.api.frame.FrameDescriptor;
+import com.oracle.truffle.api.frame.FrameSlotKind;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.NodeClass;
+import com.oracle.truffle.api.nodes.NodeCloneable;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.Source;
+
+/**
+ * Reads ASTs written by {@link NodeSerializer}. Nodes are allocated without running their
+ * constructors and all their serialized fields, including the parent, are restored, so the
+ * returned root nodes are ready to be passed to
+ * {@link com.oracle.truffle.api.TruffleRuntime#createCallTarget(RootNode)}.
+ *
+ * @see NodeSerializer
+ */
+public final class NodeDeserializer {
+
+    private static final Unsafe UNSAFE = getUnsafe();
+
+    private static final int INITIAL_CAPACITY = 1024;
+
+    private static final Map<String, Class<?>> PRIMITIVE_TYPES = new HashMap<>();
+
+    static {
+        for (Class<?> type : new Class<?>[]{boolean.class, byte.class, short.class, char.class, int.class, long.class, float.class, double.class, void.class}) {
+            PRIMITIVE_TYPES.put(type.getName(), type);
+        }
+    }
+
+    private final Source source;
+    private final ClassLoader classLoader;
+    private final DataInputStream in;
+    private Node[] nodes;
+    private FrameDescriptor[] descriptors;
+
+    private NodeDeserializer(Source source, ClassLoader classLoader, DataInputStream in) {
+        this.source = source;
+        this.classLoader = classLoader;
+        this.in = in;
+    }
+
+    /**
+     * Reads the root nodes written by {@link NodeSerializer#write} for <code>source</code>.
+     *
+     * @param classLoader the class loader to load node classes with
+     * @throws IOException if reading fails, the stream holds no or a corrupt serialized AST or the
+     *             AST was written for a different content of the source
+     */
+    public static List<RootNode> read(Source source, InputStream in, ClassLoader classLoader) throws IOException {
+        try {
+            return new NodeDeserializer(source, classLoader, new DataInputStream(in)).readRoots();
+        } catch (IndexOutOfBoundsException | ClassCastException | IllegalArgumentException e) {
+            throw new IOException("Corrupt serialized AST", e);
+        }
+    }
+
+    private List<RootNode> readRoots() throws IOException {
+        if (in.readInt() != MAGIC) {
+            throw new IOException("Not a serialized AST");
+        }
+        int version = in.readInt();
+        if (version != VERSION) {
+            throw new IOException("Unsupported serialized AST version " + version);
+        }
+        if (!readString().equals(NodeSerializer.getContentHash(source))) {
+            throw new IOException("Serialized AST does not match the content of " + source.getName());
+        }
+
+        int nodeCount = readLength();
+        List<Node> nodeList = new ArrayList<>(initialCapacity(nodeCount));
+        for (int i = 0; i < nodeCount; i++) {
+            nodeList.add(allocateNode(loadClass(readString())));
+        }
+        nodes = nodeList.toArray(new Node[nodeList.size()]);
+
+        int descriptorCount = readLength();
+        List<FrameDescriptor> descriptorList = new ArrayList<>(initialCapacity(descriptorCount));
+        for (int i = 0; i < descriptorCount; i++) {
+            FrameDescriptor descriptor = new FrameDescriptor(readValue());
+            int slotCount = readLength();
+            for (int j = 0; j < slotCount; j++) {
+                Object identifier = readValue();
+                Object info = readValue();
+                descriptor.addFrameSlot(identifier, info, FrameSlotKind.valueOf(readString()));
+            }
+            int parameterCount = readLength();
+            for (int j = 0; j < parameterCount; j++) {
+                descriptor.addParameterSlot(descriptor.getSlots().get(in.readInt()));
+            }
+            descriptorList.add(descriptor);
+        }
+        descriptors = descriptorList.toArray(new FrameDescriptor[descriptorList.size()]);
+
+        for (Node node : nodes) {
+            readFields(node, NodeSerializer.getNodeFields(node.getClass()));
+        }
+
+        int rootCount = readLength();
+        List<RootNode> roots = new ArrayList<>(initialCapacity(rootCount));
+        for (int i = 0; i < rootCount; i++) {
+            Node root = nodes[in.readInt()];
+            if (!(root instanceof RootNode)) {
+                throw new IOException("Not a root node: " + root.getClass().getName());
+            }
+            roots.add((RootNode) root);
+        }
+        return roots;
+    }
+
+    @SuppressWarnings({"unchecked", "deprecation"})
+    private static Node allocateNode(Class<?> clazz) throws IOException {
+        if (!Node.class.isAssignableFrom(clazz)) {
+            throw new IOException("Not a node class: " + clazz.getName());
+        }
+        Node node = (Node) allocate(clazz);
+        NodeClass nodeClass = NodeClass.get((Class<? extends Node>) clazz);
+        nodeClass.getNodeClassField().putObject(node, nodeClass);
+        return node;
+    }
+
+    private static Object allocate(Class<?> clazz) throws IOException {
+        try {
+            return UNSAFE.allocateInstance(clazz);
+        } catch (InstantiationException e) {
+            throw new IOException("Cannot allocate " + clazz.getName(), e);
+        }
+    }
+
+    private void readFields(Object object, Field[] fields) throws IOException {
+        for (Field field : fields) {
+            Object value = readValue();
+            try {
+                field.set(object, value);
+            } catch (IllegalArgumentException | IllegalAccessException e) {
+                throw new IOException("Cannot restore field " + field.getDeclaringClass().getName() + "." + field.getName(), e);
+            }
+        }
+    }
+
+    @SuppressWarnings({"unchecked", "rawtypes"})
+    private Object readValue() throws IOException {
+        byte tag = in.readByte();
+        switch (tag) {
+            case NULL:
+                return null;
+            case BOOLEAN:
+                return in.readBoolean();
+            case BYTE:
+                return in.readByte();
+            case SHORT:
+                return in.readShort();
+            case CHAR:
+                return in.readChar();
+            case INT:
+                return in.readInt();
+            case LONG:
+                return in.readLong();
+            case FLOAT:
+                return in.readFloat();
+            case DOUBLE:
+                return in.readDouble();
+            case STRING:
+                return readString();
+            case BIG_INTEGER:
+                return new BigInteger(readBytes(readLength()));
+            case ENUM:
+                Class enumClass = loadClass(readString());
+                String name = readString();
+                if (!enumClass.isEnum()) {
+                    throw new IOException("Not an enum class: " + enumClass.getName());
+                }
+                return Enum.valueOf(enumClass, name);
+            case CLASS:
+                return loadClass(readString());
+            case NODE:
+                return nodes[in.readInt()];
+            case FRAME_DESCRIPTOR:
+                return descriptors[in.readInt()];
+            case FRAME_SLOT:
+                FrameDescriptor descriptor = descriptors[in.readInt()];
+                return descriptor.getSlots().get(in.readInt());
+            case SOURCE_SECTION:
+                String identifier = (String) readValue();
+                int charIndex = in.readInt();
+                int charLength = in.readInt();
+                return source.createSection(identifier, charIndex, charLength);
+            case SOURCE:
+                return source;
+            case ARRAY:
+                Class<?> componentType = loadClass(readString());
+                int length = readLength();
+                List<Object> elements = new ArrayList<>(initialCapacity(length));
+                for (int i = 0; i < length; i++) {
+                    elements.add(readValue());
+                }
+                Object array = Array.newInstance(componentType, length);
+                for (int i = 0; i < length; i++) {
+                    Array.set(array, i, elements.get(i));
+                }
+                return array;
+            case CLONEABLE:
+                Class<?> cloneableClass = loadClass(readString());
+                if (!NodeCloneable.class.isAssignableFrom(cloneableClass)) {
+                    throw new IOException("Not a node cloneable class: " + cloneableClass.getName());
+                }
+                Object cloneable = allocate(cloneableClass);
+                readFields(cloneable, NodeSerializer.getCloneableFields(cloneableClass));
+                return cloneable;
+            case CONSTANT:
+                Class<?> declaringClass = loadClass(readString());
+                String fieldName = readString();
+                try {
+                    Field field = declaringClass.getDeclaredField(fieldName);
+                    field.setAccessible(true);
+                    return field.get(null);
+                } catch (NoSuchFieldException | IllegalAccessException e) {
+                    throw new IOException("Cannot load constant " + declaringClass.getName() + "." + fieldName, e);
+                }
+            default:
+                throw new IOException("Unknown value tag " + tag);
+        }
+    }
+
+    private Class<?> loadClass(String name) throws IOException {
+        Class<?> primitive = PRIMITIVE_TYPES.get(name);
+        if (primitive != null) {
+            return primitive;
+        }
+        try {
+            return Class.forName(name, false, classLoader);
+        } catch (ClassNotFoundException e) {
+            throw new IOException("Cannot load class " + name, e);
+        }
+    }
+
+    private String readString() throws IOException {
+        int length = readLength();
+        StringBuilder chars = new StringBuilder(initialCapacity(length));
+        for (int i = 0; i < length; i++) {
+            chars.append(in.readChar());
+        }
+        return chars.toString();
+    }
+
+    private byte[] readBytes(int length) throws IOException {
+        byte[] bytes = new byte[initialCapacity(length)];
+        in.readFully(bytes);
+        while (bytes.length < length) {
+            int read = bytes.length;
+            bytes = Arrays.copyOf(bytes, (int) Math.min(length, 2L * read));
+            in.readFully(bytes, read, bytes.length - read);
+        }
+        return bytes;
+    }
+
+    /**
+     * Reads the length of a sequence. Lengths come from a file that may be corrupt, so storage for
+     * a sequence is never allocated up front: it grows with the elements actually read, and a
+     * length beyond the end of the stream ends in an {@link java.io.EOFException} instead of a huge
+     * allocation.
+     */
+    private int readLength() throws IOException {
+        int length = in.readInt();
+        if (length < 0) {
+            throw new IOException("Corrupt serialized AST: negative length " + length);
+        }
+        return length;
+    }
+
+    private static int initialCapacity(int length) {
+        return Math.min(length, INITIAL_CAPACITY);
+    }
+
+    private static Unsafe getUnsafe() {
+        try {
+            return Unsafe.getUnsafe();
+        } catch (SecurityException e) {
+        }
+        try {
+            Field theUnsafeInstance = Unsafe.class.getDeclaredField("theUnsafe");
+            theUnsafeInstance.setAccessible(true);
+            return (Unsafe) theUnsafeInstance.get(Unsafe.class);
+        } catch (Exception e) {
+            throw new RuntimeException("exception while trying to get Unsafe.theUnsafe via reflection:", e);
+        }
+    }
+}
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.nodes.serial;
+
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.lang.reflect.Array;
+import java.lang.reflect.Field;
+import java.lang.reflect.Modifier;
+import java.math.BigInteger;
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.ArrayList;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.Map;
+
+import com.oracle.truffle.api.frame.FrameDescriptor;
+import com.oracle.truffle.api.frame.FrameSlot;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.NodeClass;
+import com.oracle.truffle.api.nodes.NodeCloneable;
+import com.oracle.truffle.api.nodes.NodeFieldAccessor;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.source.SourceSection;
+
+/**
+ * Writes the ASTs parsed from a {@link Source} in a binary format that {@link NodeDeserializer}
+ * reads back without parsing the source again.
+ * <p>
+ * The fields of each node are the {@linkplain NodeClass#getFields() fields} described by its
+ * {@link NodeClass} plus its {@linkplain NodeClass#getParentField() parent}; <code>transient</code>
+ * fields are skipped and keep their default value. Nodes are written once and referenced by index,
+ * so nodes that are referenced by data fields but are not part of the tree are preserved as well.
+ * Field values may be primitives, strings, {@link BigInteger}s, enum constants, classes, nodes,
+ * {@link FrameDescriptor}s, {@link FrameSlot}s, {@link SourceSection}s of the serialized source,
+ * {@link NodeCloneable} objects such as profiles and arrays of these. Objects held by a static final
+ * field of their class, such as disabled profiles or the null value of a language, are restored as
+ * that shared instance. {@link SourceSection}s are written as offsets into the source and frame
+ * slots as indices into their descriptor. ASTs with other values, anonymous or inner node classes
+ * cannot be serialized.
+ * <p>
+ * The output records a {@linkplain #getContentHash(Source) hash} of the source content, so that an
+ * AST is only loaded for the source it was parsed from.
+ *
+ * @see NodeDeserializer
+ */
+public final class NodeSerializer {
+
+    static final int MAGIC = 0x54415354; // "TAST"
+    static final int VERSION = 2;
+
+    static final byte NULL = 0;
+    static final byte BOOLEAN = 1;
+    static final byte BYTE = 2;
+    static final byte SHORT = 3;
+    static final byte CHAR = 4;
+    static final byte INT = 5;
+    static final byte LONG = 6;
+    static final byte FLOAT = 7;
+    static final byte DOUBLE = 8;
+    static final byte STRING = 9;
+    static final byte BIG_INTEGER = 10;
+    static final byte ENUM = 11;
+    static final byte CLASS = 12;
+    static final byte NODE = 13;
+    static final byte FRAME_DESCRIPTOR = 14;
+    static final byte FRAME_SLOT = 15;
+    static final byte SOURCE_SECTION = 16;
+    static final byte SOURCE = 17;
+    static final byte ARRAY = 18;
+    static final byte CLONEABLE = 19;
+    static final byte CONSTANT = 20;
+
+    private static final ClassValue<Field[]> nodeFields = new ClassValue<Field[]>() {
+        @SuppressWarnings("unchecked")
+        @Override
+        protected Field[] computeValue(Class<?> clazz) {
+            NodeClass nodeClass = NodeClass.get((Class<? extends Node>) clazz);
+            List<Field> fields = new ArrayList<>();
+            fields.add(getField(nodeClass.getParentField()));
+            for (NodeFieldAccessor accessor : nodeClass.getFields()) {
+                Field field = getField(accessor);
+                if (!Modifier.isTransient(field.getModifiers())) {
+                    fields.add(field);
+                }
+            }
+            return fields.toArray(new Field[fields.size()]);
+        }
+    };
+
+    private static final ClassValue<Field[]> cloneableFields = new ClassValue<Field[]>() {
+        @Override
+        protected Field[] computeValue(Class<?> clazz) {
+            List<Field> fields = new ArrayList<>();
+            for (Class<?> c = clazz; c != Object.class; c = c.getSuperclass()) {
+                for (Field field : c.getDeclaredFields()) {
+                    int modifiers = field.getModifiers();
+                    if (!Modifier.isStatic(modifiers) && !Modifier.isTransient(modifiers) && !field.isSynthetic()) {
+                        field.setAccessible(true);
+                        fields.add(field);
+                    }
+                }
+            }
+            return fields.toArray(new Field[fields.size()]);
+        }
+    };
+
+    private final Source source;
+    private final Map<Node, Integer> nodeIds = new IdentityHashMap<>();
+    private final List<Node> nodes = new ArrayList<>();
+    private final Map<FrameDescriptor, Integer> descriptorIds = new IdentityHashMap<>();
+    private final List<FrameDescriptor> descriptors = new ArrayList<>();
+
+    private NodeSerializer(Source source) {
+        this.source = source;
+    }
+
+    /**
+     * Writes the given root nodes and all nodes reachable from them. The roots are expected to be
+     * freshly parsed from <code>source</code>.
+     *
+     * @throws IOException if writing fails or the ASTs hold values that cannot be serialized
+     */
+    public static void write(Source source, List<? extends RootNode> roots, OutputStream out) throws IOException {
+        new NodeSerializer(source).writeRoots(roots, new DataOutputStream(out));
+    }
+
+    /**
+     * Gets a hash of the content of a source, as recorded by {@link #write}. It identifies a
+     * serialized AST independently of the name or location of the source.
+     */
+    public static String getContentHash(Source source) {
+        try {
+            byte[] digest = MessageDigest.getInstance("SHA-1").digest(source.getCode().getBytes(StandardCharsets.UTF_8));
+            StringBuilder hash = new StringBuilder(digest.length * 2);
+            for (byte b : digest) {
+                hash.append(Character.forDigit((b >> 4) & 0xF, 16)).append(Character.forDigit(b & 0xF, 16));
+            }
+            return hash.toString();
+        } catch (NoSuchAlgorithmException e) {
+            throw new AssertionError(e);
+        }
+    }
+
+    static Field[] getNodeFields(Class<?> nodeClass) {
+        return nodeFields.get(nodeClass);
+    }
+
+    static Field[] getCloneableFields(Class<?> cloneableClass) {
+        return cloneableFields.get(cloneableClass);
+    }
+
+    private static Field getField(NodeFieldAccessor accessor) {
+        try {
+            Field field = accessor.getDeclaringClass().getDeclaredField(accessor.getName());
+            field.setAccessible(true);
+            return field;
+        } catch (NoSuchFieldException e) {
+            throw new AssertionError(e);
+        }
+    }
+
+    private void writeRoots(List<? extends RootNode> roots, DataOutputStream out) throws IOException {
+        for (RootNode root : roots) {
+            collect(root);
+        }
+
+        out.writeInt(MAGIC);
+        out.writeInt(VERSION);
+        writeString(out, getContentHash(source));
+
+        out.writeInt(nodes.size());
+        for (Node node : nodes) {
+            writeString(out, node.getClass().getName());
+        }
+
+        out.writeInt(descriptors.size());
+        for (FrameDescriptor descriptor : descriptors) {
+            writeValue(out, descriptor.getDefaultValue());
+            out.writeInt(descriptor.getSlots().size());
+            for (FrameSlot slot : descriptor.getSlots()) {
+                writeValue(out, slot.getIdentifier());
+                writeValue(out, slot.getInfo());
+                writeString(out, slot.getKind().name());
+            }
+            out.writeInt(descriptor.getParameterSlots().size());
+            for (FrameSlot parameter : descriptor.getParameterSlots()) {
+                out.writeInt(descriptor.getSlots().indexOf(parameter));
+            }
+        }
+
+        for (Node node : nodes) {
+            writeFields(out, node, getNodeFields(node.getClass()));
+        }
+
+        out.writeInt(roots.size());
+        for (RootNode root : roots) {
+            out.writeInt(nodeIds.get(root));
+        }
+        out.flush();
+    }
+
+    private void collect(Object value) throws IOException {
+        if (value instanceof Node) {
+            Node node = (Node) value;
+            if (!nodeIds.containsKey(node)) {
+                checkSerializable(node.getClass());
+                nodeIds.put(node, nodes.size());
+                nodes.add(node);
+                collectFields(node, getNodeFields(node.getClass()));
+            }
+        } else if (value instanceof FrameDescriptor) {
+            FrameDescriptor descriptor = (FrameDescriptor) value;
+            if (!descriptorIds.containsKey(descriptor)) {
+                descriptorIds.put(descriptor, descriptors.size());
+                descriptors.add(descriptor);
+                collect(descriptor.getDefaultValue());
+                for (FrameSlot slot : descriptor.getSlots()) {
+                    collect(slot.getIdentifier());
+                    collect(slot.getInfo());
+                }
+            }
+        } else if (value instanceof FrameSlot) {
+            collect(((FrameSlot) value).getFrameDescriptor());
+        } else if (value instanceof Object[]) {
+            for (Object element : (Object[]) value) {
+                collect(element);
+            }
+        } else if (value instanceof NodeCloneable) {
+            checkSerializable(value.getClass());
+            collectFields(value, getCloneableFields(value.getClass()));
+        }
+    }
+
+    private void collectFields(Object object, Field[] fields) throws IOException {
+        for (Field field : fields) {
+            collect(getValue(object, field));
+        }
+    }
+
+    private static void checkSerializable(Class<?> clazz) throws IOException {
+        if (clazz.isAnonymousClass() || clazz.isLocalClass() || (clazz.isMemberClass() && !Modifier.isStatic(clazz.getModifiers()))) {
+            throw new IOException("Cannot serialize instances of anonymous or inner class " + clazz.getName());
+        }
+    }
+
+    private void writeFields(DataOutputStream out, Object object, Field[] fields) throws IOException {
+        for (Field field : fields) {
+            try {
+                writeValue(out, getValue(object, field));
+            } catch (UnsupportedValueException e) {
+                throw new IOException("Cannot serialize field " + field.getDeclaringClass().getName() + "." + field.getName() + ": " + e.getMessage());
+            }
+        }
+    }
+
+    private static Object getValue(Object object, Field field) {
+        try {
+            return field.get(object);
+        } catch (IllegalAccessException e) {
+            throw new AssertionError(e);
+        }
+    }
+
+    private void writeValue(DataOutputStream out, Object value) throws IOException {
+        if (value == null) {
+            out.writeByte(NULL);
+        } else if (value instanceof Boolean) {
+            out.writeByte(BOOLEAN);
+            out.writeBoolean((Boolean) value);
+        } else if (value instanceof Byte) {
+            out.writeByte(BYTE);
+            out.writeByte((Byte) value);
+        } else if (value instanceof Short) {
+            out.writeByte(SHORT);
+            out.writeShort((Short) value);
+        } else if (value instanceof Character) {
+            out.writeByte(CHAR);
+            out.writeChar((Character) value);
+        } else if (value instanceof Integer) {
+            out.writeByte(INT);
+            out.writeInt((Integer) value);
+        } else if (value instanceof Long) {
+            out.writeByte(LONG);
+            out.writeLong((Long) value);
+        } else if (value instanceof Float) {
+            out.writeByte(FLOAT);
+            out.writeFloat((Float) value);
+        } else if (value instanceof Double) {
+            out.writeByte(DOUBLE);
+            out.writeDouble((Double) value);
+        } else if (value instanceof String) {
+            out.writeByte(STRING);
+            writeString(out, (String) value);
+        } else if (value instanceof BigInteger) {
+            byte[] bytes = ((BigInteger) value).toByteArray();
+            out.writeByte(BIG_INTEGER);
+            out.writeInt(bytes.length);
+            out.write(bytes);
+        } else if (value instanceof Enum) {
+            out.writeByte(ENUM);
+            writeString(out, ((Enum<?>) value).getDeclaringClass().getName());
+            writeString(out, ((Enum<?>) value).name());
+        } else if (value instanceof Class) {
+            out.writeByte(CLASS);
+            writeString(out, ((Class<?>) value).getName());
+        } else if (value instanceof Node) {
+            out.writeByte(NODE);
+            out.writeInt(nodeIds.get(value));
+        } else if (value instanceof FrameDescriptor) {
+            out.writeByte(FRAME_DESCRIPTOR);
+            out.writeInt(descriptorIds.get(value));
+        } else if (value instanceof FrameSlot) {
+            FrameSlot slot = (FrameSlot) value;
+            out.writeByte(FRAME_SLOT);
+            out.writeInt(descriptorIds.get(slot.getFrameDescriptor()));
+            out.writeInt(slot.getFrameDescriptor().getSlots().indexOf(slot));
+        } else if (value instanceof SourceSection) {
+            SourceSection section = (SourceSection) value;
+            if (!source.equals(section.getSource())) {
+                throw new UnsupportedValueException("source section " + section.getShortDescription() + " is not in " + source.getName());
+            }
+            out.writeByte(SOURCE_SECTION);
+            writeValue(out, section.getIdentifier());
+            out.writeInt(section.getCharIndex());
+            out.writeInt(section.getCharLength());
+        } else if (value instanceof Source) {
+            if (!source.equals(value)) {
+                throw new UnsupportedValueException("source " + ((Source) value).getName() + " is not " + source.getName());
+            }
+            out.writeByte(SOURCE);
+        } else if (value.getClass().isArray()) {
+            int length = Array.getLength(value);
+            out.writeByte(ARRAY);
+            writeString(out, value.getClass().getComponentType().getName());
+            out.writeInt(length);
+            for (int i = 0; i < length; i++) {
+                writeValue(out, Array.get(value, i));
+            }
+        } else {
+            Field constant = findConstant(value);
+            if (constant != null) {
+                out.writeByte(CONSTANT);
+                writeString(out, constant.getDeclaringClass().getName());
+                writeString(out, constant.getName());
+            } else if (value instanceof NodeCloneable) {
+                out.writeByte(CLONEABLE);
+                writeString(out, value.getClass().getName());
+                writeFields(out, value, getCloneableFields(value.getClass()));
+            } else {
+                throw new UnsupportedValueException("values of " + value.getClass().getName() + " are not supported");
+            }
+        }
+    }
+
+    /**
+     * Finds the static final field of its class that holds a shared instance, such as a disabled
+     * profile or a guest language null value, so that it is restored as the same instance.
+     */
+    private static Field findConstant(Object value) {
+        for (Field field : value.getClass().getDeclaredFields()) {
+            int modifiers = field.getModifiers();
+            if (Modifier.isStatic(modifiers) && Modifier.isFinal(modifiers) && field.getType().isInstance(value)) {
+                field.setAccessible(true);
+                if (getValue(null, field) == value) {
+                    return field;
+                }
+            }
+        }
+        return null;
+    }
+
+    private static void writeString(DataOutputStream out, String value) throws IOException {
+        out.writeInt(value.length());
+        out.writeChars(value);
+    }
+
+    private static final class UnsupportedValueException extends IOException {
+
+        private static final long serialVersionUID = 1L;
+
+        UnsupportedValueException(String message) {
+            super(message);
+        }
+    }
+}
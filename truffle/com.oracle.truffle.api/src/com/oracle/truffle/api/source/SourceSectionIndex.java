@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.source;
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * An index of values associated with {@link SourceSection}s, organized per {@link Source} as an
+ * interval tree of character positions. Supports queries by line, by character position and by
+ * character range that visit only the parts of the index that can contain a result instead of
+ * scanning all entries.
+ * <p>
+ * Sections without a {@link Source} cannot be indexed. This class is not thread-safe.
+ *
+ * @param <T> type of the indexed values
+ */
+public final class SourceSectionIndex<T> {
+
+    private final Map<Source, Intervals> sources = new HashMap<>();
+
+    /**
+     * Adds a value for a section; a section may be associated with any number of values.
+     *
+     * @throws IllegalArgumentException if the section has no {@link Source}
+     */
+    public void add(SourceSection section, T value) {
+        final Source source = section.getSource();
+        if (source == null) {
+            throw new IllegalArgumentException("Section without source: " + section);
+        }
+        Intervals intervals = sources.get(source);
+        if (intervals == null) {
+            intervals = new Intervals();
+            sources.put(source, intervals);
+        }
+        intervals.add(section.getCharIndex(), section.getCharEndIndex(), value);
+    }
+
+    /**
+     * Removes a value, identified by identity, that was added for a section.
+     *
+     * @return {@code true} if the value was found and removed
+     */
+    public boolean remove(SourceSection section, T value) {
+        final Source source = section.getSource();
+        final Intervals intervals = source == null ? null : sources.get(source);
+        if (intervals == null || !intervals.remove(section.getCharIndex(), section.getCharEndIndex(), value)) {
+            return false;
+        }
+        if (intervals.size == 0) {
+            sources.remove(source);
+        }
+        return true;
+    }
+
+    /**
+     * Removes all entries.
+     */
+    public void clear() {
+        sources.clear();
+    }
+
+    /**
+     * Gets all sources with at least one indexed section.
+     */
+    public Collection<Source> getSources() {
+        return Collections.unmodifiableCollection(new ArrayList<>(sources.keySet()));
+    }
+
+    /**
+     * Gets all values indexed for a source, ordered by the start and then the end of their
+     * sections.
+     */
+    public List<T> findAll(Source source) {
+        final Intervals intervals = sources.get(source);
+        if (intervals == null) {
+            return Collections.emptyList();
+        }
+        return intervals.all();
+    }
+
+    /**
+     * Gets the values whose sections start on a line, ordered by the start and then the end of
+     * their sections.
+     */
+    public List<T> findStartingOn(LineLocation line) {
+        final Source source = line.getSource();
+        final Intervals intervals = sources.get(source);
+        final int lineNumber = line.getLineNumber();
+        if (intervals == null || lineNumber < 1 || lineNumber > source.getLineCount()) {
+            return Collections.emptyList();
+        }
+        final int lineStart = source.getLineStartOffset(lineNumber);
+        final int nextLineStart = lineNumber < source.getLineCount() ? source.getLineStartOffset(lineNumber + 1) : Integer.MAX_VALUE;
+        return intervals.starting(lineStart, nextLineStart);
+    }
+
+    /**
+     * Gets the values whose sections contain a character position, ordered by the start and then
+     * the end of their sections.
+     */
+    public List<T> findContaining(Source source, int charIndex) {
+        return findOverlapping(source, charIndex, 1);
+    }
+
+    /**
+     * Gets the values whose sections share at least one character with a range, ordered by the
+     * start and then the end of their sections.
+     */
+    public List<T> findOverlapping(Source source, int charIndex, int length) {
+        final Intervals intervals = sources.get(source);
+        if (intervals == null || length <= 0) {
+            return Collections.emptyList();
+        }
+        return intervals.overlapping(charIndex, charIndex + length);
+    }
+
+    /**
+     * Gets the values whose sections share at least one character with a section.
+     */
+    public List<T> findOverlapping(SourceSection section) {
+        return findOverlapping(section.getSource(), section.getCharIndex(), section.getCharLength());
+    }
+
+    /**
+     * The sections of one source as an augmented interval tree: a treap ordered by start index,
+     * then end index, then insertion order, in which every node also records the largest end index
+     * in its subtree. Insertion and removal take expected logarithmic time; a range query visits
+     * only the subtrees that can still reach the queried range, so a section spanning the whole
+     * source does not make queries scan all other entries.
+     */
+    private final class Intervals {
+
+        private Node root;
+        private int size;
+        private int seed = 0x2545F491;
+
+        void add(int start, int end, Object value) {
+            final Node node = new Node(start, end, value, nextPriority());
+            final Node[] split = split(root, start, end);
+            root = merge(merge(split[0], node), split[1]);
+            size++;
+        }
+
+        boolean remove(int start, int end, Object value) {
+            final int oldSize = size;
+            root = remove(root, start, end, value);
+            return size != oldSize;
+        }
+
+        private Node remove(Node node, int start, int end, Object value) {
+            if (node == null) {
+                return null;
+            }
+            final int order = compare(start, end, node);
+            if (order == 0 && node.value == value) {
+                size--;
+                return merge(node.left, node.right);
+            }
+            final int oldSize = size;
+            if (order <= 0) {
+                node.left = remove(node.left, start, end, value);
+            }
+            if (order >= 0 && size == oldSize) {
+                node.right = remove(node.right, start, end, value);
+            }
+            node.update();
+            return node;
+        }
+
+        List<T> all() {
+            final List<T> result = new ArrayList<>(size);
+            collect(root, Integer.MIN_VALUE, Integer.MAX_VALUE, result);
+            return result;
+        }
+
+        /** Values of the entries starting in {@code [from, to)}. */
+        List<T> starting(int from, int to) {
+            final List<T> result = new ArrayList<>();
+            collect(root, from, to, result);
+            return result;
+        }
+
+        private void collect(Node node, int from, int to, List<T> result) {
+            if (node == null) {
+                return;
+            }
+            if (node.start >= from) {
+                collect(node.left, from, to, result);
+                if (node.start < to) {
+                    result.add(value(node));
+                }
+            }
+            if (node.start < to) {
+                collect(node.right, from, to, result);
+            }
+        }
+
+        /** Values of the entries that start before {@code to} and end after {@code from}. */
+        List<T> overlapping(int from, int to) {
+            final List<T> result = new ArrayList<>();
+            overlapping(root, from, to, result);
+            return result;
+        }
+
+        private void overlapping(Node node, int from, int to, List<T> result) {
+            if (node == null || node.maxEnd <= from) {
+                return;
+            }
+            overlapping(node.left, from, to, result);
+            if (node.start < to) {
+                if (node.end > from) {
+                    result.add(value(node));
+                }
+                overlapping(node.right, from, to, result);
+            }
+        }
+
+        /**
+         * Splits a tree into the entries ordered at or before the given start and end, and the
+         * entries ordered after them.
+         */
+        private Node[] split(Node node, int start, int end) {
+            if (node == null) {
+                return new Node[2];
+            }
+            if (compare(start, end, node) >= 0) {
+                final Node[] split = split(node.right, start, end);
+                node.right = split[0];
+                node.update();
+                split[0] = node;
+                return split;
+            } else {
+                final Node[] split = split(node.left, start, end);
+                node.left = split[1];
+                node.update();
+                split[1] = node;
+                return split;
+            }
+        }
+
+        /** Merges two trees, all entries of the first ordered before those of the second. */
+        private Node merge(Node first, Node second) {
+            if (first == null) {
+                return second;
+            } else if (second == null) {
+                return first;
+            } else if (first.priority > second.priority) {
+                first.right = merge(first.right, second);
+                first.update();
+                return first;
+            } else {
+                second.left = merge(first, second.left);
+                second.update();
+                return second;
+            }
+        }
+
+        private int nextPriority() {
+            // xorshift: the priorities only need to be spread, not unpredictable
+            seed ^= seed << 13;
+            seed ^= seed >>> 17;
+            seed ^= seed << 5;
+            return seed;
+        }
+
+        @SuppressWarnings("unchecked")
+        private T value(Node node) {
+            return (T) node.value;
+        }
+    }
+
+    private static int compare(int start, int end, Node node) {
+        if (start != node.start) {
+            return start < node.start ? -1 : 1;
+        }
+        return end == node.end ? 0 : (end < node.end ? -1 : 1);
+    }
+
+    private static final class Node {
+
+        final int start;
+        final int end;
+        final Object value;
+        final int priority;
+
+        Node left;
+        Node right;
+        int maxEnd;
+
+        Node(int start, int end, Object value, int priority) {
+            this.start = start;
+            this.end = end;
+            this.value = value;
+            this.priority = priority;
+            this.maxEnd = end;
+        }
+
+        void update() {
+            int max = end;
+            if (left != null) {
+                max = Math.max(max, left.maxEnd);
+            }
+            if (right != null) {
+                max = Math.max(max, right.maxEnd);
+            }
+            maxEnd = max;
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.api.utilities;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+import com.oracle.truffle.api.Assumption;
+import com.oracle.truffle.api.CompilerDirectives.TruffleBoundary;
+import com.oracle.truffle.api.impl.AbstractAssumption;
+
+/**
+ * Invalidation listeners, batched invalidation and invalidation statistics for {@link Assumption
+ * assumptions}. A listener is a dependent action such as flushing a cache or triggering a
+ * re-specialization; it runs once, on the thread that invalidates the assumption. The statistics
+ * count invalidations by assumption name, which shows the churn of a {@link CyclicAssumption}.
+ */
+public final class Assumptions {
+
+    private Assumptions() {
+    }
+
+    /**
+     * Registers an action to run once when the assumption is invalidated. If the assumption is
+     * already invalid, the action runs immediately. Supported are assumptions created by the
+     * runtime, {@link UnionAssumption}, {@link AlwaysValidAssumption} and
+     * {@link NeverValidAssumption}. Runtime assumptions support listeners only if they extend
+     * {@link AbstractAssumption}, and if they override {@link Assumption#invalidate()}, only if the
+     * override calls {@link AbstractAssumption#notifyInvalidated()}.
+     *
+     * @throws UnsupportedOperationException if the assumption cannot notify listeners
+     */
+    @TruffleBoundary
+    public static void addInvalidationListener(Assumption assumption, final Runnable listener) {
+        if (assumption instanceof AbstractAssumption) {
+            ((AbstractAssumption) assumption).addInvalidationListener(listener);
+        } else if (assumption instanceof UnionAssumption) {
+            final UnionAssumption union = (UnionAssumption) assumption;
+            final AtomicBoolean notified = new AtomicBoolean();
+            final Runnable once = new Runnable() {
+                public void run() {
+                    if (notified.compareAndSet(false, true)) {
+                        listener.run();
+                    }
+                }
+            };
+            addInvalidationListener(union.getFirst(), once);
+            addInvalidationListener(union.getSecond(), once);
+        } else if (assumption instanceof NeverValidAssumption) {
+            listener.run();
+        } else if (!(assumption instanceof AlwaysValidAssumption)) {
+            throw new UnsupportedOperationException("Cannot listen to invalidation of " + assumption);
+        }
+    }
+
+    /**
+     * Invalidates all given assumptions before running the listeners of any of them.
+     */
+    @TruffleBoundary
+    public static void invalidate(Assumption... assumptions) {
+        invalidate(Arrays.asList(assumptions));
+    }
+
+    /**
+     * Invalidates all given assumptions before running the listeners of any of them.
+     */
+    @TruffleBoundary
+    public static void invalidate(Collection<? extends Assumption> assumptions) {
+        List<Assumption> flattened = new ArrayList<>(assumptions.size());
+        for (Assumption assumption : assumptions) {
+            flatten(assumption, flattened);
+        }
+        AbstractAssumption.invalidateAll(flattened);
+    }
+
+    private static void flatten(Assumption assumption, List<Assumption> result) {
+        if (assumption instanceof UnionAssumption) {
+            flatten(((UnionAssumption) assumption).getFirst(), result);
+            flatten(((UnionAssumption) assumption).getSecond(), result);
+        } else {
+            result.add(assumption);
+        }
+    }
+
+    /**
+     * Returns the number of invalidations since startup or the last
+     * {@link #resetInvalidationCounts() reset}, by assumption name. Assumptions without a name
+     * are counted as {@code "<unnamed>"}.
+     */
+    public static Map<String, Long> getInvalidationCounts() {
+        return AbstractAssumption.getInvalidationCounts();
+    }
+
+    public static void resetInvalidationCounts() {
+        AbstractAssumption.resetInvalidationCounts();
+    }
+}
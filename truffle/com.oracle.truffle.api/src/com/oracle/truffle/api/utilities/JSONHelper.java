@@ -145,7 +145,7 @@ public class JSONHelper {
         protected static void appendValue(StringBuilder sb, Object value) {
             if (value instanceof JSONStringBuilder) {
                 ((JSONStringBuilder) value).appendTo(sb);
-            } else if (value instanceof Integer || value instanceof Boolean || value == null) {
+            } else if (value instanceof Integer || value instanceof Long || value instanceof Boolean || value == null) {
                 sb.append(value);
             } else {
                 sb.append(quote(String.valueOf(value)));
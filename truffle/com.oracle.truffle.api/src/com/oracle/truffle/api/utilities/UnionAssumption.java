@@ -69,4 +69,12 @@ public class UnionAssumption implements Assumption {
         return first.isValid() && second.isValid();
     }
 
+    Assumption getFirst() {
+        return first;
+    }
+
+    Assumption getSecond() {
+        return second;
+    }
+
 }
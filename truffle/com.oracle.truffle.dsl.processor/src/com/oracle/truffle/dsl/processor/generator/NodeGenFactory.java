@@ -57,6 +57,7 @@ import java.util.Objects;
 import java.util.Set;
 
 import javax.lang.model.element.Element;
+import javax.lang.model.element.ElementKind;
 import javax.lang.model.element.ExecutableElement;
 import javax.lang.model.element.Modifier;
 import javax.lang.model.element.TypeElement;
@@ -74,15 +75,19 @@ import com.oracle.truffle.api.dsl.UnsupportedSpecializationException;
 import com.oracle.truffle.api.dsl.internal.DSLOptions;
 import com.oracle.truffle.api.dsl.internal.DSLOptions.ImplicitCastOptimization;
 import com.oracle.truffle.api.dsl.internal.DSLOptions.TypeBoxingOptimization;
+import com.oracle.truffle.api.dsl.internal.DSLShare;
+import com.oracle.truffle.api.dsl.internal.FlatSpecializedNode;
 import com.oracle.truffle.api.dsl.internal.SpecializationNode;
 import com.oracle.truffle.api.dsl.internal.SpecializedNode;
 import com.oracle.truffle.api.dsl.internal.SuppressFBWarnings;
 import com.oracle.truffle.api.frame.Frame;
+import com.oracle.truffle.api.nodes.GeneratedNodeClass;
 import com.oracle.truffle.api.nodes.InvalidAssumptionException;
 import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.Node.Child;
 import com.oracle.truffle.api.nodes.Node.Children;
 import com.oracle.truffle.api.nodes.NodeCost;
+import com.oracle.truffle.api.nodes.NodeVisitor;
 import com.oracle.truffle.api.nodes.UnexpectedResultException;
 import com.oracle.truffle.dsl.processor.ProcessorContext;
 import com.oracle.truffle.dsl.processor.expression.DSLExpression;
@@ -121,6 +126,11 @@ public class NodeGenFactory {
     private static final String FRAME_VALUE = TemplateMethod.FRAME_NAME;
     private static final String NAME_SUFFIX = "_";
     private static final String NODE_SUFFIX = "NodeGen";
+    private static final String NODE_CLASS_NAME = "NodeClass_";
+    private static final String EXECUTE_AND_SPECIALIZE_NAME = "executeAndSpecialize_";
+    private static final int MAX_FLAT_SPECIALIZATIONS = 31;
+    private static final String UNCACHED_NAME = "Uncached";
+    private static final String UNCACHED_INSTANCE_NAME = "INSTANCE";
 
     private final ProcessorContext context;
     private final NodeData node;
@@ -128,6 +138,8 @@ public class NodeGenFactory {
     private final TypeMirror genericType;
     private final DSLOptions options;
     private final boolean singleSpecializable;
+    private final boolean flat;
+    private boolean generatingUncached;
     private final int varArgsThreshold;
     private final Set<TypeMirror> expectedTypes = new HashSet<>();
     private final Set<NodeExecutionData> usedExecuteChildMethods = new HashSet<>();
@@ -147,6 +159,7 @@ public class NodeGenFactory {
         this.reachableSpecializations = calculateReachableSpecializations();
         this.singleSpecializable = isSingleSpecializableImpl();
         this.usedTypes = filterBaseExecutableTypes(node.getExecutableTypes(), reachableSpecializations);
+        this.flat = isFlatImpl();
     }
 
     private int calculateVarArgsThreshold() {
@@ -204,6 +217,10 @@ public class NodeGenFactory {
         return execution.getName() + NAME_SUFFIX;
     }
 
+    private static String stateFieldName() {
+        return "state" + NAME_SUFFIX;
+    }
+
     private static String specializationStartFieldName() {
         return "specialization" + NAME_SUFFIX;
     }
@@ -217,7 +234,7 @@ public class NodeGenFactory {
     }
 
     private CodeTree accessParent(String name) {
-        if (singleSpecializable) {
+        if (singleSpecializable || flat || generatingUncached) {
             if (name == null) {
                 return CodeTreeBuilder.singleString("this");
             } else {
@@ -270,9 +287,11 @@ public class NodeGenFactory {
             }
         }
 
-        for (SpecializationData specialization : node.getSpecializations()) {
-            if (mayBeExcluded(specialization)) {
-                clazz.add(createNodeField(PRIVATE, getType(boolean.class), excludedFieldName(specialization), CompilationFinal.class));
+        if (!flat) {
+            for (SpecializationData specialization : node.getSpecializations()) {
+                if (mayBeExcluded(specialization)) {
+                    clazz.add(createNodeField(PRIVATE, getType(boolean.class), excludedFieldName(specialization), CompilationFinal.class));
+                }
             }
         }
 
@@ -304,6 +323,24 @@ public class NodeGenFactory {
                 clazz.add(createExecutableTypeOverride(usedTypes, execType));
             }
 
+            if (singleSpecializableUnsupportedUsed) {
+                addUnsupportedMethod(clazz);
+            }
+        } else if (flat) {
+            for (ExecutableTypeData execType : usedTypes) {
+                if (execType.getMethod() == null) {
+                    continue;
+                }
+                clazz.add(createExecutableTypeOverride(usedTypes, execType));
+            }
+
+            clazz.getImplements().add(getType(FlatSpecializedNode.class));
+            clazz.add(createNodeField(PRIVATE, getType(int.class), stateFieldName(), CompilationFinal.class));
+            clazz.add(createFlatGetSpecializationNames());
+            clazz.add(createFlatGetSpecializationState());
+            clazz.add(createFlatSetSpecializationState());
+            clazz.add(createFlatExecuteAndSpecialize());
+
             if (singleSpecializableUnsupportedUsed) {
                 addUnsupportedMethod(clazz);
             }
@@ -331,12 +368,19 @@ public class NodeGenFactory {
             }
         }
 
+        if (node.isGenerateUncached()) {
+            clazz.add(createUncached());
+            clazz.add(createGetUncachedMethod());
+        }
+
         for (TypeMirror type : ElementUtils.uniqueSortedTypes(expectedTypes, false)) {
             if (!typeSystem.hasType(type)) {
                 clazz.addOptional(TypeSystemCodeGenerator.createExpectMethod(PRIVATE, typeSystem, context.getType(Object.class), type));
             }
         }
 
+        clazz.addOptional(createNodeClass(clazz));
+
         return clazz;
     }
 
@@ -474,6 +518,9 @@ public class NodeGenFactory {
         baseSpecialization.addOptional(createCreateFallback(generated));
         baseSpecialization.addOptional(createCreatePolymorphic(generated));
         baseSpecialization.addOptional(createGetNext(baseSpecialization));
+        for (CodeTypeElement specializationClass : generated.values()) {
+            specializationClass.addOptional(createSpecializationNodeClass(specializationClass));
+        }
 
         for (NodeExecutionData execution : node.getChildExecutions()) {
             Collection<TypeMirror> specializedTypes = node.findSpecializedTypes(execution);
@@ -772,6 +819,15 @@ public class NodeGenFactory {
         CodeTreeBuilder builder = executable.createBuilder();
         if (singleSpecializable) {
             builder.startReturn().staticReference(getType(NodeCost.class), "MONOMORPHIC").end().end();
+        } else if (flat) {
+            builder.declaration(getType(int.class), "state", stateFieldName());
+            builder.startIf().string("state == 0").end().startBlock();
+            builder.startReturn().staticReference(getType(NodeCost.class), "UNINITIALIZED").end();
+            builder.end().startElseIf().string("(state & (state - 1)) == 0").end().startBlock();
+            builder.startReturn().staticReference(getType(NodeCost.class), "MONOMORPHIC").end();
+            builder.end().startElseBlock();
+            builder.startReturn().staticReference(getType(NodeCost.class), "POLYMORPHIC").end();
+            builder.end();
         } else {
             builder.startReturn().startCall(specializationStartFieldName(), "getNodeCost").end().end();
         }
@@ -1045,6 +1101,42 @@ public class NodeGenFactory {
         return true;
     }
 
+    /**
+     * Flat nodes keep the active specializations in an int state field instead of a chain of
+     * specialization nodes. Nodes using features that are not supported yet, see
+     * {@link NodeData#findFlatStateBitsetConflict()}, use the specialization chain; the parser
+     * warns about them.
+     */
+    private boolean isFlatImpl() {
+        if (!options.useFlatStateBitset() || singleSpecializable) {
+            return false;
+        }
+        if (reachableSpecializations.isEmpty() || reachableSpecializations.size() > MAX_FLAT_SPECIALIZATIONS) {
+            return false;
+        }
+        if (node.findFlatStateBitsetConflict() != null) {
+            return false;
+        }
+        for (SpecializationData specialization : reachableSpecializations) {
+            if (specialization.getMethod() == null || specialization.isFallback()) {
+                return false;
+            }
+        }
+        for (ExecutableTypeData type : usedTypes) {
+            for (TypeMirror evaluatedType : type.getEvaluatedParameters()) {
+                if (!isObject(evaluatedType)) {
+                    return false;
+                }
+            }
+            for (NodeExecutionData execution : node.getChildExecutions()) {
+                if (execution.getIndex() >= type.getEvaluatedCount() && execution.getChild() == null) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     private List<SpecializationData> calculateReachableSpecializations() {
         List<SpecializationData> specializations = new ArrayList<>();
         for (SpecializationData specialization : node.getSpecializations()) {
@@ -1078,6 +1170,8 @@ public class NodeGenFactory {
         if (singleSpecializable) {
             SpecializationData specialization = reachableSpecializations.iterator().next();
             builder.tree(createFastPath(builder, specialization, execType, usedExecutables, locals));
+        } else if (flat) {
+            builder.tree(createFlatFastPath(builder, execType, locals));
         } else {
             // create acceptAndExecute
             ExecutableTypeData delegate = execType;
@@ -1087,6 +1181,307 @@ public class NodeGenFactory {
         return method;
     }
 
+    private CodeTree createFlatFastPath(CodeTreeBuilder parent, final ExecutableTypeData forType, LocalContext currentLocals) {
+        final CodeTreeBuilder builder = parent.create();
+        for (NodeExecutionData execution : node.getChildExecutions()) {
+            LocalVariable var = currentLocals.getValue(execution);
+            if (var == null) {
+                var = currentLocals.createValue(execution, genericType).nextName();
+                builder.tree(createAssignExecuteChild(builder, execution, forType, var, null, currentLocals));
+                currentLocals.setValue(execution, var);
+            }
+        }
+
+        SpecializationBody executionFactory = new SpecializationBody(true, true) {
+            @Override
+            public CodeTree createBody(SpecializationData s, LocalContext values) {
+                return createExecuteSpecialization(builder, forType, s, values);
+            }
+        };
+        for (SpecializationData specialization : reachableSpecializations) {
+            builder.startIf().string("(").string(stateFieldName()).string(" & ").string(flatStateMask(Collections.singleton(specialization))).string(") != 0").end().startBlock();
+            builder.tree(createGuardAndCast(builder, SpecializationGroup.create(specialization), forType, currentLocals.copy(), executionFactory));
+            builder.end();
+        }
+
+        builder.tree(createTransferToInterpreterAndInvalidate());
+        CodeTreeBuilder callBuilder = builder.create();
+        callBuilder.startCall(EXECUTE_AND_SPECIALIZE_NAME);
+        currentLocals.addReferencesTo(callBuilder, FRAME_VALUE);
+        callBuilder.end();
+        if (isVoid(forType.getReturnType())) {
+            builder.statement(callBuilder.build());
+            builder.returnStatement();
+        } else {
+            builder.startReturn().tree(expectOrCast(genericType, forType, callBuilder.build())).end();
+        }
+        return builder.build();
+    }
+
+    private CodeTree createExecuteSpecialization(CodeTreeBuilder parent, ExecutableTypeData forType, SpecializationData specialization, LocalContext currentValues) {
+        CodeTreeBuilder builder = parent.create();
+        CodeTree call = callTemplateMethod(accessParent(null), specialization, currentValues);
+        TypeMirror returnType = specialization.getReturnType().getType();
+        if (isVoid(forType.getReturnType())) {
+            builder.statement(call);
+            builder.returnStatement();
+        } else if (isVoid(returnType)) {
+            builder.statement(call);
+            builder.startReturn().defaultValue(forType.getReturnType()).end();
+        } else {
+            builder.startReturn().tree(expectOrCast(returnType, forType, call)).end();
+        }
+        return builder.build();
+    }
+
+    private Element createFlatExecuteAndSpecialize() {
+        ExecutableTypeData signature = createSpecializationNodeSignature(node.getSignatureSize());
+        LocalContext currentLocals = LocalContext.load(this, signature, varArgsThreshold);
+        CodeExecutableElement method = currentLocals.createMethod(modifiers(PRIVATE), genericType, EXECUTE_AND_SPECIALIZE_NAME, varArgsThreshold, FRAME_VALUE);
+
+        final CodeTreeBuilder builder = method.createBuilder();
+        SpecializationGroup group = createSpecializationGroups();
+        SpecializationBody executionFactory = new SpecializationBody(false, true) {
+            @Override
+            public CodeTree createBody(SpecializationData s, LocalContext values) {
+                return createFlatSlowPathExecute(builder, s, values);
+            }
+        };
+        builder.tree(createGuardAndCast(builder, group, null, currentLocals.copy(), executionFactory));
+        if (hasFallthrough(group, genericType, currentLocals, false, null)) {
+            builder.tree(createThrowUnsupported(currentLocals));
+        }
+        return method;
+    }
+
+    private CodeTree createFlatSlowPathExecute(CodeTreeBuilder parent, SpecializationData specialization, LocalContext currentValues) {
+        CodeTreeBuilder builder = parent.create();
+        List<SpecializationData> excludes = new ArrayList<>();
+        for (SpecializationData other : reachableSpecializations) {
+            if (other.getExcludedBy().contains(specialization)) {
+                excludes.add(other);
+            }
+        }
+        List<SpecializationData> excludedBy = new ArrayList<>(specialization.getExcludedBy());
+        excludedBy.retainAll(reachableSpecializations);
+
+        CodeTreeBuilder updateBuilder = builder.create();
+        updateBuilder.startStaticCall(getType(SpecializationNode.class), "updateFlatState").string("this");
+        updateBuilder.string(excludedBy.isEmpty() ? "0" : flatStateMask(excludedBy));
+        updateBuilder.string(excludes.isEmpty() ? "0" : flatStateMask(excludes));
+        updateBuilder.string(flatStateMask(Collections.singleton(specialization)));
+        updateBuilder.doubleQuote("insert new specialization");
+        updateBuilder.end();
+        if (excludedBy.isEmpty()) {
+            builder.statement(updateBuilder.build());
+        } else {
+            builder.startIf().tree(updateBuilder.build()).end().startBlock();
+        }
+
+        CodeTree call = callTemplateMethod(accessParent(null), specialization, currentValues);
+        if (isVoid(specialization.getReturnType().getType())) {
+            builder.statement(call);
+            builder.returnNull();
+        } else {
+            builder.startReturn().tree(call).end();
+        }
+        if (!excludedBy.isEmpty()) {
+            builder.end();
+        }
+        return builder.build();
+    }
+
+    private Element createFlatGetSpecializationNames() {
+        ArrayType stringArray = context.getEnvironment().getTypeUtils().getArrayType(getType(String.class));
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PUBLIC), stringArray, "getSpecializationNames");
+        CodeTreeBuilder builder = method.createBuilder();
+        builder.startReturn().startNewArray(stringArray, null);
+        for (SpecializationData specialization : reachableSpecializations) {
+            builder.doubleQuote(specialization.createReferenceName());
+        }
+        builder.end().end();
+        return method;
+    }
+
+    private Element createFlatGetSpecializationState() {
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PUBLIC), getType(int.class), "getSpecializationState");
+        method.createBuilder().startReturn().string(stateFieldName()).end();
+        return method;
+    }
+
+    private Element createFlatSetSpecializationState() {
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PUBLIC), getType(void.class), "setSpecializationState");
+        method.addParameter(new CodeVariableElement(getType(int.class), "state"));
+        method.createBuilder().startStatement().string("this.").string(stateFieldName()).string(" = state").end();
+        return method;
+    }
+
+    private String flatStateMask(Collection<SpecializationData> specializations) {
+        int mask = 0;
+        for (SpecializationData specialization : specializations) {
+            mask |= 1 << reachableSpecializations.indexOf(specialization);
+        }
+        return "0b" + Integer.toBinaryString(mask);
+    }
+
+    private TypeMirror uncachedType() {
+        return new GeneratedTypeMirror(ElementUtils.getPackageName(node.getTemplateType()) + "." + nodeTypeName(node), UNCACHED_NAME);
+    }
+
+    private Element createGetUncachedMethod() {
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PUBLIC, STATIC), node.getTemplateType().asType(), "getUncached");
+        method.createBuilder().startReturn().staticReference(uncachedType(), UNCACHED_INSTANCE_NAME).end();
+        return method;
+    }
+
+    /**
+     * The uncached node is a shared subclass of the node type that evaluates the guards of all
+     * specializations on every execution. Accesses to the parent node resolve to <code>this</code>
+     * while it is generated.
+     */
+    private CodeTypeElement createUncached() {
+        generatingUncached = true;
+        CodeTypeElement clazz = createClass(node, null, modifiers(PRIVATE, STATIC, FINAL), UNCACHED_NAME, node.getTemplateType().asType());
+
+        CodeVariableElement instance = new CodeVariableElement(modifiers(STATIC, FINAL), uncachedType(), UNCACHED_INSTANCE_NAME);
+        instance.createInitBuilder().startNew(uncachedType()).end();
+        clazz.add(instance);
+
+        for (NodeChildData child : node.getChildren()) {
+            Element accessElement = child.getAccessElement();
+            if (accessElement != null && accessElement.getModifiers().contains(Modifier.ABSTRACT)) {
+                CodeExecutableElement method = CodeExecutableElement.clone(context.getEnvironment(), (ExecutableElement) accessElement);
+                method.getModifiers().remove(Modifier.ABSTRACT);
+                method.createBuilder().returnNull();
+                clazz.add(method);
+            }
+        }
+
+        List<SpecializationData> specialized = new ArrayList<>();
+        for (SpecializationData specialization : node.getSpecializations()) {
+            if (specialization.isReachable() && specialization.isSpecialized()) {
+                specialized.add(specialization);
+            }
+        }
+        // contained specializations are covered by the containing one
+        List<SpecializationData> specializations = new ArrayList<>();
+        outer: for (SpecializationData specialization : specialized) {
+            for (SpecializationData excludedBy : specialization.getExcludedBy()) {
+                if (specialized.contains(excludedBy)) {
+                    continue outer;
+                }
+            }
+            specializations.add(specialization);
+        }
+
+        for (ExecutableTypeData type : node.getExecutableTypes()) {
+            if (type.getMethod() == null || type.isFinal()) {
+                continue;
+            }
+            if (type.getEvaluatedCount() == node.getSignatureSize()) {
+                clazz.add(createUncachedExecute(type, specializations));
+            } else if (type.isAbstract()) {
+                LocalContext locals = LocalContext.load(this, type, Integer.MAX_VALUE);
+                CodeExecutableElement method = createExecuteMethod(null, type, locals, true, Integer.MAX_VALUE);
+                CodeTreeBuilder builder = method.createBuilder();
+                builder.startThrow().startNew(getType(UnsupportedOperationException.class));
+                builder.doubleQuote("Uncached nodes can only be executed with evaluated arguments.");
+                builder.end().end();
+                clazz.add(method);
+            }
+        }
+
+        CodeExecutableElement getCost = new CodeExecutableElement(modifiers(PUBLIC), getType(NodeCost.class), "getCost");
+        getCost.createBuilder().startReturn().staticReference(getType(NodeCost.class), "MEGAMORPHIC").end();
+        clazz.add(getCost);
+
+        generatingUncached = false;
+        return clazz;
+    }
+
+    private CodeExecutableElement createUncachedExecute(final ExecutableTypeData forType, List<SpecializationData> specializations) {
+        LocalContext locals = LocalContext.load(this, forType, Integer.MAX_VALUE);
+        CodeExecutableElement method = createExecuteMethod(null, forType, locals, true, Integer.MAX_VALUE);
+        final CodeTreeBuilder builder = method.createBuilder();
+
+        boolean fallthrough = true;
+        if (!specializations.isEmpty()) {
+            SpecializationGroup group = SpecializationGroup.create(specializations);
+            SpecializationBody executionFactory = new SpecializationBody(false, true) {
+                @Override
+                public CodeTree createBody(SpecializationData s, LocalContext values) {
+                    return createUncachedExecuteSpecialization(builder, forType, s, values);
+                }
+            };
+            builder.tree(createGuardAndCast(builder, group, forType, locals.copy(), executionFactory));
+            fallthrough = hasFallthrough(group, genericType, locals, false, null);
+            for (SpecializationData specialization : specializations) {
+                if (!specialization.getExceptions().isEmpty()) {
+                    fallthrough = true;
+                }
+            }
+        }
+
+        if (fallthrough) {
+            SpecializationData fallback = node.getGenericSpecialization();
+            if (fallback != null && fallback.getMethod() != null) {
+                builder.tree(createExecuteSpecialization(builder, forType, fallback, locals));
+            } else {
+                ArrayType nodeArray = context.getEnvironment().getTypeUtils().getArrayType(getType(Node.class));
+                builder.startThrow().startNew(getType(UnsupportedSpecializationException.class));
+                builder.string("this");
+                builder.startNewArray(nodeArray, CodeTreeBuilder.singleString(String.valueOf(node.getSignatureSize()))).end();
+                locals.addReferencesTo(builder);
+                builder.end().end();
+            }
+        }
+        return method;
+    }
+
+    private CodeTree createUncachedExecuteSpecialization(CodeTreeBuilder parent, ExecutableTypeData forType, SpecializationData specialization, LocalContext currentValues) {
+        CodeTreeBuilder builder = parent.create();
+        for (CacheExpression cache : specialization.getCaches()) {
+            if (!specialization.isCacheBoundByGuard(cache)) {
+                initializeCache(builder, specialization, cache, currentValues);
+            }
+        }
+
+        boolean hasAssumptions = !specialization.getAssumptionExpressions().isEmpty();
+        if (hasAssumptions) {
+            builder.startIf();
+            String sep = "";
+            for (AssumptionExpression assumption : specialization.getAssumptionExpressions()) {
+                CodeTree value = DSLExpressionGenerator.write(assumption.getExpression(), accessParent(null),
+                                castBoundTypes(bindExpressionValues(assumption.getExpression(), specialization, currentValues)));
+                builder.string(sep);
+                builder.startStaticCall(getType(DSLShare.class), "isValid").tree(value).end();
+                sep = " && ";
+            }
+            builder.end();
+            builder.startBlock();
+        }
+
+        CodeTree execute = createExecuteSpecialization(builder, forType, specialization, currentValues);
+        if (specialization.getExceptions().isEmpty()) {
+            builder.tree(execute);
+        } else {
+            // rewrite exceptions fall through to the next specialization
+            TypeMirror[] exceptionTypes = new TypeMirror[specialization.getExceptions().size()];
+            for (int i = 0; i < exceptionTypes.length; i++) {
+                exceptionTypes[i] = specialization.getExceptions().get(i).getJavaClass();
+            }
+            builder.startTryBlock();
+            builder.tree(execute);
+            builder.end().startCatchBlock(exceptionTypes, "ex");
+            builder.end();
+        }
+
+        if (hasAssumptions) {
+            builder.end();
+        }
+        return builder.build();
+    }
+
     private Element createMethodGetSpecializationNode() {
         TypeMirror returntype = getType(SpecializationNode.class);
         CodeExecutableElement method = new CodeExecutableElement(modifiers(PUBLIC), returntype, "getSpecializationNode");
@@ -1496,6 +1891,205 @@ public class NodeGenFactory {
         return executable;
     }
 
+    // create node class
+
+    private CodeTypeElement createNodeClass(CodeTypeElement clazz) {
+        if (!options.generateNodeClass() || !node.getTemplateType().getTypeParameters().isEmpty()) {
+            return null;
+        }
+        List<VariableElement> childFields = new ArrayList<>();
+        List<VariableElement> childrenFields = new ArrayList<>();
+        if (!collectInheritedChildFields(node.getTemplateType(), childFields, childrenFields)) {
+            // fall back to the reflective node class
+            return null;
+        }
+        return createNodeClass(clazz, nodeTypeName(node), childFields, childrenFields);
+    }
+
+    /*
+     * The specialization nodes of the chain are the bulk of the DSL node instances, so they get a
+     * generated node class too. The base specialization declares no child fields.
+     */
+    private CodeTypeElement createSpecializationNodeClass(CodeTypeElement clazz) {
+        if (!options.generateNodeClass() || !node.getTemplateType().getTypeParameters().isEmpty()) {
+            return null;
+        }
+        List<VariableElement> childFields = new ArrayList<>();
+        List<VariableElement> childrenFields = new ArrayList<>();
+        if (!collectInheritedChildFields(fromTypeMirror(getType(SpecializationNode.class)), childFields, childrenFields)) {
+            return null;
+        }
+        return createNodeClass(clazz, nodeTypeName(node) + "." + clazz.getSimpleName(), childFields, childrenFields);
+    }
+
+    private CodeTypeElement createNodeClass(CodeTypeElement clazz, String qualifiedClassName, List<VariableElement> childFields, List<VariableElement> childrenFields) {
+        for (VariableElement field : clazz.getFields()) {
+            if (!field.getModifiers().contains(STATIC)) {
+                collectChildField(field, childFields, childrenFields);
+            }
+        }
+        Set<String> fieldNames = new HashSet<>();
+        for (VariableElement field : childFields) {
+            fieldNames.add(field.getSimpleName().toString());
+        }
+        for (VariableElement field : childrenFields) {
+            fieldNames.add(field.getSimpleName().toString());
+        }
+        if (fieldNames.size() != childFields.size() + childrenFields.size()) {
+            // shadowed fields cannot be accessed by name
+            return null;
+        }
+
+        CodeTypeElement nodeClass = createClass(node, null, modifiers(STATIC, FINAL), NODE_CLASS_NAME, getType(GeneratedNodeClass.class));
+        CodeExecutableElement constructor = new CodeExecutableElement(modifiers(), null, NODE_CLASS_NAME);
+        constructor.createBuilder().startStatement().startSuperCall().typeLiteral(clazz.asType()).end().end();
+        nodeClass.add(constructor);
+        nodeClass.add(createNodeClassForEachChild(clazz, childFields, childrenFields));
+        nodeClass.add(createNodeClassReplaceChild(clazz, childFields, childrenFields));
+        nodeClass.add(createNodeClassCopyChildren(clazz, childFields, childrenFields));
+
+        // the nested class is not in scope of the annotations of its enclosing class
+        TypeMirror registeredType = new GeneratedTypeMirror(ElementUtils.getPackageName(node.getTemplateType()), qualifiedClassName + "." + NODE_CLASS_NAME);
+        CodeAnnotationMirror registration = new CodeAnnotationMirror(context.getDeclaredType(GeneratedNodeClass.Registration.class));
+        registration.setElementValue(registration.findExecutableElement("value"), new CodeAnnotationValue(registeredType));
+        clazz.addAnnotationMirror(registration);
+        return nodeClass;
+    }
+
+    private boolean collectInheritedChildFields(TypeElement type, List<VariableElement> childFields, List<VariableElement> childrenFields) {
+        TypeElement superType = ElementUtils.getSuperType(type);
+        if (superType != null && !collectInheritedChildFields(superType, childFields, childrenFields)) {
+            return false;
+        }
+        String packageName = ElementUtils.getPackageName(node.getTemplateType());
+        for (VariableElement field : ElementFilter.fieldsIn(type.getEnclosedElements())) {
+            if (field.getModifiers().contains(STATIC) || !collectChildField(field, childFields, childrenFields)) {
+                continue;
+            }
+            Modifier visibility = ElementUtils.getVisibility(field.getModifiers());
+            if (visibility == PRIVATE || (visibility == null && !ElementUtils.getPackageName(type).equals(packageName))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private boolean collectChildField(VariableElement field, List<VariableElement> childFields, List<VariableElement> childrenFields) {
+        if (ElementUtils.findAnnotationMirror(context.getEnvironment(), field, Child.class) != null) {
+            childFields.add(field);
+            return true;
+        } else if (ElementUtils.findAnnotationMirror(context.getEnvironment(), field, Children.class) != null) {
+            childrenFields.add(field);
+            return true;
+        }
+        return false;
+    }
+
+    private CodeTree accessChildField(String receiver, VariableElement field) {
+        CodeTreeBuilder builder = CodeTreeBuilder.createBuilder();
+        CodeTree access = CodeTreeBuilder.createBuilder().string(receiver).string(".").string(field.getSimpleName().toString()).build();
+        TypeElement fieldType = fromTypeMirror(field.asType());
+        if (fieldType != null && fieldType.getKind() == ElementKind.INTERFACE) {
+            // child fields may be typed with interfaces extending NodeInterface
+            builder.cast(getType(Node.class), access);
+        } else {
+            builder.tree(access);
+        }
+        return builder.build();
+    }
+
+    private CodeExecutableElement createNodeClassForEachChild(CodeTypeElement clazz, List<VariableElement> childFields, List<VariableElement> childrenFields) {
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PROTECTED), getType(boolean.class), "forEachChild");
+        method.addParameter(new CodeVariableElement(getType(Node.class), "parent"));
+        method.addParameter(new CodeVariableElement(getType(NodeVisitor.class), "visitor"));
+        method.getAnnotationMirrors().add(new CodeAnnotationMirror(context.getDeclaredType(Override.class)));
+        CodeTreeBuilder builder = method.createBuilder();
+        if (childFields.isEmpty() && childrenFields.isEmpty()) {
+            builder.returnTrue();
+            return method;
+        }
+        builder.declaration(clazz.asType(), "node", builder.create().cast(clazz.asType(), CodeTreeBuilder.singleString("parent")));
+        builder.startReturn();
+        String sep = "";
+        for (VariableElement field : childFields) {
+            builder.string(sep).startCall("visitChild").tree(accessChildField("node", field)).string("visitor").end();
+            sep = " && ";
+        }
+        for (VariableElement field : childrenFields) {
+            builder.string(sep).startCall("visitChildren").string("node." + field.getSimpleName()).string("visitor").end();
+            sep = " && ";
+        }
+        builder.end();
+        return method;
+    }
+
+    private CodeExecutableElement createNodeClassReplaceChild(CodeTypeElement clazz, List<VariableElement> childFields, List<VariableElement> childrenFields) {
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PROTECTED), getType(boolean.class), "replaceChild");
+        method.addParameter(new CodeVariableElement(getType(Node.class), "parent"));
+        method.addParameter(new CodeVariableElement(getType(Node.class), "oldChild"));
+        method.addParameter(new CodeVariableElement(getType(Node.class), "newChild"));
+        method.addParameter(new CodeVariableElement(getType(boolean.class), "adopt"));
+        method.getAnnotationMirrors().add(new CodeAnnotationMirror(context.getDeclaredType(Override.class)));
+        CodeTreeBuilder builder = method.createBuilder();
+        if (childFields.isEmpty() && childrenFields.isEmpty()) {
+            builder.returnFalse();
+            return method;
+        }
+        builder.declaration(clazz.asType(), "node", builder.create().cast(clazz.asType(), CodeTreeBuilder.singleString("parent")));
+        for (VariableElement field : childFields) {
+            String name = field.getSimpleName().toString();
+            builder.startIf().string("node.").string(name).string(" == oldChild").end().startBlock();
+            builder.startIf().string("adopt").end().startBlock();
+            builder.startStatement().startCall("adoptChild").string("node").string("newChild").end().end();
+            builder.end();
+            builder.startStatement().string("node.").string(name).string(" = ");
+            if (ElementUtils.typeEquals(field.asType(), getType(Node.class))) {
+                builder.string("newChild");
+            } else {
+                builder.cast(ElementUtils.eraseGenericTypes(field.asType()), CodeTreeBuilder.singleString("newChild"));
+            }
+            builder.end();
+            builder.returnTrue();
+            builder.end();
+        }
+        for (VariableElement field : childrenFields) {
+            builder.startIf().startCall("replaceChildren").string("node").string("node." + field.getSimpleName()).string("oldChild").string("newChild").string("adopt").end().end();
+            builder.startBlock().returnTrue().end();
+        }
+        builder.returnFalse();
+        return method;
+    }
+
+    private CodeExecutableElement createNodeClassCopyChildren(CodeTypeElement clazz, List<VariableElement> childFields, List<VariableElement> childrenFields) {
+        CodeExecutableElement method = new CodeExecutableElement(modifiers(PROTECTED), getType(void.class), "copyChildren");
+        method.addParameter(new CodeVariableElement(getType(Node.class), "original"));
+        method.addParameter(new CodeVariableElement(getType(Node.class), "copy"));
+        method.getAnnotationMirrors().add(new CodeAnnotationMirror(context.getDeclaredType(Override.class)));
+        CodeTreeBuilder builder = method.createBuilder();
+        if (!childFields.isEmpty()) {
+            builder.declaration(clazz.asType(), "originalNode", builder.create().cast(clazz.asType(), CodeTreeBuilder.singleString("original")));
+            builder.declaration(clazz.asType(), "copyNode", builder.create().cast(clazz.asType(), CodeTreeBuilder.singleString("copy")));
+        }
+        for (VariableElement field : childFields) {
+            String name = field.getSimpleName().toString();
+            builder.startIf().string("originalNode.").string(name).string(" != null").end().startBlock();
+            builder.startStatement().string("copyNode.").string(name).string(" = ");
+            CodeTreeBuilder copyCall = builder.create().startCall("copyChild").string("copyNode").tree(accessChildField("originalNode", field)).end();
+            if (ElementUtils.typeEquals(field.asType(), getType(Node.class))) {
+                builder.tree(copyCall.build());
+            } else {
+                builder.cast(ElementUtils.eraseGenericTypes(field.asType()), copyCall.build());
+            }
+            builder.end();
+            builder.end();
+        }
+        if (!childrenFields.isEmpty()) {
+            // children arrays are final and must be written through the field accessors
+            builder.startStatement().startCall("copyChildrenFields").string("original").string("copy").end().end();
+        }
+        return method;
+    }
+
     private boolean useLazyClassLoading() {
         return options.useLazyClassLoading() && !singleSpecializable;
     }
@@ -2520,7 +3114,7 @@ public class NodeGenFactory {
     }
 
     private List<ExecutableTypeData> resolvePolymorphicExecutables(NodeExecutionData execution) {
-        if (singleSpecializable) {
+        if (singleSpecializable || flat) {
             return Collections.emptyList();
         }
         Set<TypeMirror> specializedTypes = new HashSet<>();
@@ -56,10 +56,11 @@ public class NodeData extends Template implements Comparable<NodeData> {
 
     private final NodeExecutionData thisExecution;
     private final boolean generateFactory;
+    private final boolean generateUncached;
 
     private TypeMirror frameType;
 
-    public NodeData(ProcessorContext context, TypeElement type, String shortName, TypeSystemData typeSystem, boolean generateFactory) {
+    public NodeData(ProcessorContext context, TypeElement type, String shortName, TypeSystemData typeSystem, boolean generateFactory, boolean generateUncached) {
         super(context, type, null);
         this.nodeId = ElementUtils.getSimpleName(type);
         this.shortName = shortName;
@@ -70,16 +71,21 @@ public class NodeData extends Template implements Comparable<NodeData> {
         this.thisExecution = new NodeExecutionData(new NodeChildData(null, null, "this", getNodeType(), getNodeType(), null, Cardinality.ONE), -1, -1, false);
         this.thisExecution.getChild().setNode(this);
         this.generateFactory = generateFactory;
+        this.generateUncached = generateUncached;
     }
 
     public NodeData(ProcessorContext context, TypeElement type) {
-        this(context, type, null, null, false);
+        this(context, type, null, null, false, false);
     }
 
     public boolean isGenerateFactory() {
         return generateFactory;
     }
 
+    public boolean isGenerateUncached() {
+        return generateUncached;
+    }
+
     public NodeExecutionData getThisExecution() {
         return thisExecution;
     }
@@ -92,6 +98,48 @@ public class NodeData extends Template implements Comparable<NodeData> {
         return false;
     }
 
+    /**
+     * Describes the first feature of this node that code generation with a flat state bitset does
+     * not support yet, or returns <code>null</code> if there is none.
+     */
+    public String findFlatStateBitsetConflict() {
+        for (SpecializationData specialization : getSpecializations()) {
+            if (!specialization.isReachable()) {
+                continue;
+            }
+            if (specialization.isFallback()) {
+                if (specialization.getMethod() != null) {
+                    return "the @Fallback method " + specialization.getMethodName();
+                }
+                continue;
+            }
+            if (!specialization.isSpecialized()) {
+                continue;
+            }
+            if (!specialization.getCaches().isEmpty()) {
+                return "the @Cached parameters of " + specialization.getMethodName();
+            }
+            if (!specialization.getAssumptionExpressions().isEmpty()) {
+                return "the assumptions of " + specialization.getMethodName();
+            }
+            if (!specialization.getExceptions().isEmpty()) {
+                return "the rewriteOn exceptions of " + specialization.getMethodName();
+            }
+            for (Parameter parameter : specialization.getSignatureParameters()) {
+                TypeMirror type = parameter.getType();
+                if (type != null && typeSystem.hasImplicitSourceTypes(type)) {
+                    return "the implicit casts to " + ElementUtils.getSimpleName(type) + " in " + specialization.getMethodName();
+                }
+            }
+        }
+        for (NodeExecutionData execution : getChildExecutions()) {
+            if (execution.isShortCircuit()) {
+                return "the short circuit of " + execution.getName();
+            }
+        }
+        return null;
+    }
+
     public void setFrameType(TypeMirror frameType) {
         this.frameType = frameType;
     }
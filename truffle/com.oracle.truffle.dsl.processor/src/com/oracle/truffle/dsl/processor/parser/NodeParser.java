@@ -56,6 +56,7 @@ import com.oracle.truffle.api.dsl.Cached;
 import com.oracle.truffle.api.dsl.CreateCast;
 import com.oracle.truffle.api.dsl.Fallback;
 import com.oracle.truffle.api.dsl.GenerateNodeFactory;
+import com.oracle.truffle.api.dsl.GenerateUncached;
 import com.oracle.truffle.api.dsl.GeneratedBy;
 import com.oracle.truffle.api.dsl.ImportStatic;
 import com.oracle.truffle.api.dsl.NodeChild;
@@ -232,6 +233,8 @@ public class NodeParser extends AbstractParser<NodeData> {
         verifyConstructors(node);
         verifyNamingConvention(node.getShortCircuits(), "needs");
         verifySpecializationThrows(node);
+        verifyUncached(node);
+        verifyFlatStateBitset(node);
         return node;
     }
 
@@ -428,7 +431,8 @@ public class NodeParser extends AbstractParser<NodeData> {
             shortName = ElementUtils.getAnnotationValue(String.class, nodeInfoMirror, "shortName");
         }
         boolean useNodeFactory = findFirstAnnotation(typeHierarchy, GenerateNodeFactory.class) != null;
-        return new NodeData(context, templateType, shortName, typeSystem, useNodeFactory);
+        boolean generateUncached = findFirstAnnotation(typeHierarchy, GenerateUncached.class) != null;
+        return new NodeData(context, templateType, shortName, typeSystem, useNodeFactory, generateUncached);
 
     }
 
@@ -1718,6 +1722,55 @@ public class NodeParser extends AbstractParser<NodeData> {
         }
     }
 
+    private static void verifyFlatStateBitset(NodeData nodeData) {
+        if (!nodeData.getTypeSystem().getOptions().useFlatStateBitset()) {
+            return;
+        }
+        String conflict = nodeData.findFlatStateBitsetConflict();
+        if (conflict != null) {
+            nodeData.addWarning("The flat state bitset is not supported for %s. A chain of specialization nodes is generated for this node instead.", conflict);
+        }
+    }
+
+    private static void verifyUncached(NodeData nodeData) {
+        if (!nodeData.isGenerateUncached()) {
+            return;
+        }
+        String annotationName = GenerateUncached.class.getSimpleName();
+        for (NodeFieldData field : nodeData.getFields()) {
+            if (field.isGenerated()) {
+                nodeData.addError("@%s nodes must not declare @%s fields.", annotationName, NodeField.class.getSimpleName());
+                break;
+            }
+        }
+        if (!nodeData.getShortCircuits().isEmpty()) {
+            nodeData.addError("@%s nodes must not declare @%s methods.", annotationName, ShortCircuit.class.getSimpleName());
+        }
+
+        boolean evaluatedExecute = false;
+        for (ExecutableTypeData type : nodeData.getExecutableTypes()) {
+            if (type.getMethod() != null && !type.isFinal() && type.getEvaluatedCount() == nodeData.getSignatureSize()) {
+                evaluatedExecute = true;
+                break;
+            }
+        }
+        if (!evaluatedExecute) {
+            nodeData.addError("@%s nodes require an overridable execute method with %s evaluated arguments.", annotationName, nodeData.getSignatureSize());
+        }
+
+        List<ExecutableElement> constructors = ElementFilter.constructorsIn(nodeData.getTemplateType().getEnclosedElements());
+        boolean defaultConstructor = constructors.isEmpty();
+        for (ExecutableElement constructor : constructors) {
+            if (constructor.getParameters().isEmpty() && ElementUtils.getVisibility(constructor.getModifiers()) != Modifier.PRIVATE) {
+                defaultConstructor = true;
+                break;
+            }
+        }
+        if (!defaultConstructor) {
+            nodeData.addError("@%s nodes require a non-private constructor without parameters.", annotationName);
+        }
+    }
+
     private AnnotationMirror findFirstAnnotation(List<? extends Element> elements, Class<? extends Annotation> annotation) {
         for (Element element : elements) {
             AnnotationMirror mirror = ElementUtils.findAnnotationMirror(processingEnv, element, annotation);
@@ -29,6 +29,7 @@ import com.oracle.truffle.object.ObjectStorageOptions;
 import com.oracle.truffle.object.ShapeImpl;
 import com.oracle.truffle.object.basic.BasicLocations.SimpleLongFieldLocation;
 import com.oracle.truffle.object.basic.BasicLocations.SimpleObjectFieldLocation;
+import com.oracle.truffle.object.debug.ShapeChurnProfiler;
 import java.lang.annotation.Retention;
 import java.lang.annotation.RetentionPolicy;
 
@@ -211,6 +212,10 @@ public class DynamicObjectBasic extends DynamicObjectImpl {
 
     protected final void reshape(ShapeImpl newShape) {
         reshapeCount.inc();
+        ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+        if (churnProfiler != null) {
+            churnProfiler.onReshape();
+        }
 
         ShapeImpl oldShape = getShape();
         ShapeImpl commonAncestor = ShapeImpl.findCommonAncestor(oldShape, newShape);
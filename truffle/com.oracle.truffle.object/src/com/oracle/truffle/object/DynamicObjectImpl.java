@@ -29,6 +29,7 @@ import com.oracle.truffle.api.object.LocationFactory;
 import com.oracle.truffle.api.object.Property;
 import com.oracle.truffle.api.object.Shape;
 import com.oracle.truffle.object.Locations.ValueLocation;
+import com.oracle.truffle.object.debug.ShapeChurnProfiler;
 
 public abstract class DynamicObjectImpl extends DynamicObject implements Cloneable {
     private ShapeImpl shape;
@@ -43,6 +44,10 @@ public abstract class DynamicObjectImpl extends DynamicObject implements Cloneab
         if (ObjectStorageOptions.Profile) {
             Debug.trackObject(this);
         }
+        ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+        if (churnProfiler != null) {
+            churnProfiler.onAllocate(shape);
+        }
     }
 
     public Object getTypeIdentifier() {
@@ -69,6 +74,10 @@ public abstract class DynamicObjectImpl extends DynamicObject implements Cloneab
     public final void setShapeAndResize(Shape oldShape, Shape newShape) {
         assert getShape() == oldShape : "wrong old shape";
         if (oldShape != newShape) {
+            ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+            if (churnProfiler != null) {
+                churnProfiler.onShapeChange((ShapeImpl) oldShape, (ShapeImpl) newShape);
+            }
             setShape(newShape);
             resizeStore(oldShape, newShape);
 
@@ -88,6 +97,10 @@ public abstract class DynamicObjectImpl extends DynamicObject implements Cloneab
         assert getShape() == oldShape : "wrong old shape";
         if (oldShape != newShape) {
             assert checkSetShape(oldShape, newShape);
+            ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+            if (churnProfiler != null) {
+                churnProfiler.onShapeChange((ShapeImpl) oldShape, (ShapeImpl) newShape);
+            }
 
             setShape(newShape);
             growStore(oldShape, newShape);
@@ -296,7 +309,12 @@ public abstract class DynamicObjectImpl extends DynamicObject implements Cloneab
 
     @Override
     public final boolean updateShape() {
-        return getShape().getLayout().getStrategy().updateShape(this);
+        boolean updated = getShape().getLayout().getStrategy().updateShape(this);
+        ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+        if (churnProfiler != null && updated) {
+            churnProfiler.onUpdateShape();
+        }
+        return updated;
     }
 
     @Override
@@ -48,6 +48,7 @@ public class ObjectStorageOptions {
 
     public static final boolean Profile = booleanOption(OPTION_PREFIX + "Profile", false);
     public static final int ProfileTopResults = Integer.getInteger(OPTION_PREFIX + "ProfileTopResults", -1);
+    public static final boolean ProfileShapeChurn = booleanOption(OPTION_PREFIX + "ProfileShapeChurn", false);
 
     public static boolean booleanOption(String name, boolean defaultValue) {
         String value = System.getProperty(name);
@@ -64,6 +64,7 @@ import com.oracle.truffle.object.Transition.ObjectTypeTransition;
 import com.oracle.truffle.object.Transition.PropertyTransition;
 import com.oracle.truffle.object.Transition.RemovePropertyTransition;
 import com.oracle.truffle.object.Transition.ReservePrimitiveArrayTransition;
+import com.oracle.truffle.object.debug.ShapeChurnProfiler;
 
 /**
  * Shape objects create a mapping of Property objects to indexes. The mapping of those indexes to an
@@ -320,13 +321,22 @@ public abstract class ShapeImpl extends Shape {
         ShapeImpl cachedShape = this.getTransitionMapForRead().get(transition);
         if (cachedShape != null) { // Shape already exists?
             shapeCacheHitCount.inc();
-            return ensureValid ? layout.getStrategy().ensureValid(cachedShape) : cachedShape;
+            return ensureValid ? ensureValid(cachedShape) : cachedShape;
         }
         shapeCacheMissCount.inc();
 
         return null;
     }
 
+    private ShapeImpl ensureValid(ShapeImpl shape) {
+        ShapeImpl validShape = layout.getStrategy().ensureValid(shape);
+        ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+        if (churnProfiler != null) {
+            churnProfiler.onEnsureValid(shape, validShape);
+        }
+        return validShape;
+    }
+
     /**
      * Add a new property in the map, yielding a new or cached Shape object.
      *
@@ -358,7 +368,7 @@ public abstract class ShapeImpl extends Shape {
     public ShapeImpl defineProperty(Object key, Object value, int flags, LocationFactory locationFactory) {
         ShapeImpl oldShape = this;
         if (!oldShape.isValid()) {
-            oldShape = layout.getStrategy().ensureValid(oldShape);
+            oldShape = ensureValid(oldShape);
         }
         PropertyImpl existing = (PropertyImpl) oldShape.getProperty(key);
         if (existing == null) {
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.object.debug;
+
+import java.io.File;
+import java.io.FileNotFoundException;
+import java.io.PrintWriter;
+import java.io.UnsupportedEncodingException;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+import com.oracle.truffle.api.Assumption;
+import com.oracle.truffle.api.CompilerDirectives.TruffleBoundary;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.frame.FrameInstance;
+import com.oracle.truffle.api.frame.FrameInstanceVisitor;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.object.Shape;
+import com.oracle.truffle.api.source.SourceSection;
+import com.oracle.truffle.api.utilities.JSONHelper;
+import com.oracle.truffle.api.utilities.JSONHelper.JSONArrayBuilder;
+import com.oracle.truffle.api.utilities.JSONHelper.JSONObjectBuilder;
+import com.oracle.truffle.object.DebugShapeVisitor;
+import com.oracle.truffle.object.ObjectStorageOptions;
+import com.oracle.truffle.object.ShapeImpl;
+
+/**
+ * Records shape churn per site: allocations, shape changes, distinct shapes and transitions,
+ * obsolete shape updates, reshapes, {@code ensureValid} replacements and extension array growth, so
+ * that code defeating inline caches can be found. A site is the node a guest language
+ * {@linkplain #enterSite(Object) entered}, such as its property write node, and otherwise the call
+ * node of the innermost guest language call. Nodes are identified by their source section.
+ * Allocations are also counted per shape.
+ * <p>
+ * Enabled with {@code -Dcom.oracle.truffle.object.ProfileShapeChurn=true}; the profile is written
+ * at shutdown to {@code shapechurn.json} in {@link ObjectStorageOptions#DumpShapesPath}. A profiler
+ * can also be {@linkplain #install(ShapeChurnProfiler) installed} programmatically. Shapes are
+ * referred to by the ids used by {@link JSONShapeVisitor}, so the profile can be joined with a
+ * {@code DumpShapesJSON} dump.
+ */
+public final class ShapeChurnProfiler {
+    /** Size assumed for an extension array slot. */
+    private static final int SLOT_BYTES = 8;
+
+    private static final Assumption NOT_INSTALLED = Truffle.getRuntime().createAssumption("no shape churn profiler");
+    private static volatile ShapeChurnProfiler instance;
+
+    private static final String UNKNOWN_SITE = "<unknown>";
+
+    private final Map<Object, SiteStats> sites = new HashMap<>();
+    private final Map<Shape, long[]> allocations = new IdentityHashMap<>();
+    private final ThreadLocal<Object> currentSite = new ThreadLocal<>();
+
+    public ShapeChurnProfiler() {
+    }
+
+    /**
+     * Returns the profiler that is notified of shape churn, or {@code null} if shape churn is not
+     * profiled. Folds to {@code null} in compiled code until a profiler has been installed.
+     */
+    public static ShapeChurnProfiler getInstance() {
+        return NOT_INSTALLED.isValid() ? null : instance;
+    }
+
+    /**
+     * Sets the profiler that is notified of shape churn; {@code null} disables profiling.
+     */
+    public static void install(ShapeChurnProfiler profiler) {
+        instance = profiler;
+        NOT_INSTALLED.invalidate();
+    }
+
+    /**
+     * Attributes the shape churn of the current thread to a site, typically the node that is about
+     * to write a property, until {@link #exitSite(Object)} is called with the returned previous
+     * site.
+     */
+    @TruffleBoundary
+    public Object enterSite(Object site) {
+        Object previous = currentSite.get();
+        currentSite.set(site);
+        return previous;
+    }
+
+    @TruffleBoundary
+    public void exitSite(Object previousSite) {
+        currentSite.set(previousSite);
+    }
+
+    @TruffleBoundary
+    public synchronized void onAllocate(Shape shape) {
+        getSite().allocations++;
+        long[] count = allocations.get(shape);
+        if (count == null) {
+            allocations.put(shape, count = new long[1]);
+        }
+        count[0]++;
+    }
+
+    @TruffleBoundary
+    public synchronized void onShapeChange(ShapeImpl oldShape, ShapeImpl newShape) {
+        SiteStats stats = getSite();
+        stats.shapeChanges++;
+        stats.shapes.add(newShape);
+        stats.transitions.add(DebugShapeVisitor.getId(oldShape) + "->" + DebugShapeVisitor.getId(newShape));
+        int growth = Math.max(0, newShape.getObjectArrayCapacity() - oldShape.getObjectArrayCapacity());
+        if (newShape.hasPrimitiveArray()) {
+            growth += Math.max(0, newShape.getPrimitiveArrayCapacity() - oldShape.getPrimitiveArrayCapacity());
+        }
+        stats.growthBytes += (long) growth * SLOT_BYTES;
+    }
+
+    @TruffleBoundary
+    public synchronized void onUpdateShape() {
+        getSite().updateShapes++;
+    }
+
+    @TruffleBoundary
+    public synchronized void onReshape() {
+        getSite().reshapes++;
+    }
+
+    @TruffleBoundary
+    public synchronized void onEnsureValid(ShapeImpl invalidShape, ShapeImpl validShape) {
+        if (invalidShape != validShape) {
+            getSite().ensureValids++;
+        }
+    }
+
+    /**
+     * Gets the number of recorded allocations with a shape.
+     */
+    public synchronized long getAllocationCount(Shape shape) {
+        long[] count = allocations.get(shape);
+        return count == null ? 0 : count[0];
+    }
+
+    /**
+     * Gets the recorded counts of a site as {@code [allocations, shape changes, distinct shapes,
+     * distinct transitions, updateShape, reshape, ensureValid, extension growth bytes]}, or
+     * {@code null} if nothing was recorded for the site. A node site may also be given by its
+     * source section.
+     */
+    public synchronized long[] getSiteCounts(Object site) {
+        SiteStats stats = sites.get(siteKey(site));
+        if (stats == null) {
+            return null;
+        }
+        return new long[]{stats.allocations, stats.shapeChanges, stats.shapes.size(), stats.transitions.size(), stats.updateShapes, stats.reshapes, stats.ensureValids, stats.growthBytes};
+    }
+
+    private SiteStats getSite() {
+        Object site = currentSite.get();
+        if (site == null) {
+            site = findCallSite();
+        }
+        Object key = siteKey(site);
+        SiteStats stats = sites.get(key);
+        if (stats == null) {
+            sites.put(key, stats = new SiteStats(key));
+        }
+        return stats;
+    }
+
+    /**
+     * The call node of the innermost guest language call, or the current call target if there is
+     * none.
+     */
+    private static Object findCallSite() {
+        Node callNode = Truffle.getRuntime().iterateFrames(new FrameInstanceVisitor<Node>() {
+            public Node visitFrame(FrameInstance frameInstance) {
+                return frameInstance.getCallNode();
+            }
+        });
+        if (callNode != null) {
+            return callNode;
+        }
+        FrameInstance current = Truffle.getRuntime().getCurrentFrame();
+        return current == null || current.getCallTarget() == null ? UNKNOWN_SITE : current.getCallTarget();
+    }
+
+    private static Object siteKey(Object site) {
+        if (site instanceof Node) {
+            SourceSection section = ((Node) site).getEncapsulatingSourceSection();
+            if (section != null) {
+                return section;
+            }
+        }
+        return site;
+    }
+
+    public synchronized JSONObjectBuilder toJSON() {
+        List<SiteStats> allStats = new ArrayList<>(sites.values());
+        Collections.sort(allStats, new Comparator<SiteStats>() {
+            public int compare(SiteStats a, SiteStats b) {
+                return Integer.compare(b.transitions.size(), a.transitions.size());
+            }
+        });
+        JSONArrayBuilder sitesarray = JSONHelper.array();
+        for (SiteStats stats : allStats) {
+            sitesarray.add(stats.toJSON());
+        }
+        JSONArrayBuilder allocationsarray = JSONHelper.array();
+        for (Map.Entry<Shape, long[]> entry : allocations.entrySet()) {
+            allocationsarray.add(JSONHelper.object().add("shape", DebugShapeVisitor.getId(entry.getKey())).add("count", entry.getValue()[0]));
+        }
+        return JSONHelper.object().add("sites", sitesarray).add("allocations", allocationsarray);
+    }
+
+    public void dump(PrintWriter out) {
+        out.println(toJSON());
+        out.flush();
+    }
+
+    private static class SiteStats {
+        private final Object site;
+        private final Set<Shape> shapes = Collections.newSetFromMap(new IdentityHashMap<Shape, Boolean>());
+        private final Set<String> transitions = new HashSet<>();
+        private long allocations;
+        private long shapeChanges;
+        private long updateShapes;
+        private long reshapes;
+        private long ensureValids;
+        private long growthBytes;
+
+        SiteStats(Object site) {
+            this.site = site;
+        }
+
+        JSONObjectBuilder toJSON() {
+            JSONArrayBuilder shapesarray = JSONHelper.array();
+            for (Shape shape : shapes) {
+                shapesarray.add(DebugShapeVisitor.getId(shape));
+            }
+            JSONArrayBuilder transitionarray = JSONHelper.array();
+            for (String transition : transitions) {
+                int arrow = transition.indexOf("->");
+                transitionarray.add(JSONHelper.object().add("predecessor", transition.substring(0, arrow)).add("successor", transition.substring(arrow + 2)));
+            }
+            JSONObjectBuilder sb = JSONHelper.object();
+            sb.add("site", site instanceof SourceSection ? ((SourceSection) site).getShortDescription() : String.valueOf(site));
+            sb.add("allocations", allocations);
+            sb.add("shapeChanges", shapeChanges);
+            sb.add("distinctShapes", shapes.size());
+            sb.add("distinctTransitions", transitions.size());
+            sb.add("updateShape", updateShapes);
+            sb.add("reshape", reshapes);
+            sb.add("ensureValid", ensureValids);
+            sb.add("extensionGrowthBytes", growthBytes);
+            sb.add("shapes", shapesarray);
+            sb.add("transitions", transitionarray);
+            return sb;
+        }
+    }
+
+    static {
+        if (ObjectStorageOptions.ProfileShapeChurn) {
+            install(new ShapeChurnProfiler());
+            Runtime.getRuntime().addShutdownHook(new Thread() {
+                @Override
+                public void run() {
+                    ShapeChurnProfiler profiler = getInstance();
+                    if (profiler == null) {
+                        return;
+                    }
+                    File file = Paths.get(ObjectStorageOptions.DumpShapesPath, "shapechurn.json").toFile();
+                    try (PrintWriter out = new PrintWriter(file, "UTF-8")) {
+                        profiler.dump(out);
+                    } catch (FileNotFoundException | UnsupportedEncodingException e) {
+                        throw new RuntimeException(e);
+                    }
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.bench;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+import com.oracle.truffle.api.interop.java.JavaInterop;
+import com.oracle.truffle.api.source.Source;
+
+/**
+ * An SL benchmark program: a source defining a function {@code run()} that performs one iteration
+ * of the benchmark, plus the global symbols the program {@code import}s.
+ */
+public final class SLBenchmark {
+
+    /** The function called once per iteration. */
+    public static final String RUN_FUNCTION = "run";
+
+    private final String name;
+    private final Source source;
+    private final Map<String, Object> globals;
+
+    public SLBenchmark(String name, Source source, Map<String, Object> globals) {
+        this.name = name;
+        this.source = source;
+        this.globals = Collections.unmodifiableMap(new LinkedHashMap<>(globals));
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    public Source getSource() {
+        return source;
+    }
+
+    /** Symbols to register with {@code PolyglotEngine.Builder.globalSymbol} before evaluation. */
+    public Map<String, Object> getGlobals() {
+        return globals;
+    }
+
+    /**
+     * Loads a benchmark bundled with this class from {@code /benchmarks/<name>.sl}.
+     */
+    public static SLBenchmark load(String name, Map<String, Object> globals) throws IOException {
+        final String resource = "/benchmarks/" + name + ".sl";
+        final InputStream stream = SLBenchmark.class.getResourceAsStream(resource);
+        if (stream == null) {
+            throw new IOException("No benchmark " + resource);
+        }
+        try (InputStreamReader reader = new InputStreamReader(stream, "UTF-8")) {
+            return new SLBenchmark(name, Source.fromReader(reader, name + ".sl").withMimeType("application/x-sl"), globals);
+        }
+    }
+
+    /**
+     * Java function imported by the {@code InteropCall} benchmark.
+     */
+    public interface Increment {
+        Object apply(Object value);
+    }
+
+    /**
+     * The default suite: recursive calls, object allocation, string building, building a string of
+     * one million characters by repeated concatenation, property access on several shapes and
+     * calls to a Java function through interop.
+     */
+    public static List<SLBenchmark> defaultSuite() throws IOException {
+        final Map<String, Object> none = Collections.emptyMap();
+        final Map<String, Object> interop = new LinkedHashMap<>();
+        interop.put("inc", JavaInterop.asTruffleFunction(Increment.class, new Increment() {
+            public Object apply(Object value) {
+                return ((Number) value).longValue() + 1;
+            }
+        }));
+        final List<SLBenchmark> suite = new ArrayList<>();
+        suite.add(load("Fibonacci", none));
+        suite.add(load("ObjectChurn", none));
+        suite.add(load("StringBuilding", none));
+        suite.add(load("StringConcat", none));
+        suite.add(load("PropertyAccess", none));
+        suite.add(load("InteropCall", interop));
+        return suite;
+    }
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.bench;
+
+import java.util.Arrays;
+
+import com.oracle.truffle.api.utilities.JSONHelper;
+import com.oracle.truffle.api.utilities.JSONHelper.JSONObjectBuilder;
+
+/**
+ * Measurements of one fork of an {@link SLBenchmark}: the iterations after warm-up, with their
+ * wall clock time and allocated bytes.
+ */
+public final class SLBenchmarkResult {
+
+    /** Column names of {@link #toCSV()}. */
+    public static final String CSV_HEADER = "benchmark,fork,warmupIterations,steady,iterations,meanNanos,medianNanos,p99Nanos,minNanos,maxNanos,stddevNanos,meanAllocatedBytes";
+
+    private final String name;
+    private final int fork;
+    private final int warmupIterations;
+    private final boolean steady;
+    private final long[] sortedNanos;
+    private final long[] allocatedBytes;
+
+    /**
+     * @param allocatedBytes bytes allocated per iteration, or {@code null} if the VM cannot measure
+     *            thread allocation
+     */
+    public SLBenchmarkResult(String name, int fork, int warmupIterations, boolean steady, long[] nanos, long[] allocatedBytes) {
+        this.name = name;
+        this.fork = fork;
+        this.warmupIterations = warmupIterations;
+        this.steady = steady;
+        this.sortedNanos = nanos.clone();
+        Arrays.sort(this.sortedNanos);
+        this.allocatedBytes = allocatedBytes;
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    public int getFork() {
+        return fork;
+    }
+
+    /** Number of iterations run before measuring. */
+    public int getWarmupIterations() {
+        return warmupIterations;
+    }
+
+    /** Whether warm-up ended because a steady state was detected rather than by its limit. */
+    public boolean isSteady() {
+        return steady;
+    }
+
+    public int getIterations() {
+        return sortedNanos.length;
+    }
+
+    public double getMean() {
+        return mean(sortedNanos);
+    }
+
+    public long getMedian() {
+        return percentile(50);
+    }
+
+    public long getP99() {
+        return percentile(99);
+    }
+
+    public long getMin() {
+        return sortedNanos[0];
+    }
+
+    public long getMax() {
+        return sortedNanos[sortedNanos.length - 1];
+    }
+
+    public double getStandardDeviation() {
+        return standardDeviation(sortedNanos);
+    }
+
+    /** Mean bytes allocated per iteration, or -1 if not measured. */
+    public double getMeanAllocatedBytes() {
+        return allocatedBytes == null ? -1 : mean(allocatedBytes);
+    }
+
+    /** Nearest-rank percentile of the iteration times. */
+    public long percentile(int p) {
+        final int rank = (int) Math.ceil(p / 100.0 * sortedNanos.length);
+        return sortedNanos[Math.max(0, rank - 1)];
+    }
+
+    static double mean(long[] values) {
+        double sum = 0;
+        for (long value : values) {
+            sum += value;
+        }
+        return sum / values.length;
+    }
+
+    static double standardDeviation(long[] values) {
+        final double mean = mean(values);
+        double sum = 0;
+        for (long value : values) {
+            sum += (value - mean) * (value - mean);
+        }
+        return Math.sqrt(sum / values.length);
+    }
+
+    public String toCSV() {
+        return String.format("%s,%d,%d,%b,%d,%.0f,%d,%d,%d,%d,%.0f,%.0f", name, fork, warmupIterations, steady, getIterations(), getMean(), getMedian(), getP99(), getMin(), getMax(),
+                        getStandardDeviation(), getMeanAllocatedBytes());
+    }
+
+    public JSONObjectBuilder toJSON() {
+        return JSONHelper.object().add("benchmark", name).add("fork", fork).add("warmupIterations", warmupIterations).add("steady", steady).add("iterations", getIterations()).add("meanNanos",
+                        Math.round(getMean())).add("medianNanos", getMedian()).add("p99Nanos", getP99()).add("minNanos", getMin()).add("maxNanos", getMax()).add("stddevNanos",
+                                        Math.round(getStandardDeviation())).add("meanAllocatedBytes", Math.round(getMeanAllocatedBytes()));
+    }
+
+    @Override
+    public String toString() {
+        return String.format("%-16s fork %d: %s after %d warm-up iterations, mean %.3f ms, median %.3f ms, p99 %.3f ms, %.0f bytes/iteration", name, fork, steady ? "steady" : "NOT steady",
+                        warmupIterations, getMean() / 1e6, getMedian() / 1e6, getP99() / 1e6, getMeanAllocatedBytes());
+    }
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.bench;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.PrintStream;
+import java.io.PrintWriter;
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadMXBean;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.utilities.JSONHelper;
+import com.oracle.truffle.api.utilities.JSONHelper.JSONArrayBuilder;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.api.vm.PolyglotEngine.Value;
+
+/**
+ * Runs {@link SLBenchmark SL benchmarks}, each fork in a fresh {@link PolyglotEngine}. A fork warms
+ * up until the coefficient of variation of the last {@code window} iteration times drops below a
+ * threshold, or until the warm-up limit, and then measures a fixed number of iterations.
+ * <p>
+ * Use the mx command "mx slbench" to run it with the correct class path setup:
+ *
+ * <pre>
+ * mx slbench [--forks n] [--warmup n] [--iterations n] [--window n] [--threshold x]
+ *            [--csv file] [--json file] [benchmark ...]
+ * </pre>
+ */
+public final class SLBenchmarkRunner {
+
+    private int forks = 3;
+    private int maxWarmupIterations = 200;
+    private int iterations = 20;
+    private int window = 10;
+    private double threshold = 0.05;
+
+    private final ThreadMXBean threadBean = ManagementFactory.getThreadMXBean();
+
+    public void setForks(int forks) {
+        this.forks = forks;
+    }
+
+    public void setMaxWarmupIterations(int maxWarmupIterations) {
+        this.maxWarmupIterations = maxWarmupIterations;
+    }
+
+    public void setIterations(int iterations) {
+        this.iterations = iterations;
+    }
+
+    /**
+     * Sets the steady state criterion: the last {@code window} iterations must have a coefficient
+     * of variation below {@code threshold}.
+     */
+    public void setSteadyState(int window, double threshold) {
+        this.window = window;
+        this.threshold = threshold;
+    }
+
+    public List<SLBenchmarkResult> run(SLBenchmark benchmark) throws IOException {
+        final List<SLBenchmarkResult> results = new ArrayList<>();
+        for (int fork = 0; fork < forks; fork++) {
+            results.add(runFork(benchmark, fork));
+        }
+        return results;
+    }
+
+    private SLBenchmarkResult runFork(SLBenchmark benchmark, int fork) throws IOException {
+        final PolyglotEngine.Builder builder = PolyglotEngine.newBuilder().setOut(new ByteArrayOutputStream());
+        for (Map.Entry<String, Object> global : benchmark.getGlobals().entrySet()) {
+            builder.globalSymbol(global.getKey(), global.getValue());
+        }
+        final PolyglotEngine engine = builder.build();
+        try {
+            engine.eval(forkSource(benchmark.getSource(), fork));
+            final Value run = engine.findGlobalSymbol(SLBenchmark.RUN_FUNCTION);
+            if (run == null) {
+                throw new IOException("No function " + SLBenchmark.RUN_FUNCTION + "() defined in " + benchmark.getName());
+            }
+
+            final long[] recent = new long[window];
+            int warmup = 0;
+            boolean steady = false;
+            while (warmup < maxWarmupIterations && !steady) {
+                recent[warmup % window] = iterate(run);
+                warmup++;
+                steady = warmup >= window && isSteady(recent);
+            }
+
+            final long[] nanos = new long[iterations];
+            final long[] allocated = isAllocationMeasurable() ? new long[iterations] : null;
+            final long threadId = Thread.currentThread().getId();
+            for (int i = 0; i < iterations; i++) {
+                final long allocatedBefore = allocated == null ? 0 : allocatedBytes(threadId);
+                nanos[i] = iterate(run);
+                if (allocated != null) {
+                    allocated[i] = allocatedBytes(threadId) - allocatedBefore;
+                }
+            }
+            return new SLBenchmarkResult(benchmark.getName(), fork, warmup, steady, nanos, allocated);
+        } finally {
+            engine.dispose();
+        }
+    }
+
+    /**
+     * A copy of a benchmark source that is distinct for every fork. Sources are equal if their
+     * names and code are, and SL caches parsed sources, so reusing the benchmark source would let
+     * later forks start from the AST already specialized by earlier ones.
+     */
+    private static Source forkSource(Source source, int fork) {
+        return Source.fromText(source.getCode(), source.getName() + "#fork" + fork).withMimeType(source.getMimeType());
+    }
+
+    private static long iterate(Value run) throws IOException {
+        final long start = System.nanoTime();
+        run.execute();
+        return System.nanoTime() - start;
+    }
+
+    private boolean isSteady(long[] recent) {
+        final double mean = SLBenchmarkResult.mean(recent);
+        return mean > 0 && SLBenchmarkResult.standardDeviation(recent) / mean < threshold;
+    }
+
+    private boolean isAllocationMeasurable() {
+        return threadBean instanceof com.sun.management.ThreadMXBean && ((com.sun.management.ThreadMXBean) threadBean).isThreadAllocatedMemorySupported() &&
+                        ((com.sun.management.ThreadMXBean) threadBean).isThreadAllocatedMemoryEnabled();
+    }
+
+    private long allocatedBytes(long threadId) {
+        return ((com.sun.management.ThreadMXBean) threadBean).getThreadAllocatedBytes(threadId);
+    }
+
+    public static void writeCSV(List<SLBenchmarkResult> results, PrintWriter out) {
+        out.println(SLBenchmarkResult.CSV_HEADER);
+        for (SLBenchmarkResult result : results) {
+            out.println(result.toCSV());
+        }
+        out.flush();
+    }
+
+    public static void writeJSON(List<SLBenchmarkResult> results, PrintWriter out) {
+        final JSONArrayBuilder array = JSONHelper.array();
+        for (SLBenchmarkResult result : results) {
+            array.add(result.toJSON());
+        }
+        out.println(JSONHelper.object().add("results", array));
+        out.flush();
+    }
+
+    /**
+     * The main entry point. Runs the named benchmarks of the {@linkplain SLBenchmark#defaultSuite()
+     * default suite}, or all of them.
+     */
+    public static void main(String[] args) throws IOException {
+        final SLBenchmarkRunner runner = new SLBenchmarkRunner();
+        String csvFile = null;
+        String jsonFile = null;
+        int window = runner.window;
+        double threshold = runner.threshold;
+        final List<String> names = new ArrayList<>();
+        for (int i = 0; i < args.length; i++) {
+            switch (args[i]) {
+                case "--forks":
+                    runner.setForks(Integer.parseInt(args[++i]));
+                    break;
+                case "--warmup":
+                    runner.setMaxWarmupIterations(Integer.parseInt(args[++i]));
+                    break;
+                case "--iterations":
+                    runner.setIterations(Integer.parseInt(args[++i]));
+                    break;
+                case "--window":
+                    window = Integer.parseInt(args[++i]);
+                    break;
+                case "--threshold":
+                    threshold = Double.parseDouble(args[++i]);
+                    break;
+                case "--csv":
+                    csvFile = args[++i];
+                    break;
+                case "--json":
+                    jsonFile = args[++i];
+                    break;
+                default:
+                    names.add(args[i]);
+            }
+        }
+        runner.setSteadyState(window, threshold);
+
+        final PrintStream out = System.out;
+        final List<SLBenchmarkResult> results = new ArrayList<>();
+        for (SLBenchmark benchmark : SLBenchmark.defaultSuite()) {
+            if (names.isEmpty() || names.contains(benchmark.getName())) {
+                for (SLBenchmarkResult result : runner.run(benchmark)) {
+                    out.println(result);
+                    results.add(result);
+                }
+            }
+        }
+        if (csvFile != null) {
+            try (PrintWriter writer = new PrintWriter(csvFile, "UTF-8")) {
+                writeCSV(results, writer);
+            }
+        }
+        if (jsonFile != null) {
+            try (PrintWriter writer = new PrintWriter(jsonFile, "UTF-8")) {
+                writeJSON(results, writer);
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.bench;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.concurrent.atomic.AtomicReference;
+
+import com.oracle.truffle.api.debug.ExecutionEvent;
+import com.oracle.truffle.api.debug.SuspendedEvent;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.vm.EventConsumer;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+
+/**
+ * Measures how long the debugger takes to step over a recursive call of increasing depth. A step
+ * over a call four times as deep executes four times as many statements, so the reported ratio
+ * stays near four as long as the stack depth query of the stepping strategies is constant time.
+ * <p>
+ * Use the mx command "mx slstepbench" to run it with the correct class path setup:
+ *
+ * <pre>
+ * mx slstepbench [depth [runs]]
+ * </pre>
+ */
+public final class SLStepOverBenchmark {
+
+    private static final long STACK_SIZE = 512L * 1024 * 1024;
+
+    // @formatter:off
+    private static final String RECURSION =
+        "function rec(n) {\n" +
+        "  if (n <= 0) {\n" +
+        "    return 0;\n" +
+        "  }\n" +
+        "  r = rec(n - 1);\n" +
+        "  return r + 1;\n" +
+        "}\n" +
+        "function main(n) {\n" +
+        "  return rec(n);\n" +
+        "}\n";
+    // @formatter:on
+
+    public static void main(String[] args) throws Throwable {
+        final int depth = args.length > 0 ? Integer.parseInt(args[0]) : 1000;
+        final int runs = args.length > 1 ? Integer.parseInt(args[1]) : 5;
+        final long shallow = fastestStepOver(depth, runs);
+        final long deep = fastestStepOver(4 * depth, runs);
+        System.out.printf("step-over depth %d: %d us%n", depth, shallow / 1000);
+        System.out.printf("step-over depth %d: %d us%n", 4 * depth, deep / 1000);
+        System.out.printf("ratio: %.2f%n", (double) deep / shallow);
+    }
+
+    private static long fastestStepOver(int depth, int runs) throws Throwable {
+        stepOver(depth); // warm up
+        long fastest = Long.MAX_VALUE;
+        for (int i = 0; i < runs; i++) {
+            fastest = Math.min(fastest, stepOver(depth));
+        }
+        return fastest;
+    }
+
+    /**
+     * Runs on a thread with a large stack, as the default runtime needs a lot of Java stack for
+     * deep guest language recursion.
+     */
+    private static long stepOver(int depth) throws Throwable {
+        final StepOver stepOver = new StepOver(depth);
+        final Thread thread = new Thread(null, stepOver, "step-over", STACK_SIZE);
+        thread.start();
+        thread.join();
+        if (stepOver.failure.get() != null) {
+            throw stepOver.failure.get();
+        }
+        if (stepOver.stepOverNanos == 0) {
+            throw new IllegalStateException("Step-over did not suspend after the call");
+        }
+        return stepOver.stepOverNanos;
+    }
+
+    private static final class StepOver implements Runnable {
+        private final int depth;
+        private final Source source = Source.fromText(RECURSION, "recursion.sl").withMimeType("application/x-sl");
+        private final AtomicReference<Throwable> failure = new AtomicReference<>();
+
+        private boolean breakpointSet;
+        private long stepOverStart;
+        long stepOverNanos;
+
+        StepOver(int depth) {
+            this.depth = depth;
+        }
+
+        @Override
+        public void run() {
+            try {
+                final PolyglotEngine engine = PolyglotEngine.newBuilder().onEvent(new EventConsumer<ExecutionEvent>(ExecutionEvent.class) {
+                    @Override
+                    protected void on(ExecutionEvent event) {
+                        onExecution(event);
+                    }
+                }).onEvent(new EventConsumer<SuspendedEvent>(SuspendedEvent.class) {
+                    @Override
+                    protected void on(SuspendedEvent event) {
+                        onSuspended(event);
+                    }
+                }).setOut(new ByteArrayOutputStream()).build();
+
+                engine.eval(source);
+                engine.findGlobalSymbol("main").execute(depth);
+                engine.dispose();
+            } catch (Throwable ex) {
+                failure.compareAndSet(null, ex);
+            }
+        }
+
+        private void onExecution(ExecutionEvent event) {
+            if (!breakpointSet) {
+                breakpointSet = true;
+                try {
+                    event.getDebugger().setLineBreakpoint(0, source.createLineLocation(5), true);
+                } catch (IOException ex) {
+                    failure.compareAndSet(null, ex);
+                }
+            }
+            event.prepareContinue();
+        }
+
+        private void onSuspended(SuspendedEvent event) {
+            final int line = event.getNode().getEncapsulatingSourceSection().getLineLocation().getLineNumber();
+            if (line == 5) {
+                stepOverStart = System.nanoTime();
+                event.prepareStepOver(1);
+            } else {
+                stepOverNanos = System.nanoTime() - stepOverStart;
+                event.prepareContinue();
+            }
+        }
+    }
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.test;
+
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.debug.Debugger;
+import com.oracle.truffle.api.debug.ExecutionEvent;
+import com.oracle.truffle.api.debug.SuspendedEvent;
+import com.oracle.truffle.api.frame.StackDepth;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.vm.EventConsumer;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.lang.reflect.Field;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicReference;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeNotNull;
+import org.junit.Test;
+
+/**
+ * Stepping over a deeply recursive call. The debugger queries the stack depth on every statement
+ * executed while stepping over, so the step-over is only linear in the number of executed
+ * statements as long as a query does not walk the stack. The tests count the queries and the
+ * walked frames instead of measuring time; SLStepOverBenchmark in the SL benchmark project
+ * measures the time.
+ */
+public class SLDebugStepOverTest {
+
+    private static final int DEPTH = 1000;
+    private static final int SCALING_DEPTH = 200;
+    private static final long STACK_SIZE = 64L * 1024 * 1024;
+
+    // @formatter:off
+    private static final String RECURSION =
+        "function rec(n) {\n" +
+        "  if (n <= 0) {\n" +
+        "    return 0;\n" +
+        "  }\n" +
+        "  r = rec(n - 1);\n" +
+        "  return r + 1;\n" +
+        "}\n" +
+        "function main(n) {\n" +
+        "  return rec(n);\n" +
+        "}\n";
+    // @formatter:on
+
+    @Test(timeout = 60000)
+    public void stepOverDeepRecursion() throws Throwable {
+        StepOver stepOver = StepOver.run(DEPTH);
+        assertEquals("Result of the recursion", DEPTH, stepOver.result);
+        assertEquals("Suspended after the step-over", 6, stepOver.suspendedLine);
+        assertEquals("Step-over stays in the outermost call", (long) DEPTH, stepOver.suspendedArgument);
+    }
+
+    /**
+     * Stepping over a call that is four times as deep executes four times as many statements, and
+     * so queries the stack depth four times as often. None of the queries may walk the stack, or
+     * the step-over would be quadratic in the depth.
+     */
+    @Test(timeout = 60000)
+    public void stepOverQueriesDepthWithoutWalkingFrames() throws Throwable {
+        assumeNotNull(Truffle.getRuntime().getCapability(StackDepth.class));
+        StepOver shallow = StepOver.run(SCALING_DEPTH);
+        StepOver deep = StepOver.run(4 * SCALING_DEPTH);
+        assertEquals("Frames walked at depth " + SCALING_DEPTH, 0, shallow.framesWalked);
+        assertEquals("Frames walked at depth " + 4 * SCALING_DEPTH, 0, deep.framesWalked);
+        assertTrue("Stack depth queried while stepping", shallow.depthQueries > 0);
+        assertTrue("Depth " + 4 * SCALING_DEPTH + " queried " + deep.depthQueries + " times, depth " + SCALING_DEPTH + " " + shallow.depthQueries + " times",
+                        deep.depthQueries <= 5 * shallow.depthQueries);
+    }
+
+    private static long debuggerStatistic(String name) throws ReflectiveOperationException {
+        Field field = Debugger.class.getDeclaredField(name);
+        field.setAccessible(true);
+        return ((AtomicLong) field.get(null)).get();
+    }
+
+    private static final class StepOver implements Runnable {
+        private final int depth;
+        private final Source source = Source.fromText(RECURSION, "recursion.sl").withMimeType("application/x-sl");
+        private final AtomicReference<Throwable> failure = new AtomicReference<>();
+
+        private boolean breakpointSet;
+        private long queriesAtStart;
+        private long framesWalkedAtStart;
+        long depthQueries;
+        long framesWalked;
+        int suspendedLine;
+        Object suspendedArgument;
+        int result;
+
+        private StepOver(int depth) {
+            this.depth = depth;
+        }
+
+        /**
+         * Runs on a thread with a large stack, as the default runtime needs a lot of Java stack
+         * for deep guest language recursion.
+         */
+        static StepOver run(int depth) throws Throwable {
+            StepOver stepOver = new StepOver(depth);
+            Thread thread = new Thread(null, stepOver, "step-over", STACK_SIZE);
+            thread.start();
+            thread.join();
+            if (stepOver.failure.get() != null) {
+                throw stepOver.failure.get();
+            }
+            return stepOver;
+        }
+
+        @Override
+        public void run() {
+            try {
+                PolyglotEngine engine = PolyglotEngine.newBuilder().onEvent(new EventConsumer<ExecutionEvent>(ExecutionEvent.class) {
+                    @Override
+                    protected void on(ExecutionEvent event) {
+                        onExecution(event);
+                    }
+                }).onEvent(new EventConsumer<SuspendedEvent>(SuspendedEvent.class) {
+                    @Override
+                    protected void on(SuspendedEvent event) {
+                        onSuspended(event);
+                    }
+                }).setOut(new ByteArrayOutputStream()).build();
+
+                assertNull("Parsing done", engine.eval(source).get());
+                result = engine.findGlobalSymbol("main").execute(depth).as(Number.class).intValue();
+                engine.dispose();
+            } catch (Throwable ex) {
+                failure.compareAndSet(null, ex);
+            }
+        }
+
+        private void onExecution(ExecutionEvent event) {
+            if (!breakpointSet) {
+                breakpointSet = true;
+                try {
+                    event.getDebugger().setLineBreakpoint(0, source.createLineLocation(5), true);
+                } catch (IOException ex) {
+                    failure.compareAndSet(null, ex);
+                }
+            }
+            event.prepareContinue();
+        }
+
+        private void onSuspended(SuspendedEvent event) {
+            int line = event.getNode().getEncapsulatingSourceSection().getLineLocation().getLineNumber();
+            try {
+                if (line == 5) {
+                    queriesAtStart = debuggerStatistic("stackDepthQueries");
+                    framesWalkedAtStart = debuggerStatistic("stackDepthFramesWalked");
+                    event.prepareStepOver(1);
+                } else {
+                    depthQueries = debuggerStatistic("stackDepthQueries") - queriesAtStart;
+                    framesWalked = debuggerStatistic("stackDepthFramesWalked") - framesWalkedAtStart;
+                    suspendedLine = line;
+                    suspendedArgument = event.getFrame().getArguments()[0];
+                    event.prepareContinue();
+                }
+            } catch (ReflectiveOperationException ex) {
+                failure.compareAndSet(null, ex);
+                event.prepareContinue();
+            }
+        }
+    }
+}
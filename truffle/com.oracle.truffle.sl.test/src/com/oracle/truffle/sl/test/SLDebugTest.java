@@ -177,6 +177,61 @@ public class SLDebugTest {
         assertEquals("Factorial computed OK", 2, n.intValue());
     }
 
+    @Test
+    public void logpointDoesNotHalt() throws Throwable {
+        // @formatter:off
+        factorial = Source.fromText(
+            "function main() {\n" +
+            "  i = 0;\n" +
+            "  while (i < 5) {\n" +
+            "    i = i + 1;\n" +
+            "  }\n" +
+            "  return i;\n" +
+            "}\n", "loop.sl"
+        ).withMimeType("application/x-sl");
+        // @formatter:on
+
+        final StringBuilder log = new StringBuilder();
+        PolyglotEngine engine = PolyglotEngine.newBuilder().onEvent(new EventConsumer<ExecutionEvent>(ExecutionEvent.class) {
+            @Override
+            protected void on(ExecutionEvent event) {
+                onExecution(event);
+            }
+        }).onEvent(new EventConsumer<SuspendedEvent>(SuspendedEvent.class) {
+            @Override
+            protected void on(SuspendedEvent event) {
+                onSuspended(event);
+            }
+        }).setOut(new ByteArrayOutputStream()).build();
+
+        onEvent(new Callable<Void>() {
+            @Override
+            public Void call() throws Exception {
+                debugger.setLineLogpoint(0, factorial.createLineLocation(4), "function log() { return 42; }", log);
+                executionEvent.prepareContinue();
+                return null;
+            }
+        });
+
+        assertNull("Parsing done", engine.eval(factorial).get());
+        assertExecutedOK();
+
+        onEvent(new Callable<Void>() {
+            @Override
+            public Void call() throws Exception {
+                executionEvent.prepareContinue();
+                return null;
+            }
+        });
+
+        PolyglotEngine.Value value = engine.findGlobalSymbol("main").execute();
+        assertExecutedOK();
+
+        assertNull("Logpoint never halts", suspendedEvent);
+        assertEquals(5, value.as(Number.class).intValue());
+        assertEquals("One entry per iteration", "42\n42\n42\n42\n42\n", log.toString());
+    }
+
     void onExecution(ExecutionEvent event) {
         executionEvent = event;
         debugger = event.getDebugger();
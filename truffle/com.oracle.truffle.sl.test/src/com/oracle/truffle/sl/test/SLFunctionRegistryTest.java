@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.test;
+
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.sl.runtime.SLContext;
+import com.oracle.truffle.sl.runtime.SLFunction;
+import com.oracle.truffle.sl.runtime.SLFunctionRegistry;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicReference;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import org.junit.Test;
+
+public class SLFunctionRegistryTest {
+
+    private static final int THREADS = 8;
+    private static final int NAMES = 100;
+    private static final int REDEFINITIONS = 200;
+
+    @Test
+    public void concurrentLookupCreatesOneFunctionPerName() throws Exception {
+        final SLFunctionRegistry registry = new SLFunctionRegistry();
+        final SLFunction[][] found = new SLFunction[THREADS][NAMES];
+        final CountDownLatch start = new CountDownLatch(1);
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            final int index = t;
+            threads[t] = new Thread() {
+                @Override
+                public void run() {
+                    try {
+                        start.await();
+                    } catch (InterruptedException ex) {
+                        throw new IllegalStateException(ex);
+                    }
+                    for (int i = 0; i < NAMES; i++) {
+                        found[index][i] = registry.lookup("f" + i);
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        start.countDown();
+        for (Thread thread : threads) {
+            thread.join();
+        }
+
+        for (int i = 0; i < NAMES; i++) {
+            SLFunction canonical = registry.find("f" + i);
+            for (int t = 0; t < THREADS; t++) {
+                assertSame("One function per name", canonical, found[t][i]);
+            }
+        }
+        assertEquals(NAMES, registry.getFunctions().size());
+        assertNull("find does not create functions", registry.find("unknown"));
+        assertEquals(NAMES, registry.getFunctions().size());
+    }
+
+    @Test
+    public void callWhileRedefining() throws Exception {
+        PolyglotEngine engine = PolyglotEngine.newBuilder().build();
+        PolyglotEngine.Language sl = engine.getLanguages().get("application/x-sl");
+        sl.eval(Source.fromText("function f() { return 0; }\nfunction main() { return f(); }", "define"));
+        final SLContext context = (SLContext) sl.getGlobalObject().get();
+        PolyglotEngine.Value main = engine.findGlobalSymbol("main");
+
+        final AtomicReference<Throwable> failure = new AtomicReference<>();
+        Thread redefiner = new Thread() {
+            @Override
+            public void run() {
+                try {
+                    for (int i = 1; i <= REDEFINITIONS; i++) {
+                        context.evalSource(Source.fromText("function f() { return " + i + "; }", "redefine" + i));
+                    }
+                } catch (Throwable ex) {
+                    failure.set(ex);
+                }
+            }
+        };
+        redefiner.start();
+
+        long last = 0;
+        while (redefiner.isAlive()) {
+            long value = ((Number) main.execute().get()).longValue();
+            assertTrue("Call targets are published in order: " + value + " after " + last, value >= last);
+            last = value;
+        }
+        redefiner.join();
+        assertNull(failure.get());
+
+        assertEquals((long) REDEFINITIONS, ((Number) main.execute().get()).longValue());
+        engine.dispose();
+    }
+}
@@ -48,6 +48,9 @@ import com.oracle.truffle.sl.runtime.SLFunction;
 import com.oracle.truffle.sl.test.instrument.InstrumentationTestMode;
 
 import java.io.ByteArrayOutputStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
 
 import static org.junit.Assert.assertEquals;
 
@@ -86,4 +89,42 @@ public class SLJavaInteropTest {
 
         assertEquals("Called!\n", os.toString("UTF-8"));
     }
+
+    @Test
+    public void ropesArePassedAsStrings() throws Exception {
+        String scriptText = "function test(consume, holder) {\n" + //
+                        "    s = \"\";\n" + //
+                        "    i = 0;\n" + //
+                        "    while (i < 100) {\n" + //
+                        "        s = s + \"x\";\n" + //
+                        "        i = i + 1;\n" + //
+                        "    }\n" + //
+                        "    consume(s);\n" + //
+                        "    holder.value = s;\n" + //
+                        "}\n";
+        Source script = Source.fromText(scriptText, "Test").withMimeType("application/x-sl");
+        PolyglotEngine engine = PolyglotEngine.newBuilder().build();
+        engine.eval(script);
+
+        final List<String> consumed = new ArrayList<>();
+        TruffleObject consume = JavaInterop.asTruffleFunction(StringConsumer.class, new StringConsumer() {
+            public void accept(String value) {
+                consumed.add(value);
+            }
+        });
+        StringHolder holder = new StringHolder();
+        engine.findGlobalSymbol("test").execute(consume, JavaInterop.asTruffleObject(holder));
+
+        String expected = new String(new char[100]).replace('\0', 'x');
+        assertEquals(Arrays.asList(expected), consumed);
+        assertEquals(expected, holder.value);
+    }
+
+    public interface StringConsumer {
+        void accept(String value);
+    }
+
+    public static class StringHolder {
+        public String value;
+    }
 }
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertTrue;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.util.List;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.nodes.serial.NodeDeserializer;
+import com.oracle.truffle.api.nodes.serial.NodeSerializer;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.sl.SLLanguage;
+import com.oracle.truffle.sl.nodes.SLRootNode;
+import com.oracle.truffle.sl.parser.Parser;
+import com.oracle.truffle.sl.runtime.SLContext;
+
+/**
+ * Writes the ASTs of an SL source to a file, reads them back and runs them, as is done for sources
+ * evaluated with {@code -Dtruffle.PrebuiltASTs}.
+ */
+public class SLPrebuiltASTTest {
+
+    private static final String SL_MIME_TYPE = "application/x-sl";
+
+    private static final String CODE = "" +
+                    "function fib(n) {\n" +
+                    "  if (n < 2) {\n" +
+                    "    return n;\n" +
+                    "  }\n" +
+                    "  return fib(n - 1) + fib(n - 2);\n" +
+                    "}\n" +
+                    "function main() {\n" +
+                    "  obj = new();\n" +
+                    "  obj.name = \"fib\";\n" +
+                    "  s = obj.name + \":\";\n" +
+                    "  i = 0;\n" +
+                    "  while (i < 10) {\n" +
+                    "    s = s + \" \" + fib(i);\n" +
+                    "    i = i + 1;\n" +
+                    "  }\n" +
+                    "  return s;\n" +
+                    "}\n";
+
+    private static final String EXPECTED = "fib: 0 1 1 2 3 5 8 13 21 34";
+
+    @Test
+    public void testWriteReloadAndRun() throws IOException {
+        Source source = Source.fromText(CODE, "prebuilt").withMimeType(SL_MIME_TYPE);
+        List<SLRootNode> parsed = Parser.parseFunctionsSL(new SLContext(), source);
+        assertEquals(2, parsed.size());
+
+        File file = File.createTempFile("sl-prebuilt", ".ast");
+        try {
+            try (OutputStream out = new BufferedOutputStream(new FileOutputStream(file))) {
+                NodeSerializer.write(source, parsed, out);
+            }
+            assertTrue(file.length() > 0);
+
+            List<RootNode> loaded;
+            try (InputStream in = new BufferedInputStream(new FileInputStream(file))) {
+                loaded = NodeDeserializer.read(source, in, SLLanguage.class.getClassLoader());
+            }
+            assertEquals(parsed.size(), loaded.size());
+
+            PolyglotEngine engine = PolyglotEngine.newBuilder().build();
+            try {
+                PolyglotEngine.Language sl = engine.getLanguages().get(SL_MIME_TYPE);
+                sl.eval(Source.fromText("", "empty"));
+                SLContext context = (SLContext) sl.getGlobalObject().get();
+                for (int i = 0; i < loaded.size(); i++) {
+                    SLRootNode function = (SLRootNode) loaded.get(i);
+                    assertNotSame(parsed.get(i), function);
+                    assertEquals(parsed.get(i).getName(), function.getName());
+                    context.getFunctionRegistry().register(function.getName(), function);
+                }
+                assertEquals(EXPECTED, engine.findGlobalSymbol("main").execute().get());
+            } finally {
+                engine.dispose();
+            }
+        } finally {
+            file.delete();
+        }
+    }
+
+    @Test
+    public void testParsedResult() throws IOException {
+        PolyglotEngine engine = PolyglotEngine.newBuilder().build();
+        try {
+            engine.eval(Source.fromText(CODE, "parsed").withMimeType(SL_MIME_TYPE));
+            assertEquals(EXPECTED, engine.findGlobalSymbol("main").execute().get());
+        } finally {
+            engine.dispose();
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+import java.lang.reflect.Field;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.instrument.Instrumenter;
+import com.oracle.truffle.api.instrument.Probe;
+import com.oracle.truffle.api.instrument.WrapperNode;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.source.SourceSection;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.sl.SLLanguage;
+import com.oracle.truffle.sl.nodes.SLExpressionNode;
+import com.oracle.truffle.sl.nodes.expression.SLLongLiteralNode;
+
+public class SLShareableTest {
+
+    @Test
+    public void probeAndReplaceSharedLiteral() throws Exception {
+        PolyglotEngine engine = PolyglotEngine.newBuilder().build();
+        engine.eval(Source.fromText("function main() {}", "init").withMimeType("application/x-sl"));
+        Field field = PolyglotEngine.class.getDeclaredField("instrumenter");
+        field.setAccessible(true);
+        Instrumenter instrumenter = (Instrumenter) field.get(engine);
+
+        SourceSection section = Source.fromText("42", "literal").createSection("literal", 0, 2);
+        SLExpressionNode literal = new SLLongLiteralNode(section, 42);
+        LiteralRootNode root = new LiteralRootNode(literal);
+        root.adoptChildren();
+        LiteralRootNode copy = (LiteralRootNode) root.deepCopy();
+        copy.adoptChildren();
+        assertSame(literal, copy.child);
+        assertSame(root, literal.getRootNode());
+
+        Probe probe = instrumenter.probe(literal);
+        assertTrue(literal.getParent() instanceof WrapperNode);
+        assertSame(root.child, literal.getParent());
+        assertSame(probe, instrumenter.probe(literal));
+
+        SLExpressionNode replacement = new SLLongLiteralNode(section, 43);
+        literal.replace(replacement);
+        assertSame(root.child, replacement.getParent());
+        assertSame(literal, copy.child);
+
+        assertEquals(43L, Truffle.getRuntime().createCallTarget(root).call());
+        assertEquals(42L, Truffle.getRuntime().createCallTarget(copy).call());
+    }
+
+    private static final class LiteralRootNode extends RootNode {
+
+        @Child SLExpressionNode child;
+
+        LiteralRootNode(SLExpressionNode child) {
+            super(SLLanguage.class, null, null);
+            this.child = child;
+        }
+
+        @Override
+        public Object execute(VirtualFrame frame) {
+            return child.executeGeneric(frame);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.ByteArrayOutputStream;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import com.oracle.truffle.api.object.DynamicObject;
+import com.oracle.truffle.api.object.Layout;
+import com.oracle.truffle.api.object.ObjectType;
+import com.oracle.truffle.api.object.Shape;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.object.debug.ShapeChurnProfiler;
+
+public class ShapeChurnProfilerTest {
+
+    private final ShapeChurnProfiler previous = ShapeChurnProfiler.getInstance();
+    private final ShapeChurnProfiler profiler = new ShapeChurnProfiler();
+    private final Shape emptyShape = Layout.createLayout().createShape(new ObjectType());
+
+    @Before
+    public void installProfiler() {
+        ShapeChurnProfiler.install(profiler);
+    }
+
+    @After
+    public void restoreProfiler() {
+        ShapeChurnProfiler.install(previous);
+    }
+
+    @Test
+    public void testAllocationsAreCountedPerShapeAndSite() {
+        final Object site = "allocation site";
+        final Object previousSite = profiler.enterSite(site);
+        try {
+            for (int i = 0; i < 3; i++) {
+                emptyShape.newInstance();
+            }
+        } finally {
+            profiler.exitSite(previousSite);
+        }
+        assertEquals(3, profiler.getAllocationCount(emptyShape));
+        final long[] counts = profiler.getSiteCounts(site);
+        assertNotNull(counts);
+        assertEquals("allocations", 3, counts[0]);
+        assertEquals("shape changes", 0, counts[1]);
+    }
+
+    @Test
+    public void testShapeChangesAreAttributedToTheirSite() {
+        final Object writeX = "write x";
+        final Object writeY = "write y";
+        for (int i = 0; i < 3; i++) {
+            final DynamicObject object = emptyShape.newInstance();
+            Object previousSite = profiler.enterSite(writeX);
+            object.define("x", 1);
+            profiler.exitSite(previousSite);
+            previousSite = profiler.enterSite(writeY);
+            object.define("y", 2);
+            profiler.exitSite(previousSite);
+        }
+        for (Object site : new Object[]{writeX, writeY}) {
+            final long[] counts = profiler.getSiteCounts(site);
+            assertNotNull(counts);
+            assertEquals("allocations", 0, counts[0]);
+            assertEquals("shape changes", 3, counts[1]);
+            assertEquals("distinct shapes", 1, counts[2]);
+            assertEquals("distinct transitions", 1, counts[3]);
+            // the basic layout never obsoletes shapes
+            assertEquals("updateShape", 0, counts[4]);
+            assertEquals("reshape", 0, counts[5]);
+            assertEquals("ensureValid", 0, counts[6]);
+        }
+    }
+
+    @Test
+    public void testSLPropertyWritesAreSeparateSites() throws Exception {
+        // @formatter:off
+        final String code =
+            "function main() {\n" +
+            "  i = 0;\n" +
+            "  while (i < 3) {\n" +
+            "    o = new();\n" +
+            "    o.x = 1;\n" +
+            "    o.y = 2;\n" +
+            "    i = i + 1;\n" +
+            "  }\n" +
+            "}\n";
+        // @formatter:on
+        final PolyglotEngine engine = PolyglotEngine.newBuilder().setOut(new ByteArrayOutputStream()).build();
+        engine.eval(Source.fromText(code, "churn.sl").withMimeType("application/x-sl"));
+        engine.findGlobalSymbol("main").execute();
+        engine.dispose();
+
+        final String json = profiler.toJSON().toString();
+        assertTrue(json, json.contains("churn.sl:4"));
+        assertTrue(json, json.contains("churn.sl:5"));
+        assertTrue(json, json.contains("churn.sl:6"));
+    }
+
+    @Test
+    public void testNotInstalled() {
+        ShapeChurnProfiler.install(null);
+        final Object site = "not installed";
+        final Object previousSite = profiler.enterSite(site);
+        emptyShape.newInstance().define("x", 1);
+        profiler.exitSite(previousSite);
+        assertEquals(0, profiler.getAllocationCount(emptyShape));
+        assertNull(profiler.getSiteCounts(site));
+    }
+}
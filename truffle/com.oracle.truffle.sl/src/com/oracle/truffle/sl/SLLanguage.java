@@ -41,8 +41,13 @@
 package com.oracle.truffle.sl;
 
 import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
 import java.io.IOException;
+import java.io.InputStream;
 import java.io.InputStreamReader;
+import java.io.OutputStream;
 import java.io.PrintWriter;
 import java.math.BigInteger;
 import java.nio.file.Path;
@@ -55,6 +60,7 @@ import com.oracle.truffle.api.RootCallTarget;
 import com.oracle.truffle.api.Truffle;
 import com.oracle.truffle.api.TruffleLanguage;
 import com.oracle.truffle.api.dsl.NodeFactory;
+import com.oracle.truffle.api.dsl.SpecializationSnapshot;
 import com.oracle.truffle.api.dsl.UnsupportedSpecializationException;
 import com.oracle.truffle.api.frame.MaterializedFrame;
 import com.oracle.truffle.api.frame.VirtualFrame;
@@ -114,6 +120,7 @@ import com.oracle.truffle.sl.runtime.SLContext;
 import com.oracle.truffle.sl.runtime.SLFunction;
 import com.oracle.truffle.sl.runtime.SLFunctionRegistry;
 import com.oracle.truffle.sl.runtime.SLNull;
+import com.oracle.truffle.sl.runtime.SLRope;
 import java.util.Map;
 import java.util.WeakHashMap;
 
@@ -136,7 +143,8 @@ import java.util.WeakHashMap;
  * numbers that exceed the range. Using a primitive type such as {@code long} is crucial for
  * performance.
  * <li>Boolean: implemented as the Java primitive type {@code boolean}.
- * <li>String: implemented as the Java standard type {@link String}.
+ * <li>String: implemented as the Java standard type {@link String}. Long strings built by
+ * concatenation are represented as a {@link SLRope} until their characters are needed.
  * <li>Function: implementation type {@link SLFunction}.
  * <li>Null (with only one value {@code null}): implemented as the singleton
  * {@link SLNull#SINGLETON}.
@@ -217,6 +225,13 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
         return context;
     }
 
+    /**
+     * Name of the system property that names a {@link SpecializationSnapshot} file. If the file
+     * exists, {@link #main(String[])} applies it to the parsed functions before running them, and
+     * it writes the specialization state of the run to the file at the end.
+     */
+    public static final String SPECIALIZATION_SNAPSHOT_PROPERTY = "sl.SpecializationSnapshot";
+
     /**
      * The main entry point. Use the mx command "mx sl" to run it with the correct class path setup.
      */
@@ -240,9 +255,20 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
         if (main == null) {
             throw new SLException("No function main() defined in SL source file.");
         }
+        String snapshotFile = System.getProperty(SPECIALIZATION_SNAPSHOT_PROPERTY);
+        if (snapshotFile != null && new File(snapshotFile).isFile()) {
+            try (InputStream in = new FileInputStream(snapshotFile)) {
+                SpecializationSnapshot.readFrom(in).apply(Truffle.getRuntime().getCallTargets());
+            }
+        }
         while (repeats-- > 0) {
             main.execute();
         }
+        if (snapshotFile != null) {
+            try (OutputStream out = new FileOutputStream(snapshotFile)) {
+                SpecializationSnapshot.capture().writeTo(out);
+            }
+        }
     }
 
     public static int parsingCount() {
@@ -387,7 +413,7 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
                     result.append("Number ").append(value);
                 } else if (value instanceof Boolean) {
                     result.append("Boolean ").append(value);
-                } else if (value instanceof String) {
+                } else if (value instanceof String || value instanceof SLRope) {
                     result.append("String \"").append(value).append("\"");
                 } else if (value instanceof SLFunction) {
                     result.append("Function ").append(value);
@@ -419,6 +445,51 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
         } catch (Exception e) {
             failed[0] = e;
         }
+        cached = createEvalTarget(c, failed[0], node);
+        compiled.put(code, cached);
+        return cached;
+    }
+
+    @Override
+    protected List<SLRootNode> prebuild(Source code) {
+        if (compiled.containsKey(code)) {
+            return null;
+        }
+        parsingCount++;
+        try {
+            return Parser.parseFunctionsSL(new SLContext(), code);
+        } catch (Exception e) {
+            /* Let parse report the error when the source is executed. */
+            return null;
+        }
+    }
+
+    @Override
+    protected CallTarget load(Source code, List<RootNode> roots) {
+        CallTarget cached = compiled.get(code);
+        if (cached != null) {
+            return cached;
+        }
+        for (RootNode root : roots) {
+            if (!(root instanceof SLRootNode)) {
+                throw new IllegalArgumentException("Not an SL function: " + root);
+            }
+        }
+        final SLContext c = new SLContext();
+        for (RootNode root : roots) {
+            SLRootNode function = (SLRootNode) root;
+            c.getFunctionRegistry().register(function.getName(), function);
+        }
+        cached = createEvalTarget(c, null, null);
+        compiled.put(code, cached);
+        return cached;
+    }
+
+    /**
+     * Creates the call target that registers the functions parsed into <code>c</code> in the
+     * current context when a source is evaluated.
+     */
+    private CallTarget createEvalTarget(final SLContext c, final Exception failed, final Node node) {
         RootNode rootNode = new RootNode(SLLanguage.class, null, null) {
             @Override
             public Object execute(VirtualFrame frame) {
@@ -430,11 +501,11 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
                  */
                 CompilerDirectives.transferToInterpreter();
 
-                if (failed[0] instanceof RuntimeException) {
-                    throw (RuntimeException) failed[0];
+                if (failed instanceof RuntimeException) {
+                    throw (RuntimeException) failed;
                 }
-                if (failed[0] != null) {
-                    throw new IllegalStateException(failed[0]);
+                if (failed != null) {
+                    throw new IllegalStateException(failed);
                 }
                 Node n = createFindContextNode();
                 SLContext fillIn = findContext(n);
@@ -448,7 +519,7 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
                     }
                     oneAndOnly = functionRegistry.lookup(f.getName());
                     oneAndCnt++;
-                    functionRegistry.register(f.getName(), (SLRootNode) f.getCallTarget().getRootNode());
+                    functionRegistry.register(f.getName(), callTarget);
                 }
                 Object[] arguments = frame.getArguments();
                 if (oneAndCnt == 1 && (arguments.length > 0 || node != null)) {
@@ -458,19 +529,12 @@ public final class SLLanguage extends TruffleLanguage<SLContext> {
                 return null;
             }
         };
-        cached = Truffle.getRuntime().createCallTarget(rootNode);
-        compiled.put(code, cached);
-        return cached;
+        return Truffle.getRuntime().createCallTarget(rootNode);
     }
 
     @Override
     protected Object findExportedSymbol(SLContext context, String globalName, boolean onlyExplicit) {
-        for (SLFunction f : context.getFunctionRegistry().getFunctions()) {
-            if (globalName.equals(f.getName())) {
-                return f;
-            }
-        }
-        return null;
+        return context.getFunctionRegistry().find(globalName);
     }
 
     @Override
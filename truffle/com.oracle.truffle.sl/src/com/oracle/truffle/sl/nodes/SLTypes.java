@@ -49,6 +49,7 @@ import com.oracle.truffle.api.dsl.internal.DSLOptions;
 import com.oracle.truffle.sl.SLLanguage;
 import com.oracle.truffle.sl.runtime.SLFunction;
 import com.oracle.truffle.sl.runtime.SLNull;
+import com.oracle.truffle.sl.runtime.SLRope;
 import java.math.BigInteger;
 
 /**
@@ -57,7 +58,7 @@ import java.math.BigInteger;
  * conversion methods for all types. In this class, we only cover types where the automatically
  * generated ones would not be sufficient.
  */
-@TypeSystem({long.class, BigInteger.class, boolean.class, String.class, SLFunction.class, SLNull.class})
+@TypeSystem({long.class, BigInteger.class, boolean.class, String.class, SLRope.class, SLFunction.class, SLNull.class})
 @DSLOptions
 public abstract class SLTypes {
 
@@ -95,4 +96,15 @@ public abstract class SLTypes {
     public static BigInteger castBigInteger(long value) {
         return BigInteger.valueOf(value);
     }
+
+    /**
+     * Informs the Truffle DSL that a {@link SLRope} can be used in all specializations where a
+     * {@link String} is expected. Ropes are only a representation of SL strings that makes
+     * repeated concatenation cheap, so they are flattened whenever the characters are needed.
+     */
+    @ImplicitCast
+    @TruffleBoundary
+    public static String castString(SLRope value) {
+        return value.toString();
+    }
 }
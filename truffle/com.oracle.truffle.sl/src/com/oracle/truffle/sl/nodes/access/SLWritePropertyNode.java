@@ -52,6 +52,7 @@ import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.NodeInfo;
 import com.oracle.truffle.api.object.DynamicObject;
 import com.oracle.truffle.api.source.SourceSection;
+import com.oracle.truffle.object.debug.ShapeChurnProfiler;
 import com.oracle.truffle.sl.nodes.SLExpressionNode;
 import com.oracle.truffle.sl.runtime.SLContext;
 
@@ -76,9 +77,23 @@ public abstract class SLWritePropertyNode extends SLExpressionNode {
         this.cacheNode = SLWritePropertyCacheNodeGen.create(propertyName);
     }
 
+    /**
+     * Shape churn caused by the write is attributed to this node if a {@link ShapeChurnProfiler} is
+     * installed; the check folds away in compiled code otherwise.
+     */
     @Specialization(guards = "isSLObject(object)")
     public Object doSLObject(DynamicObject object, Object value) {
-        cacheNode.executeObject(SLContext.castSLObject(object), value);
+        final ShapeChurnProfiler churnProfiler = ShapeChurnProfiler.getInstance();
+        if (churnProfiler == null) {
+            cacheNode.executeObject(SLContext.castSLObject(object), value);
+        } else {
+            final Object previousSite = churnProfiler.enterSite(this);
+            try {
+                cacheNode.executeObject(SLContext.castSLObject(object), value);
+            } finally {
+                churnProfiler.exitSite(previousSite);
+            }
+        }
         return value;
     }
 
@@ -90,6 +105,6 @@ public abstract class SLWritePropertyNode extends SLExpressionNode {
             CompilerDirectives.transferToInterpreterAndInvalidate();
             this.foreignWrite = insert(Message.WRITE.createNode());
         }
-        return ForeignAccess.execute(foreignWrite, frame, object, new Object[]{propertyName, value});
+        return ForeignAccess.execute(foreignWrite, frame, object, new Object[]{propertyName, SLContext.toForeignValue(value)});
     }
 }
@@ -40,6 +40,7 @@
  */
 package com.oracle.truffle.sl.nodes.call;
 
+import com.oracle.truffle.api.Assumption;
 import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.dsl.Cached;
 import com.oracle.truffle.api.dsl.Specialization;
@@ -81,12 +82,17 @@ public abstract class SLDispatchNode extends Node {
      * cachedFunction is a final field so that the compiler can optimize the check.
      * </p>
      * <p>
-     * {@code assumptions = "cachedFunction.getCallTargetStable()"} Support for function
-     * redefinition: When a function is redefined, the call target maintained by the SLFunction
-     * object is change. To avoid a check for that, we use an Assumption that is invalidated by the
-     * SLFunction when the change is performed. Since checking an assumption is a no-op in compiled
-     * code, the assumption check performed by the DSL does not add any overhead during optimized
-     * execution.
+     * {@code assumptions = "callTargetStable"} Support for function redefinition: When a function
+     * is redefined, the call target maintained by the SLFunction object is change. To avoid a check
+     * for that, we use an Assumption that is invalidated by the SLFunction when the change is
+     * performed. Since checking an assumption is a no-op in compiled code, the assumption check
+     * performed by the DSL does not add any overhead during optimized execution.
+     * </p>
+     * <p>
+     * The assumption is cached before the call target. Functions may be redefined by another
+     * thread, and {@link SLFunction} publishes a new call target before it invalidates the old
+     * assumption. Reading in the opposite order guarantees that a stale call target is never
+     * cached together with a valid assumption.
      * </p>
      *
      * @see Cached
@@ -94,12 +100,14 @@ public abstract class SLDispatchNode extends Node {
      *
      * @param function the dynamically provided function
      * @param cachedFunction the cached function of the specialization instance
+     * @param callTargetStable the assumption that the call target of cachedFunction did not change
      * @param callNode the {@link DirectCallNode} specifically created for the {@link CallTarget} in
      *            cachedFunction.
      */
-    @Specialization(limit = "INLINE_CACHE_SIZE", guards = "function == cachedFunction", assumptions = "cachedFunction.getCallTargetStable()")
+    @Specialization(limit = "INLINE_CACHE_SIZE", guards = "function == cachedFunction", assumptions = "callTargetStable")
     protected static Object doDirect(VirtualFrame frame, SLFunction function, Object[] arguments,   //
                     @Cached("function") SLFunction cachedFunction,   //
+                    @Cached("cachedFunction.getCallTargetStable()") Assumption callTargetStable,   //
                     @Cached("create(cachedFunction.getCallTarget())") DirectCallNode callNode) {
         /* Inline cache hit, we are safe to execute the cached call target. */
         return callNode.call(frame, arguments);
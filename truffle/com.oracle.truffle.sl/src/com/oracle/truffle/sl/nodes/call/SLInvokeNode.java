@@ -40,17 +40,28 @@
  */
 package com.oracle.truffle.sl.nodes.call;
 
+import java.util.List;
+
+import com.oracle.truffle.api.Assumption;
 import com.oracle.truffle.api.CompilerAsserts;
+import com.oracle.truffle.api.CompilerDirectives;
+import com.oracle.truffle.api.RootCallTarget;
+import com.oracle.truffle.api.dsl.Cached;
 import com.oracle.truffle.api.dsl.NodeChild;
 import com.oracle.truffle.api.dsl.NodeChildren;
 import com.oracle.truffle.api.dsl.Specialization;
+import com.oracle.truffle.api.frame.Frame;
+import com.oracle.truffle.api.frame.FrameSlot;
+import com.oracle.truffle.api.frame.FrameSlotKind;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.interop.ForeignAccess;
 import com.oracle.truffle.api.interop.Message;
 import com.oracle.truffle.api.interop.TruffleObject;
+import com.oracle.truffle.api.nodes.DirectCallNode;
 import com.oracle.truffle.api.nodes.ExplodeLoop;
 import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.NodeInfo;
+import com.oracle.truffle.api.nodes.UnexpectedResultException;
 import com.oracle.truffle.api.source.SourceSection;
 import com.oracle.truffle.sl.nodes.SLExpressionNode;
 import com.oracle.truffle.sl.runtime.SLContext;
@@ -61,7 +72,8 @@ import com.oracle.truffle.sl.runtime.SLFunction;
  * {@link SLFunction target function} can be computed by an arbitrary expression. This node is
  * responsible for evaluating this expression, as well as evaluating the {@link #argumentNodes
  * arguments}. The actual dispatch is then delegated to a chain of {@link SLDispatchNode} that form
- * a polymorphic inline cache.
+ * a polymorphic inline cache. The first function called by this node whose parameters match the
+ * arguments is called {@link #doTyped directly} with the arguments stored in the callee frame.
  */
 @NodeInfo(shortName = "invoke")
 @NodeChildren({@NodeChild(value = "functionNode", type = SLExpressionNode.class)})
@@ -75,9 +87,90 @@ public abstract class SLInvokeNode extends SLExpressionNode {
         this.dispatchNode = SLDispatchNodeGen.create();
     }
 
-    @Specialization
+    /**
+     * Monomorphic call of a function that declares its parameters in its frame descriptor. The
+     * arguments are evaluated straight into the parameter slots of the callee frame, so an argument
+     * whose parameter is specialized to <code>long</code> or <code>boolean</code> is neither boxed
+     * nor stored in an <code>Object[]</code>. The assumption is cached before the call target for
+     * the same reason as in {@link SLDispatchNode#doDirect}.
+     */
+    @Specialization(limit = "1", guards = {"function == cachedFunction", "parameterSlots != null"}, assumptions = "callTargetStable")
+    protected Object doTyped(VirtualFrame frame, SLFunction function,   //
+                    @Cached("function") SLFunction cachedFunction,   //
+                    @Cached("cachedFunction.getCallTargetStable()") Assumption callTargetStable,   //
+                    @Cached("getParameterSlots(cachedFunction)") FrameSlot[] parameterSlots,   //
+                    @Cached("create(cachedFunction.getCallTarget())") DirectCallNode callNode) {
+        final Frame argumentFrame = callNode.createArgumentFrame(argumentNodes.length);
+        if (argumentFrame == null) {
+            /* The runtime does not support typed calls. */
+            return callNode.call(frame, evaluateArguments(frame));
+        }
+        writeArguments(frame, argumentFrame, parameterSlots);
+        return callNode.call(frame, argumentFrame);
+    }
+
+    /**
+     * Returns the parameter slots of the function, or <code>null</code> if the function is
+     * undefined or does not declare one parameter slot per argument of this call.
+     */
+    protected FrameSlot[] getParameterSlots(SLFunction function) {
+        final RootCallTarget callTarget = function.getCallTarget();
+        if (callTarget == null) {
+            return null;
+        }
+        final List<? extends FrameSlot> parameters = callTarget.getRootNode().getFrameDescriptor().getParameterSlots();
+        if (parameters.size() != argumentNodes.length) {
+            return null;
+        }
+        return parameters.toArray(new FrameSlot[parameters.size()]);
+    }
+
     @ExplodeLoop
-    public Object executeGeneric(VirtualFrame frame, SLFunction function) {
+    private void writeArguments(VirtualFrame frame, Frame argumentFrame, FrameSlot[] parameterSlots) {
+        CompilerAsserts.compilationConstant(argumentNodes.length);
+
+        for (int i = 0; i < argumentNodes.length; i++) {
+            writeArgument(frame, argumentFrame, parameterSlots[i], argumentNodes[i]);
+        }
+    }
+
+    private static void writeArgument(VirtualFrame frame, Frame argumentFrame, FrameSlot slot, SLExpressionNode argumentNode) {
+        final Object value;
+        try {
+            if (slot.getKind() == FrameSlotKind.Long) {
+                argumentFrame.setLong(slot, argumentNode.executeLong(frame));
+                return;
+            } else if (slot.getKind() == FrameSlotKind.Boolean) {
+                argumentFrame.setBoolean(slot, argumentNode.executeBoolean(frame));
+                return;
+            }
+            value = argumentNode.executeGeneric(frame);
+        } catch (UnexpectedResultException ex) {
+            /* The parameter changed its type, so it is stored as an object from now on. */
+            CompilerDirectives.transferToInterpreterAndInvalidate();
+            slot.setKind(FrameSlotKind.Object);
+            argumentFrame.setObject(slot, ex.getResult());
+            return;
+        }
+        if (slot.getKind() == FrameSlotKind.Illegal) {
+            /* First argument for this parameter: specialize the parameter to the argument type. */
+            CompilerDirectives.transferToInterpreterAndInvalidate();
+            if (value instanceof Long) {
+                slot.setKind(FrameSlotKind.Long);
+                argumentFrame.setLong(slot, (long) value);
+                return;
+            } else if (value instanceof Boolean) {
+                slot.setKind(FrameSlotKind.Boolean);
+                argumentFrame.setBoolean(slot, (boolean) value);
+                return;
+            }
+            slot.setKind(FrameSlotKind.Object);
+        }
+        argumentFrame.setObject(slot, value);
+    }
+
+    @ExplodeLoop
+    private Object[] evaluateArguments(VirtualFrame frame) {
         /*
          * The number of arguments is constant for one invoke node. During compilation, the loop is
          * unrolled and the execute methods of all arguments are inlined. This is triggered by the
@@ -90,7 +183,12 @@ public abstract class SLInvokeNode extends SLExpressionNode {
         for (int i = 0; i < argumentNodes.length; i++) {
             argumentValues[i] = argumentNodes[i].executeGeneric(frame);
         }
-        return dispatchNode.executeDispatch(frame, function, argumentValues);
+        return argumentValues;
+    }
+
+    @Specialization
+    public Object executeGeneric(VirtualFrame frame, SLFunction function) {
+        return dispatchNode.executeDispatch(frame, function, evaluateArguments(frame));
     }
 
     @Child private Node crossLanguageCall;
@@ -108,7 +206,7 @@ public abstract class SLInvokeNode extends SLExpressionNode {
 
         Object[] argumentValues = new Object[argumentNodes.length];
         for (int i = 0; i < argumentNodes.length; i++) {
-            argumentValues[i] = argumentNodes[i].executeGeneric(frame);
+            argumentValues[i] = SLContext.toForeignValue(argumentNodes[i].executeGeneric(frame));
         }
         if (crossLanguageCall == null) {
             crossLanguageCall = insert(Message.createExecute(argumentValues.length).createNode());
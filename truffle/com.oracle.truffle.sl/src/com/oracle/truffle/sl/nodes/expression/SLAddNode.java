@@ -48,6 +48,7 @@ import com.oracle.truffle.api.nodes.NodeInfo;
 import com.oracle.truffle.api.source.SourceSection;
 import com.oracle.truffle.sl.nodes.SLBinaryNode;
 import com.oracle.truffle.sl.nodes.SLTypes;
+import com.oracle.truffle.sl.runtime.SLRope;
 import java.math.BigInteger;
 
 /**
@@ -105,25 +106,41 @@ public abstract class SLAddNode extends SLBinaryNode {
         return left.add(right);
     }
 
+    /**
+     * Specialization for appending to a string that was itself built by concatenation, which is
+     * the common case of a string built in a loop. The left operand is not flattened, so each step
+     * of the loop takes constant time instead of copying the whole string.
+     */
+    @Specialization
+    @TruffleBoundary
+    protected Object add(SLRope left, Object right) {
+        return SLRope.concat(left, stringOrRope(right));
+    }
+
     /**
      * Specialization for String concatenation. The SL specification says that String concatenation
      * works if either the left or the right operand is a String. The non-string operand is
-     * converted then automatically converted to a String.
+     * converted then automatically converted to a String. Long results are represented as a
+     * {@link SLRope} that is only flattened when its characters are needed.
      * <p>
      * To implement these semantics, we tell the Truffle DSL to use a custom guard. The guard
      * function is defined in {@link #isString this class}, but could also be in any superclass.
      */
     @Specialization(guards = "isString(left, right)")
     @TruffleBoundary
-    protected String add(Object left, Object right) {
-        return left.toString() + right.toString();
+    protected Object add(Object left, Object right) {
+        return SLRope.concat(stringOrRope(left), stringOrRope(right));
     }
 
     /**
      * Guard for String concatenation: returns true if either the left or the right operand is a
-     * {@link String}.
+     * {@link String} or a {@link SLRope}.
      */
     protected boolean isString(Object a, Object b) {
-        return a instanceof String || b instanceof String;
+        return a instanceof String || a instanceof SLRope || b instanceof String || b instanceof SLRope;
+    }
+
+    private static Object stringOrRope(Object value) {
+        return value instanceof SLRope ? value : value.toString();
     }
 }
@@ -42,6 +42,7 @@ package com.oracle.truffle.sl.nodes.expression;
 
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.NodeInfo;
+import com.oracle.truffle.api.nodes.Shareable;
 import com.oracle.truffle.api.source.SourceSection;
 import com.oracle.truffle.sl.nodes.SLExpressionNode;
 import java.math.BigInteger;
@@ -51,6 +52,7 @@ import java.math.BigInteger;
  * {@link SLLongLiteralNode}.
  */
 @NodeInfo(shortName = "const")
+@Shareable
 public final class SLBigIntegerLiteralNode extends SLExpressionNode {
 
     private final BigInteger value;
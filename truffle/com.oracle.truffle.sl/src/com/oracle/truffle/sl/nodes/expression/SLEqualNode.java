@@ -49,6 +49,7 @@ import com.oracle.truffle.api.source.SourceSection;
 import com.oracle.truffle.sl.nodes.SLBinaryNode;
 import com.oracle.truffle.sl.runtime.SLFunction;
 import com.oracle.truffle.sl.runtime.SLNull;
+import com.oracle.truffle.sl.runtime.SLRope;
 import java.math.BigInteger;
 
 /**
@@ -87,6 +88,17 @@ public abstract class SLEqualNode extends SLBinaryNode {
         return left == right;
     }
 
+    /**
+     * Strings built by concatenation are only flattened if their lengths match. Because the type
+     * system converts a {@link SLRope} implicitly to a {@link String}, comparisons of a rope with a
+     * {@link String} are handled by {@link #equal(String, String)}.
+     */
+    @Specialization
+    @TruffleBoundary
+    protected boolean equal(SLRope left, SLRope right) {
+        return left.length() == right.length() && left.toString().equals(right.toString());
+    }
+
     @Specialization
     protected boolean equal(String left, String right) {
         return left.equals(right);
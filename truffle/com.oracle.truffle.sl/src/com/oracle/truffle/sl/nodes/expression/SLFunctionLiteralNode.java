@@ -43,6 +43,7 @@ package com.oracle.truffle.sl.nodes.expression;
 import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.CompilerDirectives;
 import com.oracle.truffle.api.CompilerDirectives.CompilationFinal;
+import com.oracle.truffle.api.CompilerDirectives.TruffleBoundary;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.nodes.NodeInfo;
@@ -63,8 +64,8 @@ import com.oracle.truffle.sl.runtime.SLFunctionRegistry;
 public final class SLFunctionLiteralNode extends SLExpressionNode {
     private final String value;
     private final Node contextNode;
-    @CompilationFinal private SLFunction cachedFunction;
-    @CompilationFinal private SLContext cachedContext;
+    @CompilationFinal private CachedFunction cached;
+    @CompilationFinal private boolean multipleContexts;
 
     public SLFunctionLiteralNode(SourceSection src, String value) {
         super(src);
@@ -75,11 +76,40 @@ public final class SLFunctionLiteralNode extends SLExpressionNode {
     @Override
     public SLFunction executeGeneric(VirtualFrame frame) {
         SLContext context = SLLanguage.INSTANCE.findContext0(contextNode);
-        if (context != cachedContext) {
-            CompilerDirectives.transferToInterpreterAndInvalidate();
-            this.cachedContext = context;
-            this.cachedFunction = context.getFunctionRegistry().lookup(value);
+        CachedFunction c = cached;
+        if (c != null && c.context == context) {
+            return c.function;
+        }
+        if (multipleContexts) {
+            return lookupFunction(context);
+        }
+        CompilerDirectives.transferToInterpreterAndInvalidate();
+        if (c == null) {
+            /*
+             * Context and function are published together, so that threads with different
+             * contexts never see a function of another context.
+             */
+            c = new CachedFunction(context, lookupFunction(context));
+            cached = c;
+            return c.function;
+        }
+        /* Used with several contexts, e.g. one per thread: stop caching. */
+        multipleContexts = true;
+        return lookupFunction(context);
+    }
+
+    @TruffleBoundary
+    private SLFunction lookupFunction(SLContext context) {
+        return context.getFunctionRegistry().lookup(value);
+    }
+
+    private static final class CachedFunction {
+        final SLContext context;
+        final SLFunction function;
+
+        CachedFunction(SLContext context, SLFunction function) {
+            this.context = context;
+            this.function = function;
         }
-        return cachedFunction;
     }
 }
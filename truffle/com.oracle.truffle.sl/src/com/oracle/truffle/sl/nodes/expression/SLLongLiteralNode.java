@@ -42,6 +42,7 @@ package com.oracle.truffle.sl.nodes.expression;
 
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.NodeInfo;
+import com.oracle.truffle.api.nodes.Shareable;
 import com.oracle.truffle.api.nodes.UnexpectedResultException;
 import com.oracle.truffle.api.source.SourceSection;
 import com.oracle.truffle.sl.nodes.SLExpressionNode;
@@ -52,6 +53,7 @@ import com.oracle.truffle.sl.nodes.SLExpressionNode;
  * the primitive value is automatically boxed by Java.
  */
 @NodeInfo(shortName = "const")
+@Shareable
 public final class SLLongLiteralNode extends SLExpressionNode {
 
     private final long value;
@@ -42,6 +42,7 @@ package com.oracle.truffle.sl.nodes.expression;
 
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.nodes.NodeInfo;
+import com.oracle.truffle.api.nodes.Shareable;
 import com.oracle.truffle.api.source.SourceSection;
 import com.oracle.truffle.sl.nodes.SLExpressionNode;
 
@@ -49,6 +50,7 @@ import com.oracle.truffle.sl.nodes.SLExpressionNode;
  * Constant literal for a String value.
  */
 @NodeInfo(shortName = "const")
+@Shareable
 public final class SLStringLiteralNode extends SLExpressionNode {
 
     private final String value;
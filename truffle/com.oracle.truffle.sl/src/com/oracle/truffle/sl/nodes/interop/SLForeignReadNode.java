@@ -50,6 +50,7 @@ import com.oracle.truffle.api.object.Property;
 import com.oracle.truffle.sl.SLLanguage;
 import com.oracle.truffle.sl.nodes.access.SLReadPropertyCacheNode;
 import com.oracle.truffle.sl.nodes.access.SLReadPropertyCacheNodeGen;
+import com.oracle.truffle.sl.runtime.SLContext;
 
 public class SLForeignReadNode extends RootNode {
 
@@ -66,7 +67,7 @@ public class SLForeignReadNode extends RootNode {
             String name = (String) ForeignAccess.getArguments(frame).get(0);
             read = insert(new SLMonomorphicNameReadNode(name));
         }
-        return read.execute(frame);
+        return SLContext.toForeignValue(read.execute(frame));
     }
 
     private abstract static class SLReadNode extends Node {
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.nodes.local;
+
+import com.oracle.truffle.api.CompilerAsserts;
+import com.oracle.truffle.api.frame.FrameSlot;
+import com.oracle.truffle.api.frame.FrameSlotTypeException;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.nodes.DirectCallNode;
+import com.oracle.truffle.api.nodes.ExplodeLoop;
+import com.oracle.truffle.api.profiles.ConditionProfile;
+import com.oracle.truffle.sl.nodes.SLStatementNode;
+import com.oracle.truffle.sl.parser.SLNodeFactory;
+
+/**
+ * The {@link SLNodeFactory#addFormalParameter method prologue} that assigns the arguments of a
+ * call to the parameters of the function.
+ * <p>
+ * A caller that uses {@link DirectCallNode#createArgumentFrame typed argument passing} has already
+ * stored the arguments in the parameter slots, so the prologue is skipped for it. Other calls leave
+ * the parameter slots at the default value of the frame descriptor, which a typed caller only
+ * writes for an argument that is itself the default value; copying the arguments again is harmless
+ * then.
+ */
+public final class SLAssignParametersNode extends SLStatementNode {
+
+    private final FrameSlot firstParameter;
+    @Children private final SLStatementNode[] assignments;
+    private final ConditionProfile typedCall = ConditionProfile.createBinaryProfile();
+
+    public SLAssignParametersNode(FrameSlot firstParameter, SLStatementNode[] assignments) {
+        super(null);
+        this.firstParameter = firstParameter;
+        this.assignments = assignments;
+    }
+
+    @Override
+    @ExplodeLoop
+    public void executeVoid(VirtualFrame frame) {
+        if (typedCall.profile(isAssigned(frame))) {
+            return;
+        }
+        CompilerAsserts.compilationConstant(assignments.length);
+        for (SLStatementNode assignment : assignments) {
+            assignment.executeVoid(frame);
+        }
+    }
+
+    private boolean isAssigned(VirtualFrame frame) {
+        if (!frame.isObject(firstParameter)) {
+            return true;
+        }
+        try {
+            return frame.getObject(firstParameter) != frame.getFrameDescriptor().getDefaultValue();
+        } catch (FrameSlotTypeException ex) {
+            return true;
+        }
+    }
+}
@@ -46,6 +46,7 @@ package com.oracle.truffle.sl.parser;
 import com.oracle.truffle.api.source.Source;
 import com.oracle.truffle.sl.SLException;
 import com.oracle.truffle.sl.nodes.SLExpressionNode;
+import com.oracle.truffle.sl.nodes.SLRootNode;
 import com.oracle.truffle.sl.nodes.SLStatementNode;
 import com.oracle.truffle.sl.runtime.SLContext;
 import java.util.ArrayList;
@@ -459,9 +460,26 @@ public class Parser {
     public static void parseSL(SLContext context, Source source) {
         Parser parser = new Parser(context, source);
         parser.Parse();
-        if (parser.errors.errors.size() > 0) {
+        parser.checkErrors();
+    }
+
+    /**
+     * Parses the functions of a source into their root nodes without registering them in the
+     * context, e.g. to serialize their ASTs.
+     */
+    public static List<SLRootNode> parseFunctionsSL(SLContext context, Source source) {
+        Parser parser = new Parser(context, source);
+        List<SLRootNode> functions = new ArrayList<>();
+        parser.factory.collectFunctions(functions);
+        parser.Parse();
+        parser.checkErrors();
+        return functions;
+    }
+
+    private void checkErrors() {
+        if (errors.errors.size() > 0) {
             StringBuilder msg = new StringBuilder("Error(s) parsing script:\n");
-            for (String error : parser.errors.errors) {
+            for (String error : errors.errors) {
                 msg.append(error).append("\n");
             }
             throw new SLException(msg.toString());
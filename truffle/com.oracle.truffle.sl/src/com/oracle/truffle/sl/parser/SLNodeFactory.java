@@ -83,12 +83,14 @@ import com.oracle.truffle.sl.nodes.expression.SLMulNodeGen;
 import com.oracle.truffle.sl.nodes.expression.SLParenExpressionNode;
 import com.oracle.truffle.sl.nodes.expression.SLStringLiteralNode;
 import com.oracle.truffle.sl.nodes.expression.SLSubNodeGen;
+import com.oracle.truffle.sl.nodes.local.SLAssignParametersNode;
 import com.oracle.truffle.sl.nodes.local.SLReadArgumentNode;
 import com.oracle.truffle.sl.nodes.local.SLReadLocalVariableNode;
 import com.oracle.truffle.sl.nodes.local.SLReadLocalVariableNodeGen;
 import com.oracle.truffle.sl.nodes.local.SLWriteLocalVariableNode;
 import com.oracle.truffle.sl.nodes.local.SLWriteLocalVariableNodeGen;
 import com.oracle.truffle.sl.runtime.SLContext;
+import com.oracle.truffle.sl.runtime.SLNull;
 
 /**
  * Helper class used by the SL {@link Parser} to create nodes. The code is factored out of the
@@ -117,6 +119,7 @@ public class SLNodeFactory {
     /* State while parsing a source unit. */
     private final SLContext context;
     private final Source source;
+    private List<SLRootNode> collectedFunctions;
 
     /* State while parsing a function. */
     private int functionStartPos;
@@ -125,6 +128,7 @@ public class SLNodeFactory {
     private int parameterCount;
     private FrameDescriptor frameDescriptor;
     private List<SLStatementNode> methodNodes;
+    private List<SLStatementNode> parameterNodes;
 
     /* State while parsing a block. */
     private LexicalScope lexicalScope;
@@ -134,6 +138,14 @@ public class SLNodeFactory {
         this.source = source;
     }
 
+    /**
+     * Collects the root nodes of parsed functions in the given list instead of registering them in
+     * the context.
+     */
+    public void collectFunctions(List<SLRootNode> functions) {
+        this.collectedFunctions = functions;
+    }
+
     public void startFunction(Token nameToken, int bodyStartPos) {
         assert functionStartPos == 0;
         assert functionName == null;
@@ -145,8 +157,9 @@ public class SLNodeFactory {
         functionStartPos = nameToken.charPos;
         functionName = nameToken.val;
         functionBodyStartPos = bodyStartPos;
-        frameDescriptor = new FrameDescriptor();
+        frameDescriptor = new FrameDescriptor(SLNull.SINGLETON);
         methodNodes = new ArrayList<>();
+        parameterNodes = new ArrayList<>();
         startBlock();
     }
 
@@ -154,15 +167,28 @@ public class SLNodeFactory {
         /*
          * Method parameters are assigned to local variables at the beginning of the method. This
          * ensures that accesses to parameters are specialized the same way as local variables are
-         * specialized.
+         * specialized. The locals are declared as parameter slots of the frame descriptor, so
+         * callers that know the parameter kinds can store primitive arguments there without boxing
+         * them and skip the assignments.
          */
+        FrameSlot frameSlot = frameDescriptor.findOrAddFrameSlot(nameToken.val);
+        if (frameDescriptor.getParameterSlots().contains(frameSlot)) {
+            /* A repeated parameter name shadows the earlier parameter of that name. */
+            frameSlot = frameDescriptor.addFrameSlot(nameToken.val + "#" + parameterCount);
+        }
+        frameDescriptor.addParameterSlot(frameSlot);
+        lexicalScope.locals.put(nameToken.val, frameSlot);
         final SourceSection src = srcFromToken(nameToken);
         final SLReadArgumentNode readArg = new SLReadArgumentNode(src, parameterCount);
-        methodNodes.add(createAssignment(nameToken, readArg));
+        parameterNodes.add(SLWriteLocalVariableNodeGen.create(src, readArg, frameSlot));
         parameterCount++;
     }
 
     public void finishFunction(SLStatementNode bodyNode) {
+        if (!parameterNodes.isEmpty()) {
+            final FrameSlot firstParameter = frameDescriptor.getParameterSlots().get(0);
+            methodNodes.add(0, new SLAssignParametersNode(firstParameter, parameterNodes.toArray(new SLStatementNode[parameterNodes.size()])));
+        }
         methodNodes.add(bodyNode);
         final int bodyEndPos = bodyNode.getSourceSection().getCharEndIndex();
         final SourceSection functionSrc = source.createSection(functionName, functionStartPos, bodyEndPos - functionStartPos);
@@ -172,13 +198,18 @@ public class SLNodeFactory {
         final SLFunctionBodyNode functionBodyNode = new SLFunctionBodyNode(functionSrc, methodBlock);
         final SLRootNode rootNode = new SLRootNode(this.context, frameDescriptor, functionBodyNode, functionSrc, functionName);
 
-        context.getFunctionRegistry().register(functionName, rootNode);
+        if (collectedFunctions != null) {
+            collectedFunctions.add(rootNode);
+        } else {
+            context.getFunctionRegistry().register(functionName, rootNode);
+        }
 
         functionStartPos = 0;
         functionName = null;
         functionBodyStartPos = 0;
         parameterCount = 0;
         frameDescriptor = null;
+        parameterNodes = null;
         lexicalScope = null;
     }
 
@@ -244,6 +244,17 @@ public final class SLContext extends ExecutionContext {
         throw new IllegalStateException(a + " is not a Truffle value");
     }
 
+    /**
+     * Converts an SL value that is passed to another language. Strings built by concatenation are
+     * {@linkplain SLRope flattened}, because other languages only know {@link String}.
+     */
+    public static Object toForeignValue(Object a) {
+        if (a instanceof SLRope) {
+            return a.toString();
+        }
+        return a;
+    }
+
     public CallTarget parse(Source source) throws IOException {
         return env.parse(source);
     }
@@ -61,6 +61,12 @@ import com.oracle.truffle.api.utilities.CyclicAssumption;
  * The {@link #callTarget} can be {@code null}. To ensure that only one {@link SLFunction} instance
  * per name exists, the {@link SLFunctionRegistry} creates an instance also when performing name
  * lookup. A function that has been looked up, i.e., used, but not defined, has no call target.
+ * <p>
+ * Functions can be redefined by one thread while other threads call them. The {@link #callTarget}
+ * is therefore volatile and {@link #setCallTarget} first publishes the new call target and only
+ * then invalidates the {@link #getCallTargetStable() assumption}. A reader that fetches the
+ * assumption before the call target is guaranteed to either see the new call target or an already
+ * invalidated assumption, but never a stale call target guarded by a valid assumption.
  */
 public final class SLFunction implements TruffleObject {
 
@@ -68,7 +74,7 @@ public final class SLFunction implements TruffleObject {
     private final String name;
 
     /** The current implementation of this function. */
-    private RootCallTarget callTarget;
+    private volatile RootCallTarget callTarget;
 
     /**
      * Manages the assumption that the {@link #callTarget} is stable. We use the utility class
@@ -86,7 +92,7 @@ public final class SLFunction implements TruffleObject {
         return name;
     }
 
-    protected void setCallTarget(RootCallTarget callTarget) {
+    protected synchronized void setCallTarget(RootCallTarget callTarget) {
         this.callTarget = callTarget;
         /*
          * We have a new call target. Invalidate all code that speculated that the old call target
@@ -41,6 +41,7 @@
 package com.oracle.truffle.sl.runtime;
 
 import static com.oracle.truffle.sl.runtime.SLContext.fromForeignValue;
+import static com.oracle.truffle.sl.runtime.SLContext.toForeignValue;
 
 import java.util.List;
 
@@ -102,7 +103,7 @@ final class SLFunctionForeignAccess implements ForeignAccess.Factory {
                 arr[i] = fromForeignValue(arr[i]);
             }
             Object result = dispatch.executeDispatch(frame, function, arr);
-            return result;
+            return toForeignValue(result);
         }
     }
 
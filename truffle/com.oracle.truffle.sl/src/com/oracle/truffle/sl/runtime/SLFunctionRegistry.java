@@ -46,16 +46,18 @@ import com.oracle.truffle.sl.nodes.SLRootNode;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.Comparator;
-import java.util.HashMap;
 import java.util.List;
-import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
 
 /**
- * Manages the mapping from function names to {@link SLFunction function objects}.
+ * Manages the mapping from function names to {@link SLFunction function objects}. The registry may
+ * be accessed from multiple threads: lookups never block and at most one {@link SLFunction} is
+ * ever created per name, even when several threads look up the same name concurrently.
  */
 public final class SLFunctionRegistry {
 
-    private final Map<String, SLFunction> functions = new HashMap<>();
+    private final ConcurrentMap<String, SLFunction> functions = new ConcurrentHashMap<>();
 
     /**
      * Returns the canonical {@link SLFunction} object for the given name. If it does not exist yet,
@@ -64,25 +66,45 @@ public final class SLFunctionRegistry {
     public SLFunction lookup(String name) {
         SLFunction result = functions.get(name);
         if (result == null) {
-            result = new SLFunction(name);
-            functions.put(name, result);
+            SLFunction newFunction = new SLFunction(name);
+            result = functions.putIfAbsent(name, newFunction);
+            if (result == null) {
+                result = newFunction;
+            }
         }
         return result;
     }
 
+    /**
+     * Returns the {@link SLFunction} object for the given name, or {@code null} if the function has
+     * neither been defined nor looked up yet. Unlike {@link #lookup(String)} this method never
+     * creates a new function.
+     */
+    public SLFunction find(String name) {
+        return functions.get(name);
+    }
+
     /**
      * Associates the {@link SLFunction} with the given name with the given implementation root
      * node. If the function did not exist before, it defines the function. If the function existed
      * before, it redefines the function and the old implementation is discarded.
      */
     public void register(String name, SLRootNode rootNode) {
+        register(name, Truffle.getRuntime().createCallTarget(rootNode));
+    }
+
+    /**
+     * Associates the {@link SLFunction} with the given name with an existing call target. Used to
+     * share already parsed functions between contexts.
+     */
+    public void register(String name, RootCallTarget callTarget) {
         SLFunction function = lookup(name);
-        RootCallTarget callTarget = Truffle.getRuntime().createCallTarget(rootNode);
         function.setCallTarget(callTarget);
     }
 
     /**
-     * Returns the sorted list of all functions, for printing purposes only.
+     * Returns the sorted list of all functions, for printing purposes only. The list is a snapshot
+     * and does not reflect functions that are registered concurrently.
      */
     public List<SLFunction> getFunctions() {
         List<SLFunction> result = new ArrayList<>(functions.values());
@@ -41,6 +41,7 @@
 package com.oracle.truffle.sl.runtime;
 
 import static com.oracle.truffle.sl.runtime.SLContext.fromForeignValue;
+import static com.oracle.truffle.sl.runtime.SLContext.toForeignValue;
 
 import java.util.List;
 
@@ -156,7 +157,7 @@ final class SLObjectType extends ObjectType implements ForeignAccess.Factory10,
                     arr[i - 1] = fromForeignValue(args.get(i));
                 }
                 Object result = dispatch.executeDispatch(frame, function, arr);
-                return result;
+                return toForeignValue(result);
             } else {
                 throw new IllegalArgumentException();
             }
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * The Universal Permissive License (UPL), Version 1.0
+ *
+ * Subject to the condition set forth below, permission is hereby granted to any
+ * person obtaining a copy of this software, associated documentation and/or
+ * data (collectively the "Software"), free of charge and under any and all
+ * copyright rights in the Software, and any and all patent rights owned or
+ * freely licensable by each licensor hereunder covering either (i) the
+ * unmodified Software as contributed to or provided by such licensor, or (ii)
+ * the Larger Works (as defined below), to deal in both
+ *
+ * (a) the Software, and
+ *
+ * (b) any piece of software and/or hardware listed in the lrgrwrks.txt file if
+ * one is included with the Software each a "Larger Work" to which the Software
+ * is contributed by such licensors),
+ *
+ * without restriction, including without limitation the rights to copy, create
+ * derivative works of, display, perform, and distribute the Software and make,
+ * use, sell, offer for sale, import, export, have made, and have sold the
+ * Software and the Larger Work(s), and to sublicense the foregoing rights on
+ * either these or other terms.
+ *
+ * This license is subject to the following condition:
+ *
+ * The above copyright notice and either this complete permission notice or at a
+ * minimum a reference to the UPL must be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+package com.oracle.truffle.sl.runtime;
+
+import java.util.ArrayDeque;
+
+import com.oracle.truffle.api.CompilerDirectives.TruffleBoundary;
+
+/**
+ * The SL type for a string built by concatenation. Concatenating long strings in a loop would copy
+ * the whole string on every step, so {@link #concat} only records the two operands and the string
+ * is {@linkplain #toString() flattened} when its characters are needed, e.g., when it is printed,
+ * compared, or passed to another language. Short results are still concatenated eagerly, because
+ * a rope is not worth it for them.
+ * <p>
+ * SL programs never see this class: the type system converts a rope to a {@link String} wherever
+ * a {@link String} is expected, and the interop boundary {@linkplain SLContext#toForeignValue
+ * flattens} ropes.
+ */
+public final class SLRope {
+
+    /**
+     * Concatenations whose result is not longer than this are flattened eagerly.
+     */
+    static final int FLAT_LENGTH = 64;
+
+    /**
+     * The operands, each a {@link String} or a {@link SLRope}. They are released once the rope is
+     * flattened, so that a string built and printed in a loop does not keep every intermediate
+     * string alive. A reader that sees a released operand also sees {@link #flattened}.
+     */
+    private volatile Object left;
+    private volatile Object right;
+    private final int length;
+    private volatile String flattened;
+
+    private SLRope(Object left, Object right, int length) {
+        this.left = left;
+        this.right = right;
+        this.length = length;
+    }
+
+    /**
+     * Concatenates two strings or ropes. Returns a {@link String} if the result is short, and a
+     * rope otherwise.
+     */
+    @TruffleBoundary
+    public static Object concat(Object left, Object right) {
+        assert isStringOrRope(left) && isStringOrRope(right);
+        final long length = (long) length(left) + length(right);
+        if (length > Integer.MAX_VALUE) {
+            throw new OutOfMemoryError("string too long");
+        }
+        if (length <= FLAT_LENGTH) {
+            return left.toString().concat(right.toString());
+        }
+        return new SLRope(unwrapFlattened(left), unwrapFlattened(right), (int) length);
+    }
+
+    /**
+     * Returns the flat string of an already flattened rope, so that a new rope does not refer to
+     * the old one.
+     */
+    private static Object unwrapFlattened(Object value) {
+        if (value instanceof SLRope) {
+            final String result = ((SLRope) value).flattened;
+            if (result != null) {
+                return result;
+            }
+        }
+        return value;
+    }
+
+    private static boolean isStringOrRope(Object value) {
+        return value instanceof String || value instanceof SLRope;
+    }
+
+    private static int length(Object value) {
+        return value instanceof SLRope ? ((SLRope) value).length : ((String) value).length();
+    }
+
+    /**
+     * The number of characters of the string, known without flattening.
+     */
+    public int length() {
+        return length;
+    }
+
+    /**
+     * Returns the characters of this rope as a flat {@link String}. The result is cached and the
+     * operands are released, so each rope is flattened at most once. The tree of a string built in
+     * a loop is as deep as the loop ran, so it is traversed with an explicit stack instead of
+     * recursion.
+     */
+    @Override
+    @TruffleBoundary
+    public String toString() {
+        String result = flattened;
+        if (result == null) {
+            result = flatten();
+            flattened = result;
+            left = null;
+            right = null;
+        }
+        return result;
+    }
+
+    private String flatten() {
+        final char[] chars = new char[length];
+        final ArrayDeque<Object> pending = new ArrayDeque<>();
+        int position = 0;
+        pending.push(this);
+        while (!pending.isEmpty()) {
+            final Object part = pending.pop();
+            final Object partLeft = part instanceof SLRope ? ((SLRope) part).left : null;
+            final Object partRight = part instanceof SLRope ? ((SLRope) part).right : null;
+            if (partLeft != null && partRight != null && ((SLRope) part).flattened == null) {
+                pending.push(partRight);
+                pending.push(partLeft);
+            } else {
+                final String string = part.toString();
+                string.getChars(0, string.length(), chars, position);
+                position += string.length();
+            }
+        }
+        assert position == length;
+        return new String(chars);
+    }
+}
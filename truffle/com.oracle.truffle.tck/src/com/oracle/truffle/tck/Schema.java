@@ -27,6 +27,11 @@ package com.oracle.truffle.tck;
 import java.nio.ByteBuffer;
 import java.util.List;
 
+/**
+ * Layout of {@link StructuredData}. The layout is compiled once: every field gets its index, its
+ * {@link Type type}, the offset of its first value and the distance between two consecutive
+ * values, so reading a value is a single absolute {@link ByteBuffer} access.
+ */
 final class Schema {
 
     enum Type {
@@ -41,80 +46,78 @@ final class Schema {
     }
 
     private final int size;
-    private final boolean rowBased;
-    private final List<String> names;
-    private final List<Type> types;
+    private final String[] names;
+    private final Type[] types;
+    private final int[] offsets;
+    private final int[] strides;
+    private final int byteSize;
 
     Schema(int size, boolean rowBased, List<String> names, List<Type> types) {
+        assert names.size() == types.size();
         this.size = size;
-        this.rowBased = rowBased;
-        this.names = names;
-        this.types = types;
+        this.names = names.toArray(new String[names.size()]);
+        this.types = types.toArray(new Type[types.size()]);
+        this.offsets = new int[this.names.length];
+        this.strides = new int[this.names.length];
+
+        int rowSize = 0;
+        for (Type t : this.types) {
+            rowSize += t.size;
+        }
+        int offset = 0;
+        for (int i = 0; i < this.names.length; i++) {
+            offsets[i] = offset;
+            if (rowBased) {
+                strides[i] = rowSize;
+                offset += this.types[i].size;
+            } else {
+                strides[i] = this.types[i].size;
+                offset += this.types[i].size * size;
+            }
+        }
+        this.byteSize = rowSize * size;
     }
 
     public int length() {
         return size;
     }
 
-    public Object get(byte[] buffer, int index, String name) {
-        assert names.contains(name);
-        int offset = rowBased ? getRowOffset(name, index) : getColumnOffset(name, index);
-        if (types.get(names.indexOf(name)) == Type.DOUBLE) {
-            byte[] b = new byte[Type.DOUBLE.size];
-            for (int i = 0; i < Type.DOUBLE.size; i++) {
-                b[i] = buffer[offset + i];
-            }
-            return ByteBuffer.wrap(b).getDouble();
-        } else if (types.get(names.indexOf(name)) == Type.INT) {
-            byte[] b = new byte[Type.INT.size];
-            for (int i = 0; i < Type.INT.size; i++) {
-                b[i] = buffer[offset + i];
-            }
-            return ByteBuffer.wrap(b).getInt();
-        }
-        throw new IllegalStateException();
+    /**
+     * Number of bytes a buffer needs to hold all values described by this schema.
+     */
+    public int byteSize() {
+        return byteSize;
     }
 
-    private int getRowSize() {
-        assert rowBased;
-        int rowSize = 0;
-        for (Type t : types) {
-            rowSize += t.size;
+    /**
+     * Index of the field called <code>name</code>, or <code>-1</code> if there is no such field.
+     */
+    public int fieldIndex(String name) {
+        for (int i = 0; i < names.length; i++) {
+            if (names[i].equals(name)) {
+                return i;
+            }
         }
-        return rowSize;
+        return -1;
     }
 
-    private int getRowOffset(String name, int index) {
-        assert rowBased;
-        if (names.contains(name)) {
-            int offset = 0;
-            for (int i = 0; i < names.size(); i++) {
-                if (names.get(i).equals(name)) {
-                    return index * getRowSize() + offset;
-                } else {
-                    offset += types.get(i).size;
-                }
-            }
-        } else {
-            throw new IllegalArgumentException();
+    public Object get(ByteBuffer buffer, int index, String name) {
+        int field = fieldIndex(name);
+        if (field < 0) {
+            throw new IllegalArgumentException(name);
         }
-        throw new IllegalStateException();
+        return get(buffer, index, field);
     }
 
-    private int getColumnOffset(String name, int index) {
-        assert !rowBased;
-        if (names.contains(name)) {
-            int offset = 0;
-            for (int i = 0; i < names.size(); i++) {
-                if (names.get(i).equals(name)) {
-                    return offset + index * types.get(i).size;
-                } else {
-                    offset += types.get(i).size * size;
-                }
-            }
-        } else {
-            throw new IllegalArgumentException();
+    public Object get(ByteBuffer buffer, int index, int field) {
+        int offset = offsets[field] + index * strides[field];
+        switch (types[field]) {
+            case DOUBLE:
+                return buffer.getDouble(offset);
+            case INT:
+                return buffer.getInt(offset);
+            default:
+                throw new IllegalStateException();
         }
-        throw new IllegalStateException();
     }
 }
@@ -24,6 +24,12 @@
  */
 package com.oracle.truffle.tck;
 
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.StandardOpenOption;
+
 import com.oracle.truffle.tck.impl.TckLanguage;
 import com.oracle.truffle.api.CallTarget;
 import com.oracle.truffle.api.Truffle;
@@ -34,18 +40,49 @@ import com.oracle.truffle.api.interop.Message;
 import com.oracle.truffle.api.interop.TruffleObject;
 import com.oracle.truffle.api.nodes.RootNode;
 
+/**
+ * Read-only array of records laid out according to a {@link Schema} in a {@link ByteBuffer}. The
+ * buffer can live on the heap, be {@link ByteBuffer#allocateDirect(int) direct} or be
+ * {@link #map(File, Schema) mapped} from a file; values are read from it in place.
+ */
 final class StructuredData implements TruffleObject {
 
-    private final byte[] buffer;
+    private static final ForeignAccess ACCESS = ForeignAccess.create(new StructuredDataForeignAccessFactory());
+
+    private final ByteBuffer buffer;
     private final Schema schema;
 
     StructuredData(byte[] buffer, Schema schema) {
+        this(ByteBuffer.wrap(buffer), schema);
+    }
+
+    StructuredData(ByteBuffer buffer, Schema schema) {
+        if (buffer.capacity() < schema.byteSize()) {
+            throw new IllegalArgumentException("Buffer of " + buffer.capacity() + " bytes is too small for " + schema.byteSize() + " bytes of data");
+        }
         this.buffer = buffer;
         this.schema = schema;
     }
 
+    /**
+     * Exposes the content of a file without copying it.
+     */
+    static StructuredData map(File file, Schema schema) throws IOException {
+        try (FileChannel channel = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+            return new StructuredData(channel.map(FileChannel.MapMode.READ_ONLY, 0, schema.byteSize()), schema);
+        }
+    }
+
+    ByteBuffer getBuffer() {
+        return buffer;
+    }
+
+    Schema getSchema() {
+        return schema;
+    }
+
     public ForeignAccess getForeignAccess() {
-        return ForeignAccess.create(new StructuredDataForeignAccessFactory());
+        return ACCESS;
     }
 
     private static class StructuredDataForeignAccessFactory implements Factory {
@@ -84,7 +121,7 @@ final class StructuredData implements TruffleObject {
             StructuredData data = (StructuredData) ForeignAccess.getReceiver(frame);
             Number index = TckLanguage.expectNumber(ForeignAccess.getArguments(frame).get(0));
             int idx = TckLanguage.checkBounds(index.intValue(), data.schema.length());
-            return new StructuredDataEntry(data.buffer, data.schema, idx);
+            return new StructuredDataEntry(data, idx);
         }
 
     }
@@ -26,6 +26,8 @@ package com.oracle.truffle.tck;
 
 import com.oracle.truffle.tck.impl.TckLanguage;
 import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.CompilerDirectives;
+import com.oracle.truffle.api.CompilerDirectives.CompilationFinal;
 import com.oracle.truffle.api.Truffle;
 import com.oracle.truffle.api.frame.VirtualFrame;
 import com.oracle.truffle.api.interop.ForeignAccess;
@@ -36,18 +38,18 @@ import com.oracle.truffle.api.nodes.RootNode;
 
 final class StructuredDataEntry implements TruffleObject {
 
-    private final byte[] buffer;
-    private final Schema schema;
+    private static final ForeignAccess ACCESS = ForeignAccess.create(new StructuredDataEntryForeignAccessFactory());
+
+    private final StructuredData data;
     private final int index;
 
-    StructuredDataEntry(byte[] buffer, Schema schema, int index) {
-        this.buffer = buffer;
-        this.schema = schema;
+    StructuredDataEntry(StructuredData data, int index) {
+        this.data = data;
         this.index = index;
     }
 
     public ForeignAccess getForeignAccess() {
-        return ForeignAccess.create(new StructuredDataEntryForeignAccessFactory());
+        return ACCESS;
     }
 
     private static class StructuredDataEntryForeignAccessFactory implements Factory {
@@ -74,17 +76,50 @@ final class StructuredDataEntry implements TruffleObject {
         }
     }
 
+    /**
+     * Remembers the schema and field name of the first read, so reads of the same field resolve to
+     * a constant field index. Other reads look the field up. The cache is published as a single
+     * immutable object, so a concurrent read sees either no cache or a complete one.
+     */
     private static class StructuredDataEntryReadNode extends RootNode {
+        @CompilationFinal private FieldCache cache;
+
         protected StructuredDataEntryReadNode() {
             super(TckLanguage.class, null, null);
         }
 
         @Override
         public Object execute(VirtualFrame frame) {
-            StructuredDataEntry data = (StructuredDataEntry) ForeignAccess.getReceiver(frame);
+            StructuredDataEntry entry = (StructuredDataEntry) ForeignAccess.getReceiver(frame);
             String name = TckLanguage.expectString(ForeignAccess.getArguments(frame).get(0));
-            return data.schema.get(data.buffer, data.index, name);
+            Schema schema = entry.data.getSchema();
+            FieldCache c = cache;
+            if (c == null) {
+                CompilerDirectives.transferToInterpreterAndInvalidate();
+                int field = schema.fieldIndex(name);
+                if (field < 0) {
+                    throw new IllegalArgumentException(name);
+                }
+                c = new FieldCache(schema, name, field);
+                cache = c;
+            }
+            if (schema == c.schema && c.name.equals(name)) {
+                return schema.get(entry.data.getBuffer(), entry.index, c.field);
+            }
+            return schema.get(entry.data.getBuffer(), entry.index, name);
         }
 
     }
+
+    private static final class FieldCache {
+        final Schema schema;
+        final String name;
+        final int field;
+
+        FieldCache(Schema schema, String name, int field) {
+            this.schema = schema;
+            this.name = name;
+            this.field = field;
+        }
+    }
 }
@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.tck;
+
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Map;
+import java.util.Properties;
+import java.util.TreeMap;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.TruffleLanguage;
+import com.oracle.truffle.api.interop.Message;
+import com.oracle.truffle.api.interop.TruffleObject;
+import com.oracle.truffle.api.interop.java.JavaInterop;
+import com.oracle.truffle.api.interop.java.MethodMessage;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.tck.Schema.Type;
+import com.oracle.truffle.tck.impl.LongBinaryOperation;
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Interop performance companion of the {@link TruffleTCK}. While the <em>TCK</em> verifies that
+ * your {@link TruffleLanguage language implementation} handles foreign objects correctly, this
+ * suite measures how fast it does so. Subclass it, implement the <b>protected</b> methods the same
+ * way as in your {@link TruffleTCK} implementation and include it in your test suite:
+ *
+ * <pre>
+ * <b>public class</b> MyLanguageInteropBenchmark <b>extends</b> {@link TruffleInteropBenchmark} {
+ *   {@link Override @Override}
+ *   <b>protected</b> {@link PolyglotEngine} {@link #prepareVM() prepareVM}() {
+ *     <em>// create the engine</em>
+ *     <em>// execute necessary scripts</em>
+ *   }
+ * 
+ *   {@link Override @Override}
+ *   <b>protected</b> {@link String} identity() {
+ *     <b>return</b> <em>// name of the identity function</em>
+ *   }
+ * 
+ *   <em>// and so on...</em>
+ * }
+ * </pre>
+ *
+ * Each benchmark exercises one interop path: {@link Message#READ} and {@link Message#WRITE} on
+ * foreign objects and arrays, {@link Message#createExecute(int) execution} of host Java functions
+ * created by {@link JavaInterop}, {@link Message#createInvoke(int) invocation} of members of guest
+ * language objects and round-trips of values through {@link PolyglotEngine.Value}. Problem sizes
+ * and iteration counts are fixed, so the numbers of different languages and of different versions
+ * of one language can be compared. Benchmarks whose symbol is not provided (the method returns
+ * <code>null</code>) are skipped.
+ * <p>
+ * Every benchmark still checks the result it computes, but it is not meant to replace the
+ * {@link TruffleTCK}. The throughput, in operations per second, is printed to
+ * {@link System#out}. When the system property <code>truffle.tck.benchmark.results</code> names a
+ * file, all results measured so far are written there in {@link Properties} format. Such a file
+ * can later be passed as <code>truffle.tck.benchmark.baseline</code>; each result is then reported
+ * relative to the baseline and a benchmark fails if it is slower than the baseline by more than
+ * the {@link #regressionTolerance() tolerance}.
+ */
+public abstract class TruffleInteropBenchmark {
+    /** Number of elements in the foreign arrays passed to the array benchmarks. */
+    public static final int ARRAY_SIZE = 1000;
+    /** Number of operations executed before the measurement starts. */
+    public static final int WARMUP_ITERATIONS = 1000;
+    /** Number of measured operations. */
+    public static final int ITERATIONS = 10000;
+
+    private static final String RESULTS_PROPERTY = "truffle.tck.benchmark.results";
+    private static final String BASELINE_PROPERTY = "truffle.tck.benchmark.baseline";
+
+    private static final Map<String, Double> RESULTS = new TreeMap<>();
+    private static Properties baseline;
+
+    private PolyglotEngine benchmarkVM;
+
+    protected TruffleInteropBenchmark() {
+    }
+
+    /**
+     * Prepares a {@link PolyglotEngine} with your language, see {@link TruffleTCK#prepareVM()}.
+     *
+     * @return initialized Truffle virtual machine
+     * @throws java.lang.Exception thrown when the VM preparation fails
+     */
+    protected abstract PolyglotEngine prepareVM() throws Exception;
+
+    /**
+     * MIME type associated with your language.
+     *
+     * @return mime type of the tested language
+     */
+    protected abstract String mimeType();
+
+    /**
+     * Name of identity function, see {@link TruffleTCK#identity()}.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmark
+     */
+    protected String identity() {
+        return null;
+    }
+
+    /**
+     * Name of a function that applies a foreign function to <code>18</code> and <code>32</code>
+     * and adds <code>10</code> to the result, see {@link TruffleTCK#applyNumbers()}.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmark
+     */
+    protected String applyNumbers() {
+        return null;
+    }
+
+    /**
+     * Name of a function that adds up two complex numbers, see {@link TruffleTCK#complexAdd()}.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmark
+     */
+    protected String complexAdd() {
+        return null;
+    }
+
+    /**
+     * Name of a function that sums the real parts of an array of complex numbers, see
+     * {@link TruffleTCK#complexSumReal()}.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmarks
+     */
+    protected String complexSumReal() {
+        return null;
+    }
+
+    /**
+     * Name of a function that copies an array of complex numbers, see
+     * {@link TruffleTCK#complexCopy()}.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmark
+     */
+    protected String complexCopy() {
+        return null;
+    }
+
+    /**
+     * Name of a function that returns a compound object, see {@link TruffleTCK#compoundObject()}.
+     * Only its <b>plus</b> member is used.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmark
+     */
+    protected String compoundObject() {
+        return null;
+    }
+
+    /**
+     * Name of a function that returns an object with primitive slots, see
+     * {@link TruffleTCK#valuesObject()}. Only its <b>intValue</b> slot is used.
+     *
+     * @return name of globally exported symbol, <code>null</code> to skip the benchmark
+     */
+    protected String valuesObject() {
+        return null;
+    }
+
+    /**
+     * Relative slowdown against the baseline that is still accepted. The default is
+     * <code>0.5</code>, i.e. a benchmark fails if it reaches less than half of its baseline
+     * throughput. Return a negative value to only report the difference.
+     *
+     * @return accepted slowdown as a fraction of the baseline throughput
+     */
+    protected double regressionTolerance() {
+        return 0.5;
+    }
+
+    /**
+     * Reports the throughput of a single benchmark. The default implementation prints it together
+     * with the baseline comparison to {@link System#out}.
+     *
+     * @param name name of the benchmark
+     * @param opsPerSecond measured throughput
+     * @param baselineOpsPerSecond throughput of the baseline, or <code>0</code> if there is none
+     */
+    protected void report(String name, double opsPerSecond, double baselineOpsPerSecond) {
+        if (baselineOpsPerSecond > 0) {
+            System.out.printf("%s %s: %.0f ops/s (%.2fx baseline)%n", mimeType(), name, opsPerSecond, opsPerSecond / baselineOpsPerSecond);
+        } else {
+            System.out.printf("%s %s: %.0f ops/s%n", mimeType(), name, opsPerSecond);
+        }
+    }
+
+    private PolyglotEngine vm() throws Exception {
+        if (benchmarkVM == null) {
+            benchmarkVM = prepareVM();
+        }
+        return benchmarkVM;
+    }
+
+    //
+    // The benchmarks
+    //
+
+    @Test
+    public void benchmarkValueRoundTrip() throws Exception {
+        String id = identity();
+        if (id == null) {
+            return;
+        }
+        final PolyglotEngine.Value function = findGlobalSymbol(id);
+        measure("valueRoundTrip", 1, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                Number n = function.execute(iteration).as(Number.class);
+                assertEquals("Identity", iteration, n.intValue());
+            }
+        });
+    }
+
+    @Test
+    public void benchmarkHostCall() throws Exception {
+        String id = applyNumbers();
+        if (id == null) {
+            return;
+        }
+        final PolyglotEngine.Value apply = findGlobalSymbol(id);
+        final TruffleObject fn = JavaInterop.asTruffleFunction(LongBinaryOperation.class, new MaxMinObject(true));
+        measure("hostCall", 1, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                Number n = apply.execute(fn).as(Number.class);
+                assertEquals("32 > 18 and plus 10", 42, n.intValue());
+            }
+        });
+    }
+
+    @Test
+    public void benchmarkObjectReadWrite() throws Exception {
+        String id = complexAdd();
+        if (id == null) {
+            return;
+        }
+        final PolyglotEngine.Value add = findGlobalSymbol(id);
+        final ComplexNumber a = new ComplexNumber(0, 0);
+        final ComplexNumber b = new ComplexNumber(1, 2);
+        measure("objectReadWrite", 1, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                add.execute(a, b);
+            }
+        });
+        assertEquals("Real part", WARMUP_ITERATIONS + ITERATIONS, a.get(ComplexNumber.REAL_IDENTIFIER), 0.1);
+        assertEquals("Imaginary part", 2 * (WARMUP_ITERATIONS + ITERATIONS), a.get(ComplexNumber.IMAGINARY_IDENTIFIER), 0.1);
+    }
+
+    @Test
+    public void benchmarkArrayReadRowBased() throws Exception {
+        String id = complexSumReal();
+        if (id == null) {
+            return;
+        }
+        double[] data = new double[2 * ARRAY_SIZE];
+        for (int i = 0; i < ARRAY_SIZE; i++) {
+            data[2 * i] = 1;
+            data[2 * i + 1] = -1;
+        }
+        measureSumReal("arrayReadRowBased", findGlobalSymbol(id), new ComplexNumbersRowBased(data));
+    }
+
+    @Test
+    public void benchmarkArrayReadColumnBased() throws Exception {
+        String id = complexSumReal();
+        if (id == null) {
+            return;
+        }
+        double[] reals = new double[ARRAY_SIZE];
+        double[] imags = new double[ARRAY_SIZE];
+        Arrays.fill(reals, 1);
+        Arrays.fill(imags, -1);
+        measureSumReal("arrayReadColumnBased", findGlobalSymbol(id), new ComplexNumbersColumnBased(reals, imags));
+    }
+
+    @Test
+    public void benchmarkArrayReadStructuredData() throws Exception {
+        String id = complexSumReal();
+        if (id == null) {
+            return;
+        }
+        Schema schema = new Schema(ARRAY_SIZE, true, Arrays.asList(ComplexNumber.REAL_IDENTIFIER, ComplexNumber.IMAGINARY_IDENTIFIER), Arrays.asList(Type.DOUBLE, Type.DOUBLE));
+        ByteBuffer buffer = ByteBuffer.allocate(2 * ARRAY_SIZE * Double.SIZE / Byte.SIZE);
+        for (int i = 0; i < ARRAY_SIZE; i++) {
+            buffer.putDouble(1);
+            buffer.putDouble(-1);
+        }
+        measureSumReal("arrayReadStructuredData", findGlobalSymbol(id), new StructuredData(buffer.array(), schema));
+    }
+
+    @Test
+    public void benchmarkArrayWrite() throws Exception {
+        String id = complexCopy();
+        if (id == null) {
+            return;
+        }
+        final PolyglotEngine.Value copy = findGlobalSymbol(id);
+        double[] source = new double[2 * ARRAY_SIZE];
+        for (int i = 0; i < source.length; i++) {
+            source[i] = i;
+        }
+        final ComplexNumbersRowBased a = new ComplexNumbersRowBased(new double[2 * ARRAY_SIZE]);
+        final ComplexNumbersRowBased b = new ComplexNumbersRowBased(source);
+        measure("arrayWrite", ARRAY_SIZE, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                copy.execute(a, b);
+            }
+        });
+        assertArrayEquals(source, a.getData(), 0.1);
+    }
+
+    @Test
+    public void benchmarkInvoke() throws Exception {
+        String id = compoundObject();
+        if (id == null) {
+            return;
+        }
+        final CompoundObject obj = findGlobalSymbol(id).execute().as(CompoundObject.class);
+        assertNotNull("Compound object found", obj);
+        measure("invoke", 1, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                assertEquals("Sum", iteration + 1, obj.plus(iteration, 1).intValue());
+            }
+        });
+    }
+
+    @Test
+    public void benchmarkSlotReadWrite() throws Exception {
+        String id = valuesObject();
+        if (id == null) {
+            return;
+        }
+        final ValuesObject values = findGlobalSymbol(id).execute().as(ValuesObject.class);
+        assertNotNull("Values object found", values);
+        measure("slotReadWrite", 2, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                values.intValue(iteration);
+                assertEquals("Written value", iteration, values.intValue());
+            }
+        });
+    }
+
+    private void measureSumReal(String name, final PolyglotEngine.Value sum, final TruffleObject numbers) throws Exception {
+        measure(name, ARRAY_SIZE, new Operation() {
+            @Override
+            public void run(int iteration) throws Exception {
+                Number n = sum.execute(numbers).as(Number.class);
+                assertEquals("Sum of real parts", ARRAY_SIZE, n.doubleValue(), 0.1);
+            }
+        });
+    }
+
+    /**
+     * Runs an operation {@link #WARMUP_ITERATIONS} times, then measures {@link #ITERATIONS}
+     * further runs and reports the throughput.
+     *
+     * @param opsPerRun number of interop operations one run of the operation performs
+     */
+    private void measure(String name, int opsPerRun, Operation operation) throws Exception {
+        for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+            operation.run(i);
+        }
+        long start = System.nanoTime();
+        for (int i = 0; i < ITERATIONS; i++) {
+            operation.run(WARMUP_ITERATIONS + i);
+        }
+        long nanos = Math.max(1, System.nanoTime() - start);
+        double opsPerSecond = (double) ITERATIONS * opsPerRun * 1e9 / nanos;
+
+        String key = mimeType() + "." + name;
+        double baselineOpsPerSecond = baseline(key);
+        report(name, opsPerSecond, baselineOpsPerSecond);
+        recordResult(key, opsPerSecond);
+        if (baselineOpsPerSecond > 0 && regressionTolerance() >= 0) {
+            double minimum = baselineOpsPerSecond * (1 - regressionTolerance());
+            assertTrue(String.format("%s regressed: %.0f ops/s, baseline %.0f ops/s", key, opsPerSecond, baselineOpsPerSecond), opsPerSecond >= minimum);
+        }
+    }
+
+    private static synchronized double baseline(String key) throws IOException {
+        if (baseline == null) {
+            baseline = new Properties();
+            String path = System.getProperty(BASELINE_PROPERTY);
+            if (path != null) {
+                try (InputStream in = new FileInputStream(path)) {
+                    baseline.load(in);
+                }
+            }
+        }
+        String value = baseline.getProperty(key);
+        return value == null ? 0 : Double.parseDouble(value);
+    }
+
+    private static synchronized void recordResult(String key, double opsPerSecond) throws IOException {
+        RESULTS.put(key, opsPerSecond);
+        String path = System.getProperty(RESULTS_PROPERTY);
+        if (path == null) {
+            return;
+        }
+        Properties results = new Properties();
+        for (Map.Entry<String, Double> entry : RESULTS.entrySet()) {
+            results.setProperty(entry.getKey(), Long.toString(Math.round(entry.getValue())));
+        }
+        try (OutputStream out = new FileOutputStream(path)) {
+            results.store(out, "Truffle interop benchmark results in ops/s");
+        }
+    }
+
+    private PolyglotEngine.Value findGlobalSymbol(String name) throws Exception {
+        PolyglotEngine.Value s = vm().findGlobalSymbol(name);
+        assert s != null : "Symbol " + name + " is not found!";
+        return s;
+    }
+
+    private interface Operation {
+        void run(int iteration) throws Exception;
+    }
+
+    interface CompoundObject {
+        Number plus(int x, int y);
+    }
+
+    interface ValuesObject {
+        int intValue();
+
+        @MethodMessage(message = "WRITE")
+        void intValue(int v);
+    }
+}
@@ -1136,6 +1136,25 @@ public abstract class TruffleTCK {
         assertDouble("The same value returned", 42.0, n.doubleValue());
     }
 
+    @Test
+    public void testSumRealOfComplexNumbersAsStructuredDataDirectBuffer() throws Exception {
+        String id = complexSumReal();
+        if (id == null) {
+            return;
+        }
+        PolyglotEngine.Value apply = findGlobalSymbol(id);
+
+        Schema schema = new Schema(3, true, Arrays.asList(ComplexNumber.REAL_IDENTIFIER, ComplexNumber.IMAGINARY_IDENTIFIER), Arrays.asList(Type.DOUBLE, Type.DOUBLE));
+        ByteBuffer buffer = ByteBuffer.allocateDirect(schema.byteSize());
+        for (double d : new double[]{2, -1, 30, -1, 10, -1}) {
+            buffer.putDouble(d);
+        }
+        StructuredData numbers = new StructuredData(buffer, schema);
+
+        Number n = (Number) apply.execute(numbers).get();
+        assertDouble("The same value returned", 42.0, n.doubleValue());
+    }
+
     @Test
     public void testCopyComplexNumbersA() throws Exception {
         String id = complexCopy();
@@ -27,7 +27,10 @@ package com.oracle.truffle.tools.test;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertTrue;
 
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
 import java.io.IOException;
+import java.io.StringWriter;
 import java.lang.reflect.Field;
 import java.util.Arrays;
 import java.util.Map;
@@ -37,6 +40,7 @@ import org.junit.Test;
 import com.oracle.truffle.api.instrument.Instrumenter;
 import com.oracle.truffle.api.source.Source;
 import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.tools.CoverageSnapshot;
 import com.oracle.truffle.tools.CoverageTracker;
 import com.oracle.truffle.tools.test.ToolTestUtil.ToolTestTag;
 
@@ -115,4 +119,50 @@ public class CoverageTrackerTest {
 
         addCoverage.dispose();
     }
+
+    @Test
+    public void testSnapshots() throws NoSuchFieldException, SecurityException, IllegalArgumentException, IllegalAccessException, IOException {
+        final PolyglotEngine vm = PolyglotEngine.newBuilder().build();
+        final Field field = PolyglotEngine.class.getDeclaredField("instrumenter");
+        field.setAccessible(true);
+        final Instrumenter instrumenter = (Instrumenter) field.get(vm);
+        instrumenter.registerASTProber(new ToolTestUtil.TestASTProber());
+        final Source source = ToolTestUtil.createTestSource("testSnapshots");
+        final String name = CoverageSnapshot.getSourceName(source);
+        final long n = CoverageSnapshot.NOT_COUNTED;
+
+        final CoverageTracker coverage = new CoverageTracker(ToolTestTag.VALUE_TAG);
+        instrumenter.install(coverage);
+        assertTrue(coverage.snapshot().getSourceNames().isEmpty());
+
+        assertEquals(vm.eval(source).get(), 13);
+        assertEquals(vm.eval(source).get(), 13);
+        final ByteArrayOutputStream stream = new ByteArrayOutputStream();
+        final CoverageSnapshot delta1 = coverage.snapshotDelta();
+        delta1.writeTo(stream);
+        assertTrue(Arrays.equals(new long[]{2, n, 2, n}, delta1.getCounts(name)));
+
+        assertEquals(vm.eval(source).get(), 13);
+        final CoverageSnapshot delta2 = coverage.snapshotDelta();
+        delta2.writeTo(stream);
+        assertTrue(Arrays.equals(new long[]{1, n, 1, n}, delta2.getCounts(name)));
+        assertTrue(Arrays.equals(new long[]{3, n, 3, n}, coverage.snapshot().getCounts(name)));
+
+        // Delta snapshots written one after the other merge to the total counts
+        final CoverageSnapshot merged = CoverageSnapshot.readAll(new ByteArrayInputStream(stream.toByteArray()));
+        assertEquals(coverage.snapshot().getSourceNames(), merged.getSourceNames());
+        assertTrue(Arrays.equals(new long[]{3, n, 3, n}, merged.getCounts(name)));
+        assertTrue(Arrays.equals(new long[]{6, n, 6, n}, merged.merge(merged).getCounts(name)));
+
+        final StringWriter lcov = new StringWriter();
+        merged.writeLcov(lcov);
+        assertEquals("SF:" + name + "\nDA:1,3\nDA:3,3\nLF:2\nLH:2\nend_of_record\n", lcov.toString());
+
+        coverage.reset();
+        assertTrue(Arrays.equals(new long[]{0, n, 0, n}, coverage.snapshot().getCounts(name)));
+        assertEquals(vm.eval(source).get(), 13);
+        assertTrue(Arrays.equals(new long[]{1, n, 1, n}, coverage.snapshotDelta().getCounts(name)));
+
+        coverage.dispose();
+    }
 }
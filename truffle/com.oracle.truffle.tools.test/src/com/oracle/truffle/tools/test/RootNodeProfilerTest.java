@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.tools.test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.lang.reflect.Field;
+
+import org.junit.Test;
+
+import com.oracle.truffle.api.instrument.Instrumenter;
+import com.oracle.truffle.api.source.Source;
+import com.oracle.truffle.api.vm.PolyglotEngine;
+import com.oracle.truffle.tools.RootNodeProfiler;
+import com.oracle.truffle.tools.RootNodeProfiler.RootNodeProfile;
+import com.oracle.truffle.tools.test.ToolTestUtil.ToolTestTag;
+
+public class RootNodeProfilerTest {
+
+    @Test
+    public void testNoExecution() throws NoSuchFieldException, SecurityException, IllegalArgumentException, IllegalAccessException {
+        final PolyglotEngine vm = PolyglotEngine.newBuilder().build();
+        final Field field = PolyglotEngine.class.getDeclaredField("instrumenter");
+        field.setAccessible(true);
+        final Instrumenter instrumenter = (Instrumenter) field.get(vm);
+        instrumenter.registerASTProber(new ToolTestUtil.TestASTProber());
+        final RootNodeProfiler tool = new RootNodeProfiler();
+        assertEquals(0, tool.getProfiles().length);
+        instrumenter.install(tool);
+        assertEquals(0, tool.getProfiles().length);
+        assertEquals("[]", tool.toJSON());
+        tool.reset();
+        assertEquals(0, tool.getProfiles().length);
+        tool.dispose();
+        assertEquals(0, tool.getProfiles().length);
+    }
+
+    private static long countCalls(RootNodeProfiler profiler) {
+        long calls = 0;
+        for (RootNodeProfile profile : profiler.getProfiles()) {
+            long histogramCalls = 0;
+            for (long bucketCount : profile.histogram()) {
+                histogramCalls += bucketCount;
+            }
+            assertEquals(profile.callCount(), histogramCalls);
+            assertTrue(profile.exclusiveNanos() >= 0);
+            assertTrue(profile.inclusiveNanos() >= profile.exclusiveNanos());
+            calls += profile.callCount();
+        }
+        return calls;
+    }
+
+    @Test
+    public void testProfiling() throws NoSuchFieldException, SecurityException, IllegalArgumentException, IllegalAccessException, IOException {
+        final PolyglotEngine vm = PolyglotEngine.newBuilder().build();
+        final Field field = PolyglotEngine.class.getDeclaredField("instrumenter");
+        field.setAccessible(true);
+        final Instrumenter instrumenter = (Instrumenter) field.get(vm);
+        instrumenter.registerASTProber(new ToolTestUtil.TestASTProber());
+        final Source source = ToolTestUtil.createTestSource("testProfiling");
+
+        final RootNodeProfiler addProfiler = new RootNodeProfiler(ToolTestTag.ADD_TAG);
+        final RootNodeProfiler valueProfiler = new RootNodeProfiler(ToolTestTag.VALUE_TAG);
+        instrumenter.install(addProfiler);
+        instrumenter.install(valueProfiler);
+
+        for (int i = 0; i < 3; i++) {
+            assertEquals(13, vm.eval(source).get());
+        }
+        assertEquals(3, countCalls(addProfiler));
+        assertEquals(6, countCalls(valueProfiler));
+        assertTrue(addProfiler.toJSON().contains("\"calls\": "));
+        assertTrue(addProfiler.toJSON().contains("\"loopCount\": 0"));
+
+        addProfiler.setEnabled(false);
+        assertEquals(13, vm.eval(source).get());
+        assertEquals(3, countCalls(addProfiler));
+        assertEquals(8, countCalls(valueProfiler));
+
+        addProfiler.reset();
+        assertEquals(0, addProfiler.getProfiles().length);
+
+        addProfiler.dispose();
+        valueProfiler.dispose();
+    }
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.tools;
+
+import java.io.BufferedInputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.EOFException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.io.Writer;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeMap;
+
+import com.oracle.truffle.api.source.Source;
+
+/**
+ * Per-line execution counts produced by a {@link CoverageTracker}, stored as one primitive array
+ * per source. Sources are identified by {@linkplain #getSourceName(Source) name} rather than by
+ * {@link Source} object, so that snapshots taken in different engines or processes can be
+ * {@linkplain #merge(CoverageSnapshot) merged}.
+ * <p>
+ * Snapshots can be written to a compact binary stream, which supports appending one snapshot after
+ * the other, e.g. periodic {@linkplain CoverageTracker#snapshotDelta() delta snapshots} of a long
+ * running process, and {@linkplain #readAll(InputStream) reading them back} as one merged snapshot.
+ * They can also be written in the LCOV tracefile format.
+ */
+public final class CoverageSnapshot {
+
+    /** Count of a line for which no counter was installed. */
+    public static final long NOT_COUNTED = -1;
+
+    private static final int MAGIC = 0x54434f56; // "TCOV"
+    private static final int VERSION = 1;
+
+    private final Map<String, long[]> counts;
+
+    CoverageSnapshot(Map<String, long[]> counts) {
+        this.counts = counts;
+    }
+
+    /**
+     * Creates an empty snapshot.
+     */
+    public CoverageSnapshot() {
+        this(new TreeMap<String, long[]>());
+    }
+
+    /**
+     * Gets the name used to identify a source in snapshots: its path if available, otherwise its
+     * name.
+     */
+    public static String getSourceName(Source source) {
+        final String path = source.getPath();
+        return path != null ? path : source.getName();
+    }
+
+    /**
+     * Gets the names of all sources with counts, in sorted order.
+     */
+    public Set<String> getSourceNames() {
+        return Collections.unmodifiableSet(counts.keySet());
+    }
+
+    /**
+     * Gets the counts of a source, or {@code null} if the snapshot has no counts for it. Array
+     * index {@code i} holds the count of line {@code i + 1}, or {@link #NOT_COUNTED}. The array is
+     * shared with the snapshot and must not be modified.
+     */
+    public long[] getCounts(String sourceName) {
+        return counts.get(sourceName);
+    }
+
+    /**
+     * Returns a new snapshot holding the sum of the counts of this snapshot and another one.
+     */
+    public CoverageSnapshot merge(CoverageSnapshot other) {
+        final Map<String, long[]> result = new TreeMap<>();
+        for (Map.Entry<String, long[]> entry : counts.entrySet()) {
+            result.put(entry.getKey(), entry.getValue().clone());
+        }
+        for (Map.Entry<String, long[]> entry : other.counts.entrySet()) {
+            result.put(entry.getKey(), add(result.get(entry.getKey()), entry.getValue()));
+        }
+        return new CoverageSnapshot(result);
+    }
+
+    private static long[] add(long[] sum, long[] lines) {
+        if (sum == null) {
+            return lines.clone();
+        }
+        final long[] result = sum.length >= lines.length ? sum : Arrays.copyOf(sum, lines.length);
+        if (result.length > sum.length) {
+            Arrays.fill(result, sum.length, result.length, NOT_COUNTED);
+        }
+        for (int i = 0; i < lines.length; i++) {
+            if (lines[i] != NOT_COUNTED) {
+                result[i] = result[i] == NOT_COUNTED ? lines[i] : result[i] + lines[i];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Writes this snapshot in binary form. Only counted lines are written. Several snapshots may be
+     * written to the same stream one after the other.
+     */
+    public void writeTo(OutputStream out) throws IOException {
+        final DataOutputStream data = new DataOutputStream(out);
+        data.writeInt(MAGIC);
+        data.writeInt(VERSION);
+        data.writeInt(counts.size());
+        for (Map.Entry<String, long[]> entry : counts.entrySet()) {
+            final long[] lines = entry.getValue();
+            int counted = 0;
+            for (long count : lines) {
+                if (count != NOT_COUNTED) {
+                    counted++;
+                }
+            }
+            data.writeUTF(entry.getKey());
+            data.writeInt(lines.length);
+            data.writeInt(counted);
+            for (int i = 0; i < lines.length; i++) {
+                if (lines[i] != NOT_COUNTED) {
+                    data.writeInt(i);
+                    data.writeLong(lines[i]);
+                }
+            }
+        }
+        data.flush();
+    }
+
+    /**
+     * Reads one snapshot written by {@link #writeTo(OutputStream)}.
+     *
+     * @throws EOFException if the stream has no more snapshots
+     * @throws IOException if the stream does not hold a snapshot
+     */
+    public static CoverageSnapshot readFrom(InputStream in) throws IOException {
+        final DataInputStream data = new DataInputStream(in);
+        if (data.readInt() != MAGIC) {
+            throw new IOException("Not a coverage snapshot");
+        }
+        final int version = data.readInt();
+        if (version != VERSION) {
+            throw new IOException("Unsupported coverage snapshot version " + version);
+        }
+        final Map<String, long[]> result = new TreeMap<>();
+        final int sourceCount = data.readInt();
+        for (int s = 0; s < sourceCount; s++) {
+            final String name = data.readUTF();
+            final long[] lines = new long[data.readInt()];
+            Arrays.fill(lines, NOT_COUNTED);
+            final int counted = data.readInt();
+            for (int i = 0; i < counted; i++) {
+                final int line = data.readInt();
+                lines[line] = data.readLong();
+            }
+            result.put(name, lines);
+        }
+        return new CoverageSnapshot(result);
+    }
+
+    /**
+     * Reads all snapshots written to a stream and merges them into one.
+     */
+    public static CoverageSnapshot readAll(InputStream in) throws IOException {
+        CoverageSnapshot result = new CoverageSnapshot();
+        final BufferedInputStream buffered = new BufferedInputStream(in);
+        while (true) {
+            buffered.mark(1);
+            if (buffered.read() < 0) {
+                return result;
+            }
+            buffered.reset();
+            result = result.merge(readFrom(buffered));
+        }
+    }
+
+    /**
+     * Writes this snapshot in the LCOV tracefile format, one record per source.
+     */
+    public void writeLcov(Writer out) throws IOException {
+        for (Map.Entry<String, long[]> entry : counts.entrySet()) {
+            final long[] lines = entry.getValue();
+            int found = 0;
+            int hit = 0;
+            out.write("SF:" + entry.getKey() + "\n");
+            for (int i = 0; i < lines.length; i++) {
+                if (lines[i] != NOT_COUNTED) {
+                    found++;
+                    if (lines[i] > 0) {
+                        hit++;
+                    }
+                    out.write("DA:" + (i + 1) + "," + lines[i] + "\n");
+                }
+            }
+            out.write("LF:" + found + "\n");
+            out.write("LH:" + hit + "\n");
+            out.write("end_of_record\n");
+        }
+        out.flush();
+    }
+}
@@ -26,12 +26,13 @@ package com.oracle.truffle.tools;
 
 import java.io.PrintStream;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
 import java.util.Comparator;
 import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
-import java.util.Map.Entry;
-import java.util.TreeSet;
+import java.util.TreeMap;
 
 import com.oracle.truffle.api.instrument.Instrumenter;
 import com.oracle.truffle.api.instrument.Probe;
@@ -46,6 +47,7 @@ import com.oracle.truffle.api.nodes.Node;
 import com.oracle.truffle.api.source.LineLocation;
 import com.oracle.truffle.api.source.Source;
 import com.oracle.truffle.api.source.SourceSection;
+import com.oracle.truffle.api.source.SourceSectionIndex;
 
 /**
  * An {@linkplain Instrumenter.Tool Instrumentation Tool} that counts interpreter
@@ -85,8 +87,8 @@ import com.oracle.truffle.api.source.SourceSection;
  */
 public final class CoverageTracker extends Instrumenter.Tool {
 
-    /** Counting data. */
-    private final Map<LineLocation, CoverageRecord> coverageMap = new HashMap<>();
+    /** Counting data, at most one record for each line. */
+    private final SourceSectionIndex<CoverageRecord> coverageIndex = new SourceSectionIndex<>();
 
     /** Needed for disposal. */
     private final List<ProbeInstrument> instruments = new ArrayList<>();
@@ -127,7 +129,12 @@ public final class CoverageTracker extends Instrumenter.Tool {
 
     @Override
     protected void internalReset() {
-        coverageMap.clear();
+        for (Source source : coverageIndex.getSources()) {
+            for (CoverageRecord record : coverageIndex.findAll(source)) {
+                record.count = 0;
+                record.reported = 0;
+            }
+        }
     }
 
     @Override
@@ -149,39 +156,55 @@ public final class CoverageTracker extends Instrumenter.Tool {
      * <p>
      * <b>Note:</b> source line numbers are 1-based, so array index {@code i} corresponds to source
      * line number {@code i + 1}
+     *
+     * @see #snapshot()
      */
     public Map<Source, Long[]> getCounts() {
+        final Map<Source, Long[]> result = new HashMap<>();
+        for (Source source : coverageIndex.getSources()) {
+            final Long[] lineTable = new Long[source.getLineCount()];
+            for (CoverageRecord record : coverageIndex.findAll(source)) {
+                lineTable[record.srcSection.getStartLine() - 1] = record.count;
+            }
+            result.put(source, lineTable);
+        }
+        return result;
+    }
 
-        /**
-         * Counters for every {Source, line number} for which a counter was installed, i.e. for
-         * every line associated with an appropriately tagged AST node; iterable in order of source
-         * name, then line number.
-         */
-        final TreeSet<Entry<LineLocation, CoverageRecord>> entries = new TreeSet<>(new LineLocationEntryComparator());
+    /**
+     * Gets a snapshot of the current per-line execution counts since the tool was installed or
+     * last {@linkplain #reset() reset}; does not affect the counts. Unlike {@link #getCounts()}
+     * the snapshot holds primitive counts and can be merged, written and read back.
+     */
+    public CoverageSnapshot snapshot() {
+        return createSnapshot(false);
+    }
 
-        for (Entry<LineLocation, CoverageRecord> entry : coverageMap.entrySet()) {
-            entries.add(entry);
-        }
-        final Map<Source, Long[]> result = new HashMap<>();
-        Source curSource = null;
-        Long[] curLineTable = null;
-        for (Entry<LineLocation, CoverageRecord> entry : entries) {
-            final LineLocation key = entry.getKey();
-            final Source source = key.getSource();
-            final int lineNo = key.getLineNumber();
-            if (source != curSource) {
-                if (curSource != null) {
-                    result.put(curSource, curLineTable);
+    /**
+     * Gets a snapshot of the per-line execution counts since the previous delta snapshot, or since
+     * the tool was installed or last {@linkplain #reset() reset}. Merging all delta snapshots
+     * yields the same counts as {@link #snapshot()}, so they can be written to a stream
+     * continuously and aggregated offline.
+     */
+    public CoverageSnapshot snapshotDelta() {
+        return createSnapshot(true);
+    }
+
+    private CoverageSnapshot createSnapshot(boolean delta) {
+        final Map<String, long[]> counts = new TreeMap<>();
+        for (Source source : coverageIndex.getSources()) {
+            final long[] lines = new long[source.getLineCount()];
+            Arrays.fill(lines, CoverageSnapshot.NOT_COUNTED);
+            for (CoverageRecord record : coverageIndex.findAll(source)) {
+                final long count = record.count;
+                lines[record.srcSection.getStartLine() - 1] = delta ? count - record.reported : count;
+                if (delta) {
+                    record.reported = count;
                 }
-                curSource = source;
-                curLineTable = new Long[source.getLineCount()];
             }
-            curLineTable[lineNo - 1] = entry.getValue().count;
+            counts.put(CoverageSnapshot.getSourceName(source), lines);
         }
-        if (curSource != null) {
-            result.put(curSource, curLineTable);
-        }
-        return result;
+        return new CoverageSnapshot(counts);
     }
 
     /**
@@ -192,41 +215,21 @@ public final class CoverageTracker extends Instrumenter.Tool {
         out.println();
         out.println(countingTag.name() + " coverage:");
 
-        /**
-         * Counters for every {Source, line number} for which a counter was installed, i.e. for
-         * every line associated with an appropriately tagged AST node; iterable in order of source
-         * name, then line number.
-         */
-        final TreeSet<Entry<LineLocation, CoverageRecord>> entries = new TreeSet<>(new LineLocationEntryComparator());
-
-        for (Entry<LineLocation, CoverageRecord> entry : coverageMap.entrySet()) {
-            entries.add(entry);
-        }
-        Source curSource = null;
-        int curLineNo = 1;
-        for (Entry<LineLocation, CoverageRecord> entry : entries) {
-            final LineLocation key = entry.getKey();
-            final Source source = key.getSource();
-            final int lineNo = key.getLineNumber();
-            if (source != curSource) {
-                if (curSource != null) {
-                    while (curLineNo <= curSource.getLineCount()) {
-                        displayLine(out, null, curSource, curLineNo++);
-                    }
+        final List<Source> sources = new ArrayList<>(coverageIndex.getSources());
+        Collections.sort(sources, SOURCE_COMPARATOR);
+        for (Source source : sources) {
+            out.println();
+            out.println(source.getPath());
+            int curLineNo = 1;
+            for (CoverageRecord record : coverageIndex.findAll(source)) {
+                final int lineNo = record.srcSection.getStartLine();
+                while (curLineNo < lineNo) {
+                    displayLine(out, null, source, curLineNo++);
                 }
-                curSource = source;
-                curLineNo = 1;
-                out.println();
-                out.println(source.getPath());
-            }
-            while (curLineNo < lineNo) {
-                displayLine(out, null, curSource, curLineNo++);
+                displayLine(out, record, source, curLineNo++);
             }
-            displayLine(out, entry.getValue(), curSource, curLineNo++);
-        }
-        if (curSource != null) {
-            while (curLineNo <= curSource.getLineCount()) {
-                displayLine(out, null, curSource, curLineNo++);
+            while (curLineNo <= source.getLineCount()) {
+                displayLine(out, null, source, curLineNo++);
             }
         }
     }
@@ -250,6 +253,7 @@ public final class CoverageTracker extends Instrumenter.Tool {
         private final SourceSection srcSection; // The text of the code being counted
         private ProbeInstrument instrument;  // The attached Instrument, in case need to remove.
         private long count = 0;
+        private long reported = 0; // The count at the last delta snapshot.
 
         CoverageRecord(SourceSection srcSection) {
             this.srcSection = srcSection;
@@ -264,12 +268,19 @@ public final class CoverageTracker extends Instrumenter.Tool {
 
     }
 
-    private static final class LineLocationEntryComparator implements Comparator<Entry<LineLocation, CoverageRecord>> {
+    /**
+     * Orders sources as {@link LineLocation#compareTo(LineLocation)} does: by path if known,
+     * otherwise by text.
+     */
+    private static final Comparator<Source> SOURCE_COMPARATOR = new Comparator<Source>() {
 
-        public int compare(Entry<LineLocation, CoverageRecord> e1, Entry<LineLocation, CoverageRecord> e2) {
-            return e1.getKey().compareTo(e2.getKey());
+        public int compare(Source s1, Source s2) {
+            if (s1.getPath() == null || s2.getPath() == null) {
+                return s1.getCode().compareTo(s2.getCode());
+            }
+            return s1.getPath().compareTo(s2.getPath());
         }
-    }
+    };
 
     /**
      * Attach a counting instrument to each node that is assigned a specified tag.
@@ -290,10 +301,14 @@ public final class CoverageTracker extends Instrumenter.Tool {
             // TODO (mlvdv) report this?
             return;
         }
+        if (srcSection.getSource() == null) {
+            return;
+        }
         // Get the source line where the
         final LineLocation lineLocation = srcSection.getLineLocation();
-        CoverageRecord record = coverageMap.get(lineLocation);
-        if (record != null) {
+        final List<CoverageRecord> records = coverageIndex.findStartingOn(lineLocation);
+        if (!records.isEmpty()) {
+            final CoverageRecord record = records.get(0);
             // Another node starts on same line; count only the first (textually)
             if (srcSection.getCharIndex() > record.srcSection.getCharIndex()) {
                 // Existing record, corresponds to code earlier on line
@@ -301,6 +316,7 @@ public final class CoverageTracker extends Instrumenter.Tool {
             } else {
                 // Existing record, corresponds to code at a later position; replace it
                 record.instrument.dispose();
+                coverageIndex.remove(record.srcSection, record);
             }
         }
 
@@ -308,6 +324,6 @@ public final class CoverageTracker extends Instrumenter.Tool {
         final ProbeInstrument instrument = getInstrumenter().attach(probe, coverageRecord, CoverageTracker.class.getSimpleName());
         coverageRecord.instrument = instrument;
         instruments.add(instrument);
-        coverageMap.put(lineLocation, coverageRecord);
+        coverageIndex.add(srcSection, coverageRecord);
     }
 }
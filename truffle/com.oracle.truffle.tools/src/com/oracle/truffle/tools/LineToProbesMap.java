@@ -24,67 +24,42 @@
  */
 package com.oracle.truffle.tools;
 
-import java.io.PrintStream;
-import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
-import java.util.HashMap;
-import java.util.Map;
 
 import com.oracle.truffle.api.instrument.Instrumenter;
 import com.oracle.truffle.api.instrument.Probe;
-import com.oracle.truffle.api.instrument.ProbeListener;
-import com.oracle.truffle.api.instrument.impl.DefaultProbeListener;
 import com.oracle.truffle.api.source.LineLocation;
 import com.oracle.truffle.api.source.Source;
-import com.oracle.truffle.api.source.SourceSection;
 
 /**
- * An {@linkplain Instrumenter.Tool Instrumentation Tool} that builds a map of every {@link Probe}
- * attached to some AST, indexed by {@link Source} and line number.
+ * An {@linkplain Instrumenter.Tool Instrumentation Tool} that finds every {@link Probe} attached to
+ * some AST, indexed by {@link Source} and line number. The tool keeps no data of its own: once
+ * installed it answers queries from the index of Probes shared by all clients of the
+ * {@link Instrumenter}.
+ *
+ * @see Instrumenter#findProbesStartingOn(LineLocation)
  */
 public final class LineToProbesMap extends Instrumenter.Tool {
 
-    private static final boolean TRACE = false;
-    private static final PrintStream OUT = System.out;
-
-    private static void trace(String msg) {
-        OUT.println("LineToProbesMap: " + msg);
-    }
-
     /**
-     * Map: Source line ==> probes associated with source sections starting on the line.
-     */
-    private final Map<LineLocation, Collection<Probe>> lineToProbesMap = new HashMap<>();
-
-    private final ProbeListener probeListener;
-
-    /**
-     * Create a map of {@link Probe}s that collects information on all probes added to subsequently
-     * created ASTs (once installed).
+     * Create a map of {@link Probe}s that finds all probes of the {@link Instrumenter} it is
+     * installed in.
      */
     public LineToProbesMap() {
-        this.probeListener = new LineToProbesListener();
     }
 
     @Override
     protected boolean internalInstall() {
-        final Instrumenter instrumenter = getInstrumenter();
-        for (Probe probe : instrumenter.findProbesTaggedAs(null)) {
-            addMapEntry(probe);
-        }
-        instrumenter.addProbeListener(probeListener);
         return true;
     }
 
     @Override
     protected void internalReset() {
-        lineToProbesMap.clear();
     }
 
     @Override
     protected void internalDispose() {
-        getInstrumenter().removeProbeListener(probeListener);
     }
 
     /**
@@ -92,16 +67,8 @@ public final class LineToProbesMap extends Instrumenter.Tool {
      * more than one, return the one with the first starting character location.
      */
     public Probe findFirstProbe(LineLocation lineLocation) {
-        Probe probe = null;
         final Collection<Probe> probes = findProbes(lineLocation);
-        for (Probe probesOnLine : probes) {
-            if (probe == null) {
-                probe = probesOnLine;
-            } else if (probesOnLine.getProbedSourceSection().getCharIndex() < probe.getProbedSourceSection().getCharIndex()) {
-                probe = probesOnLine;
-            }
-        }
-        return probe;
+        return probes.isEmpty() ? null : probes.iterator().next();
     }
 
     /**
@@ -109,36 +76,9 @@ public final class LineToProbesMap extends Instrumenter.Tool {
      * an empty list if none.
      */
     public Collection<Probe> findProbes(LineLocation line) {
-        final Collection<Probe> probes = lineToProbesMap.get(line);
-        if (probes == null) {
+        if (getInstrumenter() == null) {
             return Collections.emptyList();
         }
-        return Collections.unmodifiableCollection(probes);
-    }
-
-    private class LineToProbesListener extends DefaultProbeListener {
-
-        @Override
-        public void newProbeInserted(Probe probe) {
-            addMapEntry(probe);
-        }
-    }
-
-    private void addMapEntry(Probe probe) {
-        final SourceSection sourceSection = probe.getProbedSourceSection();
-        if (sourceSection != null && sourceSection.getSource() != null) {
-            final LineLocation lineLocation = sourceSection.getLineLocation();
-            if (TRACE) {
-                trace("ADD " + lineLocation.getShortDescription() + " ==> " + probe.getShortDescription());
-            }
-            Collection<Probe> probes = lineToProbesMap.get(lineLocation);
-            if (probes == null) {
-                probes = new ArrayList<>(2);
-                lineToProbesMap.put(lineLocation, probes);
-            } else {
-                assert !probes.contains(probe);
-            }
-            probes.add(probe);
-        }
+        return Collections.unmodifiableCollection(getInstrumenter().findProbesStartingOn(line));
     }
 }
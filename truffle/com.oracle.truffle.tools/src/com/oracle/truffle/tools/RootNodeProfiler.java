@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.oracle.truffle.tools;
+
+import java.io.PrintStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+
+import com.oracle.truffle.api.CallTarget;
+import com.oracle.truffle.api.CompilerDirectives.TruffleBoundary;
+import com.oracle.truffle.api.LoopCounts;
+import com.oracle.truffle.api.Truffle;
+import com.oracle.truffle.api.frame.VirtualFrame;
+import com.oracle.truffle.api.instrument.Instrumenter;
+import com.oracle.truffle.api.instrument.Probe;
+import com.oracle.truffle.api.instrument.ProbeInstrument;
+import com.oracle.truffle.api.instrument.ProbeListener;
+import com.oracle.truffle.api.instrument.StandardInstrumentListener;
+import com.oracle.truffle.api.instrument.StandardSyntaxTag;
+import com.oracle.truffle.api.instrument.SyntaxTag;
+import com.oracle.truffle.api.instrument.impl.DefaultProbeListener;
+import com.oracle.truffle.api.nodes.Node;
+import com.oracle.truffle.api.nodes.RootNode;
+import com.oracle.truffle.api.source.SourceSection;
+import com.oracle.truffle.api.utilities.JSONHelper;
+import com.oracle.truffle.api.utilities.JSONHelper.JSONArrayBuilder;
+import com.oracle.truffle.api.utilities.JSONHelper.JSONObjectBuilder;
+
+/**
+ * An {@linkplain Instrumenter.Tool Instrumentation Tool} that measures interpreter
+ * <em>activations</em> of AST nodes holding a specified {@linkplain SyntaxTag syntax tag},
+ * tabulated by the {@link RootNode} that contains each node. Syntax tags are presumed to be applied
+ * external to the tool. If no tag is specified, {@linkplain StandardSyntaxTag#START_METHOD
+ * START_METHOD} is used, so that each activation corresponds to one call of a guest language
+ * method.
+ * <p>
+ * <b>Tool Life Cycle</b>
+ * <p>
+ * See {@linkplain Instrumenter.Tool Instrumentation Tool} for the life cycle common to all such
+ * tools.
+ * </p>
+ * <b>Measurements</b>
+ * <p>
+ * <ul>
+ * <li>An "activation" begins with the event
+ * {@link StandardInstrumentListener#onEnter(Probe, Node, VirtualFrame)} and ends with the matching
+ * normal or exceptional return event;</li>
+ * <li><em>Inclusive</em> time is the wall clock time of an activation, counted only for the
+ * outermost of recursive activations of the same root;</li>
+ * <li><em>Exclusive</em> time is inclusive time less the time spent in nested activations measured
+ * on the same thread;</li>
+ * <li>The loop count is the number of iterations that loops in the root reported to its call target
+ * while the tool was installed, if the runtime counts them;</li>
+ * <li>The latency histogram counts activations by duration in buckets of powers of two
+ * nanoseconds: bucket {@code i} holds activations lasting from {@code 2^i} up to
+ * {@code 2^(i+1)} nanoseconds.</li>
+ * </ul>
+ * </p>
+ * <b>Results</b>
+ * <p>
+ * A modification-safe copy of the {@linkplain #getProfiles() profiles} can be retrieved at any
+ * time, without effect on the state of the tool. A "default" {@linkplain #print(PrintStream, int,
+ * boolean) print()} method summarizes the roots with the highest inclusive time in a simple textual
+ * format, and {@link #toJSON()} produces a machine-readable dump of all profiles.
+ * </p>
+ *
+ * @see ProbeInstrument
+ * @see SyntaxTag
+ */
+public final class RootNodeProfiler extends Instrumenter.Tool {
+
+    /** Number of latency histogram buckets, enough for any {@code long} duration. */
+    public static final int HISTOGRAM_BUCKETS = 64;
+
+    /**
+     * Timing measurements for activations of nodes in a particular {@link RootNode}.
+     */
+    public interface RootNodeProfile {
+        RootNode rootNode();
+
+        /** A description of the root node, by default its {@link RootNode#toString()}. */
+        String name();
+
+        long callCount();
+
+        long inclusiveNanos();
+
+        long exclusiveNanos();
+
+        /**
+         * Loop iterations reported by loops in the root since profiling began, or zero if the
+         * runtime does not count them.
+         */
+        long loopCount();
+
+        /**
+         * Activation counts indexed by the base two logarithm of their duration in nanoseconds;
+         * length {@link RootNodeProfiler#HISTOGRAM_BUCKETS}.
+         */
+        long[] histogram();
+    }
+
+    /**
+     * Listener for events at instrumented nodes. Measurements are maintained in a shared table, so
+     * the listener is stateless and can be shared by every {@link ProbeInstrument}.
+     */
+    private final StandardInstrumentListener instrumentListener = new StandardInstrumentListener() {
+
+        public void onEnter(Probe probe, Node node, VirtualFrame vFrame) {
+            if (isEnabled()) {
+                enter(node.getRootNode());
+            }
+        }
+
+        public void onReturnVoid(Probe probe, Node node, VirtualFrame vFrame) {
+            exit(node.getRootNode());
+        }
+
+        public void onReturnValue(Probe probe, Node node, VirtualFrame vFrame, Object result) {
+            exit(node.getRootNode());
+        }
+
+        public void onReturnExceptional(Probe probe, Node node, VirtualFrame vFrame, Throwable exception) {
+            exit(node.getRootNode());
+        }
+    };
+
+    /** Profiling data; instrument callbacks add records from any thread. */
+    private final ConcurrentMap<RootNode, ProfileRecord> profiles = new ConcurrentHashMap<>();
+
+    /** Activations in progress on each thread, innermost last. */
+    private final ThreadLocal<List<Activation>> activations = new ThreadLocal<List<Activation>>() {
+        @Override
+        protected List<Activation> initialValue() {
+            return new ArrayList<>();
+        }
+    };
+
+    /** For disposal. */
+    private final List<ProbeInstrument> instruments = new ArrayList<>();
+
+    /**
+     * Profiling is restricted to nodes holding this tag.
+     */
+    private final SyntaxTag profilingTag;
+
+    private final ProbeListener probeListener;
+
+    /**
+     * Creates a per-root profiling tool for nodes tagged as
+     * {@linkplain StandardSyntaxTag#START_METHOD method bodies} in subsequently created ASTs.
+     */
+    public RootNodeProfiler() {
+        this(StandardSyntaxTag.START_METHOD);
+    }
+
+    /**
+     * Creates a per-root profiling tool for nodes tagged as specified, presuming that tags are
+     * applied outside this tool.
+     */
+    public RootNodeProfiler(SyntaxTag tag) {
+        this.profilingTag = tag;
+        this.probeListener = new ProfilerProbeListener();
+    }
+
+    @Override
+    protected boolean internalInstall() {
+        final Instrumenter instrumenter = getInstrumenter();
+        for (Probe probe : instrumenter.findProbesTaggedAs(profilingTag)) {
+            addProfiler(probe);
+        }
+        instrumenter.addProbeListener(probeListener);
+        return true;
+    }
+
+    @Override
+    protected void internalReset() {
+        profiles.clear();
+    }
+
+    @Override
+    protected void internalDispose() {
+        getInstrumenter().removeProbeListener(probeListener);
+        for (ProbeInstrument instrument : instruments) {
+            instrument.dispose();
+        }
+    }
+
+    /**
+     * Gets a modification-safe summary of the current per-root measurements; does not affect the
+     * measurements.
+     */
+    public RootNodeProfile[] getProfiles() {
+        final List<RootNodeProfile> result = new ArrayList<>();
+        for (ProfileRecord record : profiles.values()) {
+            result.add(new RootNodeProfileImpl(record));
+        }
+        return result.toArray(new RootNodeProfile[result.size()]);
+    }
+
+    /**
+     * A default printer for the current measurements, producing lines of the form
+     * " <calls> <inclusive ms> <exclusive ms> <mean us> <loops> : <root>" for every root in
+     * descending order of inclusive time.
+     */
+    public void print(PrintStream out) {
+        print(out, Integer.MAX_VALUE, false);
+    }
+
+    /**
+     * A default printer for the current measurements, producing lines of the form
+     * " <calls> <inclusive ms> <exclusive ms> <mean us> <loops> : <root>" in descending order of
+     * inclusive time.
+     *
+     * @param out
+     * @param topN the maximum number of roots to describe
+     * @param verbose whether to print the latency histogram of each root described
+     */
+    public void print(PrintStream out, int topN, boolean verbose) {
+        out.println();
+        out.println("\"" + profilingTag.name() + "\"-tagged activation times by root:");
+        out.println("(dynamically added nodes not instrumented)");
+        out.format("%12s %12s %12s %12s %12s   %s%n", "calls", "incl ms", "excl ms", "mean us", "loops", "root");
+        final RootNodeProfile[] sorted = getProfiles();
+        Arrays.sort(sorted, new Comparator<RootNodeProfile>() {
+
+            public int compare(RootNodeProfile o1, RootNodeProfile o2) {
+                return Long.compare(o2.inclusiveNanos(), o1.inclusiveNanos());
+            }
+        });
+        final int count = Math.min(topN, sorted.length);
+        for (int i = 0; i < count; i++) {
+            final RootNodeProfile profile = sorted[i];
+            final long calls = profile.callCount();
+            out.format("%12d %12.3f %12.3f %12.3f %12d : %s%n", calls, profile.inclusiveNanos() / 1e6, profile.exclusiveNanos() / 1e6,
+                            calls == 0 ? 0.0 : profile.inclusiveNanos() / 1e3 / calls, profile.loopCount(), profile.name());
+            if (verbose) {
+                final long[] histogram = profile.histogram();
+                for (int bucket = 0; bucket < histogram.length; bucket++) {
+                    if (histogram[bucket] > 0) {
+                        out.format("%51s >= %12dns : %d%n", "", 1L << bucket, histogram[bucket]);
+                    }
+                }
+            }
+        }
+        if (count < sorted.length) {
+            out.println("(" + (sorted.length - count) + " more roots not shown)");
+        }
+    }
+
+    /**
+     * Produces a JSON array with an object describing each root: its name, source location, call
+     * count, inclusive and exclusive nanoseconds, loop count, and latency histogram.
+     */
+    public String toJSON() {
+        final JSONArrayBuilder result = JSONHelper.array();
+        for (RootNodeProfile profile : getProfiles()) {
+            final JSONObjectBuilder json = JSONHelper.object();
+            json.add("name", profile.name());
+            final SourceSection sourceSection = profile.rootNode().getSourceSection();
+            json.add("source", sourceSection == null ? null : sourceSection.getShortDescription());
+            json.add("calls", profile.callCount());
+            json.add("inclusiveNanos", profile.inclusiveNanos());
+            json.add("exclusiveNanos", profile.exclusiveNanos());
+            json.add("loopCount", profile.loopCount());
+            final JSONArrayBuilder histogram = JSONHelper.array();
+            for (long bucketCount : profile.histogram()) {
+                histogram.add(bucketCount);
+            }
+            json.add("histogram", histogram);
+            result.add(json);
+        }
+        return result.toString();
+    }
+
+    /**
+     * Mark this method as a boundary that will stop Truffle inlining, which should not be allowed
+     * to inline the hash table, the clock, or any other complex library code.
+     */
+    @TruffleBoundary
+    private void enter(RootNode rootNode) {
+        ProfileRecord record = profiles.get(rootNode);
+        if (record == null) {
+            final ProfileRecord newRecord = new ProfileRecord(rootNode);
+            record = profiles.putIfAbsent(rootNode, newRecord);
+            if (record == null) {
+                record = newRecord;
+            }
+        }
+        synchronized (record) {
+            record.active++;
+        }
+        activations.get().add(new Activation(record, System.nanoTime()));
+    }
+
+    @TruffleBoundary
+    private void exit(RootNode rootNode) {
+        final long now = System.nanoTime();
+        final List<Activation> stack = activations.get();
+        // Find the matching activation; there is none if the tool was disabled or reset on entry.
+        int index = stack.size() - 1;
+        while (index >= 0 && stack.get(index).record.rootNode != rootNode) {
+            index--;
+        }
+        if (index < 0) {
+            return;
+        }
+        final Activation activation = stack.get(index);
+        // Discard activations that never reported a return.
+        while (stack.size() > index) {
+            final ProfileRecord discarded = stack.remove(stack.size() - 1).record;
+            synchronized (discarded) {
+                discarded.active--;
+            }
+        }
+        final long elapsed = now - activation.startNanos;
+        final ProfileRecord record = activation.record;
+        synchronized (record) {
+            record.calls++;
+            if (record.active == 0) {
+                record.inclusiveNanos += elapsed;
+            }
+            record.exclusiveNanos += elapsed - activation.childNanos;
+            record.histogram[HISTOGRAM_BUCKETS - 1 - Long.numberOfLeadingZeros(Math.max(elapsed, 1))]++;
+        }
+        if (index > 0) {
+            stack.get(index - 1).childNanos += elapsed;
+        }
+    }
+
+    /**
+     * A listener that assumes ASTs have been tagged external to this tool, and which instruments
+     * nodes holding the profiling tag.
+     */
+    private class ProfilerProbeListener extends DefaultProbeListener {
+
+        @Override
+        public void probeTaggedAs(Probe probe, SyntaxTag tag, Object tagValue) {
+            if (profilingTag == tag) {
+                addProfiler(probe);
+            }
+        }
+    }
+
+    private void addProfiler(Probe probe) {
+        final ProbeInstrument instrument = getInstrumenter().attach(probe, instrumentListener, RootNodeProfiler.class.getSimpleName());
+        instruments.add(instrument);
+    }
+
+    private static long getLoopCount(RootNode rootNode) {
+        final CallTarget callTarget = rootNode.getCallTarget();
+        final LoopCounts loopCounts = Truffle.getRuntime().getCapability(LoopCounts.class);
+        return callTarget == null || loopCounts == null ? 0 : loopCounts.getLoopCount(callTarget);
+    }
+
+    /** Measurements of one root; the counters are guarded by the record. */
+    private static final class ProfileRecord {
+
+        private final RootNode rootNode;
+        private final long[] histogram = new long[HISTOGRAM_BUCKETS];
+        private long calls;
+        private long inclusiveNanos;
+        private long exclusiveNanos;
+        private int active; // Activations in progress, for recursion.
+        private final long loopCountBase; // Loop count of the call target when profiling began.
+
+        ProfileRecord(RootNode rootNode) {
+            this.rootNode = rootNode;
+            this.loopCountBase = getLoopCount(rootNode);
+        }
+    }
+
+    private static final class Activation {
+
+        private final ProfileRecord record;
+        private final long startNanos;
+        private long childNanos; // Time spent in nested activations.
+
+        Activation(ProfileRecord record, long startNanos) {
+            this.record = record;
+            this.startNanos = startNanos;
+        }
+    }
+
+    private static final class RootNodeProfileImpl implements RootNodeProfile {
+
+        private final RootNode rootNode;
+        private final long calls;
+        private final long inclusiveNanos;
+        private final long exclusiveNanos;
+        private final long loopCount;
+        private final long[] histogram;
+
+        RootNodeProfileImpl(ProfileRecord record) {
+            this.rootNode = record.rootNode;
+            synchronized (record) {
+                this.calls = record.calls;
+                this.inclusiveNanos = record.inclusiveNanos;
+                this.exclusiveNanos = record.exclusiveNanos;
+                this.histogram = record.histogram.clone();
+            }
+            this.loopCount = getLoopCount(record.rootNode) - record.loopCountBase;
+        }
+
+        public RootNode rootNode() {
+            return rootNode;
+        }
+
+        public String name() {
+            return rootNode.toString();
+        }
+
+        public long callCount() {
+            return calls;
+        }
+
+        public long inclusiveNanos() {
+            return inclusiveNanos;
+        }
+
+        public long exclusiveNanos() {
+            return exclusiveNanos;
+        }
+
+        public long loopCount() {
+            return loopCount;
+        }
+
+        public long[] histogram() {
+            return histogram.clone();
+        }
+    }
+}